@@ -0,0 +1,17 @@
+# Optional zstd support: links zstd to a target and defines GEN_HAS_ZSTD=1 for it, if zstd is found.
+# zstd's CMake package names its library target differently depending on how it was built.
+function(genesis_link_zstd target)
+    find_package(zstd CONFIG QUIET)
+    if(NOT zstd_FOUND)
+        return()
+    endif()
+
+    if(TARGET zstd::libzstd)
+        target_link_libraries(${target} PRIVATE zstd::libzstd)
+    elseif(TARGET zstd::libzstd_shared)
+        target_link_libraries(${target} PRIVATE zstd::libzstd_shared)
+    else()
+        target_link_libraries(${target} PRIVATE zstd::libzstd_static)
+    endif()
+    target_compile_definitions(${target} PRIVATE GEN_HAS_ZSTD=1)
+endfunction()
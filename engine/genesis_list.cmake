@@ -17,6 +17,7 @@ set(core_base_headers
 
 set(core_headers
         ${core_base_headers}
+        include/gen/core/frameArena.hpp
         include/gen/core/monoInstance.hpp
 )
 
@@ -34,9 +35,28 @@ set(inputs_headers
 		)
 		
 set(io_headers
+        include/gen/io/alignedBuffer.hpp
+        include/gen/io/blockStream.hpp
+        include/gen/io/derivedDataCache.hpp
         include/gen/io/fileAsync.hpp
         include/gen/io/file.hpp
         include/gen/io/fileHelper.hpp
+        include/gen/io/fileWatcher.hpp
+        include/gen/io/ioStats.hpp
+        include/gen/io/lz4.hpp
+        include/gen/io/mappedFile.hpp
+        include/gen/io/pakFile.hpp
+        include/gen/io/pakFormat.hpp
+        )
+
+set(jobs_headers
+        include/gen/jobs/asyncJob.hpp
+        include/gen/jobs/coroutineFrame.hpp
+        include/gen/jobs/executor.hpp
+        include/gen/jobs/jobSystem.hpp
+        include/gen/jobs/parallelFor.hpp
+        include/gen/jobs/task.hpp
+        include/gen/jobs/taskGraph.hpp
         )
 
 set(system_win32_headers
@@ -58,6 +78,7 @@ set(util_headers
         )
 
 set(logger_headers
+        include/gen/logger/binary.hpp
         include/gen/logger/context.hpp
         include/gen/logger/instance.hpp
         include/gen/logger/level.hpp
@@ -76,6 +97,7 @@ set(genesis_headers
 		${graphics_headers}
 		${inputs_headers}
         ${io_headers}
+        ${jobs_headers}
         ${system_headers}
         ${util_headers}
         ${logger_headers}
@@ -6,6 +6,8 @@
 
 #include "gen/util/version.hpp"
 
+#include "gen/jobs/executor.hpp"
+#include "gen/jobs/taskGraph.hpp"
 #include "gen/logger/log.hpp"
 #include "gen/windowing/window.hpp"
 
@@ -28,8 +30,14 @@ namespace gen
 
 		virtual void update(float dt);
 
+		// Resumes spawned Tasks at the start of every frame, destroyed after the engine so its job system finishes theirs first
+		Executor m_executor;
+
 		std::unique_ptr<Engine> m_engine;
 
+		// Stages run across cores every frame, between update() and draw(), ordered by the resources they declare
+		TaskGraph m_frameGraph;
+
 		Logger m_logger{"application"};
 	};
 
@@ -0,0 +1,152 @@
+// Copyright (c) 2023-present Genesis Engine contributors (see LICENSE.txt)
+
+/**
+ * @file frameArena.hpp
+ * @brief Defines the Frame Arena class, a bump allocator for memory that only lives a few frames.
+ */
+
+#pragma once
+
+#include "gen/core.hpp"
+#include "gen/core/monoInstance.hpp"
+
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <memory_resource>
+#include <mutex>
+#include <new>
+#include <span>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+namespace gen
+{
+
+	/**
+	 * @class FrameArena
+	 * @brief Bump allocator reset once per frame, buffered so memory survives while the GPU still uses its frame.
+	 *
+	 * Memory allocated during frame N stays valid until frame N + getBufferCount() begins, by default 3 to match
+	 * the swapchain's images in flight. Allocating is an atomic add (safe from jobs), freeing does nothing,
+	 * and nextFrame() releases a whole frame in O(1). A buffer that overflowed falls back to the heap for
+	 * the rest of its frame and is regrown to its peak at its next reset, so steady frames never touch the heap.
+	 *
+	 * Destructors never run: store trivially destructible data, or containers through getResource().
+	 */
+	class FrameArena : public MonoInstance<FrameArena>
+	{
+	public:
+		static constexpr u32 default_buffer_count_v{3};
+		static constexpr std::size_t default_capacity_v{std::size_t{4} << 20};
+
+		/**
+		 * @brief Constructor.
+		 * @param capacity Initial size of each buffer, in bytes.
+		 * @param bufferCount Frames an allocation survives, at least 1.
+		 */
+		explicit FrameArena(std::size_t capacity = default_capacity_v, u32 bufferCount = default_buffer_count_v);
+
+		/**
+		 * @brief Destructor.
+		 */
+		~FrameArena();
+
+		FrameArena(const FrameArena &)			   = delete;
+		FrameArena(FrameArena &&)				   = delete;
+		FrameArena & operator=(const FrameArena &) = delete;
+		FrameArena & operator=(FrameArena &&)	   = delete;
+
+		/**
+		 * @brief Allocates from the current frame's buffer, from any thread.
+		 * @param alignment Power of two.
+		 */
+		GEN_NODISCARD void * allocate(std::size_t const size, std::size_t const alignment = alignof(std::max_align_t))
+		{
+			auto & buffer	  = *m_buffers[m_current.load(std::memory_order_acquire)];
+			auto const padded = size + alignment - 1;
+			auto const offset = buffer.offset.fetch_add(padded, std::memory_order_relaxed);
+			if (offset + padded > buffer.capacity) { return allocateOverflow(buffer, size, alignment); }
+			auto const address = reinterpret_cast<std::uintptr_t>(buffer.memory.get() + offset);
+			return reinterpret_cast<void *>((address + alignment - 1) & ~(alignment - 1));
+		}
+
+		/**
+		 * @brief Allocates count uninitialized objects, for trivially destructible types.
+		 */
+		template <typename T>
+			requires std::is_trivially_destructible_v<T>
+		GEN_NODISCARD std::span<T> allocate(std::size_t const count)
+		{
+			return {static_cast<T *>(allocate(count * sizeof(T), alignof(T))), count};
+		}
+
+		/**
+		 * @brief Constructs an object, for trivially destructible types.
+		 */
+		template <typename T, typename... Args>
+			requires std::is_trivially_destructible_v<T>
+		GEN_NODISCARD T * create(Args &&... args)
+		{
+			return ::new (allocate(sizeof(T), alignof(T))) T(std::forward<Args>(args)...);
+		}
+
+		/**
+		 * @brief Moves to the next frame, releasing what was allocated getBufferCount() frames ago. Main thread only.
+		 *
+		 * Jobs may keep allocating meanwhile: they land in either the old or the new frame's buffer, both alive
+		 * for getBufferCount() - 1 more frames at least.
+		 */
+		void nextFrame();
+
+		/**
+		 * @brief Returns a memory resource allocating from the current frame, for std::pmr containers and strings.
+		 *
+		 * Containers must not outlive the frame's buffer, deallocation and growth leave the old memory until then.
+		 */
+		GEN_NODISCARD std::pmr::memory_resource & getResource() { return m_resource; }
+
+		/**
+		 * @brief Returns the bytes allocated in the current frame, padding and overflow included.
+		 */
+		GEN_NODISCARD std::size_t getUsed() const;
+
+		GEN_NODISCARD std::size_t getCapacity() const { return m_buffers[m_current.load(std::memory_order_acquire)]->capacity; }
+		GEN_NODISCARD u32 getBufferCount() const { return static_cast<u32>(m_buffers.size()); }
+
+	private:
+		struct Buffer
+		{
+			std::unique_ptr<std::byte[]> memory{};
+			std::size_t capacity{};
+			std::atomic<std::size_t> offset{}; //!< Bump pointer, past capacity once the buffer overflowed.
+			std::mutex mutex;				   //!< Guards overflow and overflowSize.
+			std::vector<std::pair<void *, std::align_val_t>> overflow{};
+			std::size_t overflowSize{};
+		};
+
+		class Resource : public std::pmr::memory_resource
+		{
+		public:
+			explicit Resource(FrameArena & arena) : m_arena(&arena) {}
+
+		private:
+			void * do_allocate(std::size_t const bytes, std::size_t const alignment) override { return m_arena->allocate(bytes, alignment); }
+			void do_deallocate(void *, std::size_t, std::size_t) override {}
+			bool do_is_equal(std::pmr::memory_resource const & other) const noexcept override { return this == &other; }
+
+			FrameArena * m_arena;
+		};
+
+		void * allocateOverflow(Buffer & buffer, std::size_t size, std::size_t alignment);
+		static void reset(Buffer & buffer);
+		static void freeOverflow(Buffer & buffer);
+
+		std::vector<std::unique_ptr<Buffer>> m_buffers; //!< One per frame in flight.
+		std::atomic<u32> m_current{};					//!< Buffer of the current frame, read by allocating threads.
+		Resource m_resource{*this};						//!< Adapter returned by getResource().
+	};
+
+} // namespace gen
@@ -2,12 +2,19 @@
 
 #pragma once
 
+#include "gen/core/frameArena.hpp"
 #include "gen/graphics/renderer.hpp"
+#include "gen/io/derivedDataCache.hpp"
+#include "gen/io/fileWatcher.hpp"
+#include "gen/jobs/jobSystem.hpp"
 #include "mim/vec2.hpp"
 
 #include "gen/core/monoInstance.hpp"
 
 #include <memory>
+#include <mutex>
+#include <span>
+#include <vector>
 
 namespace gen
 {
@@ -22,17 +29,48 @@ namespace gen
 		};
 
 		Engine(const char * appName, u32 appVersion, mim::vec2i const & initialSize);
-		~Engine() = default;
+		~Engine();
 
 		Engine(const Engine &)			   = delete;
 		Engine(Engine &&)				   = delete;
 		Engine & operator=(const Engine &) = delete;
 		Engine & operator=(Engine &&)	   = delete;
 
+		/**
+		 * @brief Returns the watcher for hot reloading, its callbacks run on the watcher thread.
+		 */
+		FileWatcher & getFileWatcher() { return m_fileWatcher; }
+
+		/**
+		 * @brief Returns the cache of derived data (compiled shaders, transcoded textures), invalid unless the build configured one.
+		 */
+		DerivedDataCache & getDerivedDataCache() { return m_derivedDataCache; }
+
+		/**
+		 * @brief Returns the allocator for transient data, reset every frame by Application::run().
+		 */
+		FrameArena & getFrameArena() { return m_frameArena; }
+
 	private:
+		void queueShaderChanges(std::span<FileWatcher::Change const> changes);
+		void recompileShaders(std::span<FileWatcher::Change const> changes);
+
+		// outlives the job system, jobs still draining may allocate from it
+		FrameArena m_frameArena;
+		// constructed before and destroyed after the rest of the engine, reachable through JobSystem::getInstance()
+		JobSystem m_jobSystem;
 		std::unique_ptr<Window> m_window;
 		std::unique_ptr<Renderer> m_renderer;
 
 		Logger m_logger{"engine"};
+		DerivedDataCache m_derivedDataCache;
+		// changes queued by the watcher thread, compiled by a single job at a time
+		std::mutex m_shaderMutex;
+		std::vector<FileWatcher::Change> m_shaderChanges;
+		bool m_compilingShaders = false;
+		JobSystem::Counter m_shaderJob;
+		FileWatcher::WatchId m_shaderWatch = FileWatcher::invalid_watch_v;
+		// destroyed first, its callbacks use the logger and the cache
+		FileWatcher m_fileWatcher;
 	};
 } // namespace gen
\ No newline at end of file
@@ -13,6 +13,7 @@
 #include <vulkan/vulkan.hpp>
 
 // std
+#include <coroutine>
 #include <vector>
 
 namespace gen
@@ -20,6 +21,16 @@ namespace gen
 	class CommandBuffer
 	{
 	public:
+		/// Awaitable returned by submitAsync(), owns the fence until the GPU signals it, and has none if the submit failed
+		struct Submission
+		{
+			vk::UniqueFence fence{};
+
+			GEN_NODISCARD bool await_ready() const;
+			void await_suspend(std::coroutine_handle<> handle) const;
+			void await_resume() const {}
+		};
+
 		CommandBuffer();
 		~CommandBuffer() { submit(); }
 
@@ -34,9 +45,15 @@ namespace gen
 		/// Helpers
 		void submit();
 
+		/// Submits without blocking, co_await the result in an AsyncJob to resume once the GPU is done
+		/// The CommandBuffer owns the command pool the GPU executes from, it must outlive the returned Submission
+		GEN_NODISCARD Submission submitAsync();
+
 		explicit operator vk::CommandBuffer() const { return get(); }
 
 	private:
+		vk::UniqueFence submitWithFence();
+
 		vk::UniqueCommandPool m_commandPool{};
 		vk::CommandBuffer m_commandBuffer{};
 	};
@@ -47,6 +47,7 @@ namespace gen
 		/// Helpers
 
 		GEN_NODISCARD bool waitForFence(vk::Fence fence, u64 timeout = std::numeric_limits<u64>::max()) const;
+		GEN_NODISCARD bool isFenceSignaled(vk::Fence fence) const;
 		bool submit(vk::SubmitInfo2 const & submitInfo, vk::Fence signal = {}) const;
 		bool submitAndPresent(vk::SubmitInfo2 const & submitInfo, vk::Fence signal, vk::PresentInfoKHR const & presentInfo) const;
 
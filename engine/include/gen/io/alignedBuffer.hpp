@@ -0,0 +1,92 @@
+// Copyright (c) 2023-present Genesis Engine contributors (see LICENSE.txt)
+
+/**
+ * @file alignedBuffer.hpp
+ * @brief Defines the Aligned Buffer class, for unbuffered (File::direct) I/O.
+ */
+
+#pragma once
+
+#include "gen/core.hpp"
+#include "gen/io/file.hpp"
+
+#include <cstddef>
+#include <new>
+#include <span>
+#include <utility>
+
+namespace gen
+{
+
+	/**
+	 * @class AlignedBuffer
+	 * @brief Heap buffer whose address and size are multiples of an alignment.
+	 */
+	class AlignedBuffer
+	{
+	public:
+		/**
+		 * @brief Default constructor, an empty buffer.
+		 */
+		AlignedBuffer() = default;
+
+		/**
+		 * @brief Allocates an uninitialized buffer.
+		 * @param size The minimum size of the buffer, rounded up to alignment.
+		 * @param alignment The alignment, a power of two.
+		 */
+		explicit AlignedBuffer(std::size_t const size, std::size_t const alignment = File::direct_alignment_v)
+			: m_size(alignUp(size, alignment)), m_alignment(alignment)
+		{
+			if (m_size > 0) { m_data = static_cast<std::byte *>(::operator new(m_size, std::align_val_t{m_alignment})); }
+		}
+
+		~AlignedBuffer()
+		{
+			if (m_data != nullptr) { ::operator delete(m_data, std::align_val_t{m_alignment}); }
+		}
+
+		AlignedBuffer(AlignedBuffer && other) noexcept
+			: m_data(std::exchange(other.m_data, nullptr)), m_size(std::exchange(other.m_size, 0)), m_alignment(other.m_alignment)
+		{
+		}
+
+		AlignedBuffer & operator=(AlignedBuffer && other) noexcept
+		{
+			if (this != &other)
+			{
+				if (m_data != nullptr) { ::operator delete(m_data, std::align_val_t{m_alignment}); }
+				m_data		= std::exchange(other.m_data, nullptr);
+				m_size		= std::exchange(other.m_size, 0);
+				m_alignment = other.m_alignment;
+			}
+			return *this;
+		}
+
+		// Disable copy and assignment
+		AlignedBuffer(const AlignedBuffer &)			 = delete;
+		AlignedBuffer & operator=(const AlignedBuffer &) = delete;
+
+		GEN_NODISCARD std::byte * getData() { return m_data; }
+		GEN_NODISCARD std::byte const * getData() const { return m_data; }
+		GEN_NODISCARD std::size_t getSize() const { return m_size; }
+		GEN_NODISCARD std::span<std::byte> getSpan() { return {m_data, m_size}; }
+		GEN_NODISCARD std::span<std::byte const> getSpan() const { return {m_data, m_size}; }
+
+		/**
+		 * @brief Rounds value up to a multiple of alignment (a power of two).
+		 */
+		static constexpr std::size_t alignUp(std::size_t const value, std::size_t const alignment) { return (value + alignment - 1) & ~(alignment - 1); }
+
+		/**
+		 * @brief Rounds value down to a multiple of alignment (a power of two).
+		 */
+		static constexpr u64 alignDown(u64 const value, std::size_t const alignment) { return value & ~static_cast<u64>(alignment - 1); }
+
+	private:
+		std::byte * m_data{};							   //!< Start of the buffer.
+		std::size_t m_size{};							   //!< The size of the buffer.
+		std::size_t m_alignment{File::direct_alignment_v}; //!< The alignment of the buffer.
+	};
+
+} // namespace gen
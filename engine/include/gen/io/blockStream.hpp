@@ -0,0 +1,117 @@
+// Copyright (c) 2023-present Genesis Engine contributors (see LICENSE.txt)
+
+/**
+ * @file blockStream.hpp
+ * @brief Defines the Block Stream class, a pipelined reader for compressed data.
+ *
+ * Blocks are read through FileAsync, decompressed on a shared pool of worker threads and handed out in order,
+ * so disk reads, decompression and the consumer (eg a GPU upload) overlap instead of running back to back.
+ */
+
+#pragma once
+
+#include "gen/core.hpp"
+#include "gen/io/fileAsync.hpp"
+#include "gen/io/pakFile.hpp"
+
+#include <condition_variable>
+#include <memory>
+#include <mutex>
+#include <optional>
+#include <span>
+#include <vector>
+
+namespace gen
+{
+
+	/**
+	 * @class BlockStream
+	 * @brief Pipelined, in order reader of independently compressed blocks.
+	 *
+	 * At most maxInFlight blocks are being read, decompressed or held by the consumer at once,
+	 * capping memory at about twice that many blocks (stored and decompressed) however large the stream is.
+	 * A BlockStream is consumed by a single thread.
+	 */
+	class BlockStream
+	{
+	public:
+		using Block = PakFile::Block;
+
+		static constexpr u32 default_in_flight_v{8};
+
+		/**
+		 * @brief Default constructor.
+		 */
+		BlockStream();
+
+		/**
+		 * @brief Waits for blocks in flight, then closes the stream.
+		 */
+		~BlockStream();
+
+		// Disable copy and assignment
+		BlockStream(const BlockStream &)			 = delete;
+		BlockStream & operator=(const BlockStream &) = delete;
+
+		/**
+		 * @brief Starts streaming blocks of the file at the specified file path.
+		 * @param filePath The path to the file.
+		 * @param blocks The blocks to stream, in order. Uncompressed blocks are split into pak::default_block_size_v pieces.
+		 * @param maxInFlight Maximum number of blocks in flight, including the one held by the consumer.
+		 * @return `true` if the file is successfully opened, `false` otherwise.
+		 */
+		bool open(const fs::path & filePath, std::span<Block const> blocks, u32 maxInFlight = default_in_flight_v);
+
+		/**
+		 * @brief Starts streaming an entry of an archive.
+		 * @return `true` if the archive is successfully opened and the entry's block table is valid, `false` otherwise.
+		 */
+		bool open(PakFile const & pak, PakFile::Entry const & entry, u32 maxInFlight = default_in_flight_v);
+
+		/**
+		 * @brief Waits for blocks in flight, then closes the stream.
+		 */
+		void close();
+
+		/**
+		 * @brief Checks if a stream is open.
+		 */
+		GEN_NODISCARD bool isValid() const { return m_file.isValid(); }
+
+		/**
+		 * @brief Blocks until the next block is ready.
+		 * @return The decompressed block, valid until the next call to next() or close().
+		 *         `std::nullopt` at the end of the stream, or once a block failed to read or decompress (see hasFailed()).
+		 */
+		std::optional<FileView> next();
+
+		/**
+		 * @brief Checks if a block failed to read or decompress, which ends the stream.
+		 */
+		GEN_NODISCARD bool hasFailed() const;
+
+		/**
+		 * @brief Returns the number of blocks in the stream, after splitting.
+		 */
+		GEN_NODISCARD u32 getBlockCount() const { return static_cast<u32>(m_blocks.size()); }
+
+	private:
+		struct Slot;
+
+		void issue(u32 block);
+		void complete(u32 block, FileAsync::Result const & result);
+		void decode(u32 block);
+		Slot & slotOf(u32 block) const;
+
+		FileAsync m_file;				   //!< The file, for reads.
+		std::vector<Block> m_blocks{};	   //!< Blocks of the stream.
+		std::unique_ptr<Slot[]> m_slots{}; //!< Buffers of the blocks in flight, block n uses slot n % m_slotCount.
+		u32 m_slotCount{};				   //!< Maximum number of blocks in flight.
+		u32 m_next{};					   //!< Next block to hand out.
+		u32 m_decoding{};				   //!< Blocks queued for or being decompressed.
+		bool m_failed{};				   //!< A block failed, ending the stream.
+		mutable std::mutex m_mutex;		   //!< Guards the slot states, m_decoding and m_failed.
+		std::condition_variable m_ready;   //!< Signalled whenever a block completes.
+	};
+
+} // namespace gen
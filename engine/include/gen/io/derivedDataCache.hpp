@@ -0,0 +1,194 @@
+// Copyright (c) 2023-present Genesis Engine contributors (see LICENSE.txt)
+
+/**
+ * @file derivedDataCache.hpp
+ * @brief Defines the Derived Data Cache class, an on-disk cache of build artifacts addressed by the hash of their inputs.
+ *
+ * Compiled shaders, transcoded textures and the like are keyed by everything they are derived from
+ * (source bytes, compiler and options), so they are reused across runs and across branches instead of being rebuilt.
+ */
+
+#pragma once
+
+#include "gen/core.hpp"
+#include "gen/io/file.hpp"
+
+#include <array>
+#include <cstddef>
+#include <list>
+#include <mutex>
+#include <optional>
+#include <span>
+#include <string>
+#include <string_view>
+#include <type_traits>
+#include <unordered_map>
+#include <vector>
+
+namespace gen
+{
+
+	/**
+	 * @class DerivedDataCache
+	 * @brief Thread-safe cache of artifacts in a local directory, evicting the least recently used past a size limit.
+	 *
+	 * Artifacts are written to a temporary file and renamed into place, so readers (in this process or another one
+	 * sharing the directory) see a whole artifact or none, even if the writer crashes. Recency survives restarts:
+	 * a hit refreshes the modification time of the artifact, which open() sorts by.
+	 */
+	class DerivedDataCache
+	{
+	public:
+		/**
+		 * @brief 128-bit hash of the inputs of an artifact.
+		 */
+		struct Key
+		{
+			u64 high{};
+			u64 low{};
+
+			bool operator==(Key const &) const = default;
+
+			/**
+			 * @brief Returns the key as 32 hex digits.
+			 */
+			GEN_NODISCARD std::string toString() const;
+
+			/**
+			 * @brief Parses 32 hex digits.
+			 */
+			static std::optional<Key> fromString(std::string_view text);
+
+			struct Hash
+			{
+				std::size_t operator()(Key const & key) const { return static_cast<std::size_t>(key.low); }
+			};
+		};
+
+		/**
+		 * @brief Builds a Key from the inputs of an artifact (MurmurHash3 x64 128).
+		 *
+		 * Every input that changes the artifact must be added: source bytes, included files, tool version and options.
+		 * Each add() is length prefixed, so {"ab", "c"} and {"a", "bc"} give different keys.
+		 */
+		class KeyBuilder
+		{
+		public:
+			KeyBuilder & add(std::span<std::byte const> data);
+
+			KeyBuilder & add(std::string_view const text) { return add(std::as_bytes(std::span{text})); }
+
+			template <typename T>
+				requires std::is_integral_v<T> || std::is_enum_v<T>
+			KeyBuilder & add(T const value)
+			{
+				update(std::as_bytes(std::span{&value, 1}));
+				return *this;
+			}
+
+			GEN_NODISCARD Key finish() const;
+
+		private:
+			void update(std::span<std::byte const> data);
+			void mix(u64 k1, u64 k2);
+
+			u64 m_h1{};
+			u64 m_h2{};
+			u64 m_length{};
+			std::array<std::byte, 16> m_tail{};
+			std::size_t m_tailSize{};
+		};
+
+		static constexpr u64 default_capacity_v{u64{1} << 30};
+
+		/**
+		 * @brief Default constructor.
+		 */
+		DerivedDataCache() = default;
+
+		/**
+		 * @brief Destructor.
+		 */
+		~DerivedDataCache() = default;
+
+		// Disable copy and assignment
+		DerivedDataCache(const DerivedDataCache &)			   = delete;
+		DerivedDataCache & operator=(const DerivedDataCache &) = delete;
+
+		/**
+		 * @brief Opens (or creates) the cache in a directory, indexing the artifacts already in it.
+		 * @param directory The cache directory, may be shared by several processes.
+		 * @param capacity Total size of the artifacts above which the least recently used are evicted.
+		 * @return `true` if the directory is usable, `false` otherwise.
+		 */
+		bool open(const fs::path & directory, u64 capacity = default_capacity_v);
+
+		/**
+		 * @brief Closes the cache, artifacts stay on disk.
+		 */
+		void close();
+
+		/**
+		 * @brief Checks if the cache is open.
+		 */
+		GEN_NODISCARD bool isValid() const;
+
+		/**
+		 * @brief Reads an artifact, marking it most recently used.
+		 * @return The artifact, or `std::nullopt` on a miss.
+		 */
+		GEN_NODISCARD std::optional<std::vector<std::byte>> get(Key const & key);
+
+		/**
+		 * @brief Stores an artifact, replacing any previous one, then evicts down to the capacity.
+		 * @return `true` if the artifact is stored, `false` if it could not be written or is larger than the capacity.
+		 */
+		bool put(Key const & key, std::span<std::byte const> data);
+
+		/**
+		 * @brief Returns the artifact, producing and storing it on a miss.
+		 * @param produce Callable returning `std::optional<std::vector<std::byte>>`, `std::nullopt` if it failed.
+		 * @return The artifact, or `std::nullopt` if it missed and produce failed.
+		 */
+		template <typename Produce>
+		std::optional<std::vector<std::byte>> getOrPut(Key const & key, Produce && produce)
+		{
+			if (auto ret = get(key)) { return ret; }
+			auto ret = std::optional<std::vector<std::byte>>{produce()};
+			if (ret) { put(key, *ret); }
+			return ret;
+		}
+
+		/**
+		 * @brief Deletes an artifact.
+		 */
+		void remove(Key const & key);
+
+		/**
+		 * @brief Returns the total size of the artifacts known to this process.
+		 */
+		GEN_NODISCARD u64 getSize() const;
+
+		GEN_NODISCARD u64 getCapacity() const;
+
+	private:
+		struct Item
+		{
+			u64 size{};
+			std::list<Key>::iterator use{}; //!< Position in m_uses.
+		};
+
+		GEN_NODISCARD fs::path getPath(Key const & key) const;
+		void touch(Key const & key, u64 size);
+		void forget(Key const & key);
+		void evict();
+
+		fs::path m_directory;								//!< The cache directory, empty when closed.
+		u64 m_capacity{default_capacity_v};					//!< Total size above which artifacts are evicted.
+		u64 m_size{};										//!< Total size of the indexed artifacts.
+		std::list<Key> m_uses{};							//!< Indexed artifacts, most recently used first.
+		std::unordered_map<Key, Item, Key::Hash> m_items{}; //!< Indexed artifacts by key.
+		mutable std::mutex m_mutex;							//!< Guards the index.
+	};
+
+} // namespace gen
@@ -11,12 +11,14 @@
 #pragma once
 
 #include "gen/core.hpp"
+#include "gen/io/ioStats.hpp"
 
+#include <cstddef>
 #include <filesystem>
-#include <fstream>
-#include <memory>
+#include <ios>
 #include <mutex>
-#include <string>
+#include <span>
+#include <string_view>
 
 namespace gen
 {
@@ -29,6 +31,7 @@ namespace gen
 	 *
 	 * The File class provides a thread-safe mechanism for synchronous file handling.
 	 * It supports opening, reading, writing, seeking, and retrieving information about files.
+	 * Reads and writes go straight to the OS, nothing is buffered in user space, and are counted in IoStats.
 	 */
 	class File
 	{
@@ -41,20 +44,42 @@ namespace gen
 			in	   = std::ios::in,	   //!< Read mode.
 			out	   = std::ios::out,	   //!< Write mode.
 			ate	   = std::ios::ate,	   //!< Open at the end of the file.
-			app	   = std::ios::app,	   //!< Append mode.
+			app	   = std::ios::app,	   //!< Append mode, only write() at position -1 is allowed.
 			trunc  = std::ios::trunc,  //!< Truncate the file if it exists.
-			binary = std::ios::binary, //!< Binary mode.
+			binary = std::ios::binary, //!< Binary mode (files are always binary).
+			/**
+			 * @brief Unbuffered mode, bypassing the OS cache (O_DIRECT) so bulk streaming reads do not evict hot data.
+			 *
+			 * Offsets, sizes and buffer addresses must be multiples of direct_alignment_v, see AlignedBuffer.
+			 */
+			direct = 1 << 24,
+			/**
+			 * @brief Scratch mode: the path names a directory, in which an unnamed file (O_TMPFILE) is created.
+			 *
+			 * The file is readable and writable, and disappears once closed (or if the process dies).
+			 */
+			temporary = 1 << 25,
 		};
 
+		/**
+		 * @brief Alignment of offsets, sizes and buffers in direct mode, a safe upper bound of storage block sizes.
+		 */
+		static constexpr std::size_t direct_alignment_v{4096};
+
 		/**
 		 * @brief Default constructor.
 		 */
-		File() = default;
+		File() : File(IoStats::default_category_v) {}
+
+		/**
+		 * @brief Constructor tagging the I/O of the file with a category, see IoStats.
+		 */
+		explicit File(std::string_view const category) : m_stats(&IoStats::get(category)) {}
 
 		/**
-		 * @brief Default destructor.
+		 * @brief Destructor, closes the file.
 		 */
-		~File() = default;
+		~File();
 
 		// Disable copy and assignment
 		File(const File &)			   = delete;
@@ -62,10 +87,20 @@ namespace gen
 
 		/**
 		 * @brief Opens a file with the specified file path.
-		 * @param filePath The path to the file.
+		 *
+		 * Writing (out or app) creates the file unless it is also opened for reading, the file is only truncated with trunc.
+		 * ate starts the file position at the end of the file.
+		 *
+		 * @param filePath The path to the file, or to a directory with temporary.
+		 * @param mode Combination of Mode bits.
 		 * @return `true` if the file is successfully opened, `false` otherwise.
 		 */
-		bool open(const fs::path & filePath);
+		bool open(const fs::path & filePath, int mode = in | binary);
+
+		/**
+		 * @brief Closes the file.
+		 */
+		void close();
 
 		/**
 		 * @brief Reads data from the file into the provided buffer.
@@ -90,13 +125,36 @@ namespace gen
 		 * @param data Pointer to the data to be written.
 		 * @param dataSize The size of the data to write.
 		 * @param position The position in the file where the data will be written.
-		 *        If set to -1, the data will be appended to the end of the file.
-		 * @param mode The file mode for opening the file.
-		 * @param flush Whether to flush the file after writing.
+		 *        If set to -1, the data is written at the current position, or appended to the end of the file with mode app.
+		 *        Files opened with app only take -1: the end is found under the file's mutex, which a position would bypass.
+		 * @param mode std::ios::app to append when position is -1.
+		 * @param flush Whether to flush the data to storage after writing.
 		 * @return `true` if the write operation is successful, `false` otherwise.
 		 */
 		bool write(const void * data, std::size_t dataSize, std::streampos position = -1, std::ios_base::openmode mode = std::ios::app, bool flush = false);
 
+		/**
+		 * @brief Reads data at the specified offset, without touching the file position.
+		 *
+		 * Lock-free: any number of threads may read (and write) different regions of the file concurrently.
+		 *
+		 * @param offset The position in the file to read from.
+		 * @param buffer The buffer to read into, its size is the size of the data to read.
+		 * @return The number of bytes read (short only at the end of the file), or -1 if an error occurs.
+		 */
+		i64 readAt(u64 offset, std::span<std::byte> buffer) const;
+
+		/**
+		 * @brief Writes data at the specified offset, without touching the file position.
+		 *
+		 * Lock-free: any number of threads may write (and read) different regions of the file concurrently.
+		 *
+		 * @param offset The position in the file to write to.
+		 * @param buffer The data to write.
+		 * @return The number of bytes written, or -1 if an error occurs or the file was opened with app.
+		 */
+		i64 writeAt(u64 offset, std::span<std::byte const> buffer) const;
+
 		/**
 		 * @brief Seeks to the specified position in the file.
 		 * @param position The position to seek to.
@@ -125,14 +183,21 @@ namespace gen
 		/**
 		 * @brief Returns the timestamp of the file.
 		 * @return The timestamp of the file as the number of seconds since the epoch,
-		 *         or -1 if the file is not valid or an error occurs.
+		 *         or -1 if the file is not valid, is temporary or an error occurs.
 		 */
 		i64 getFileTimeStamp();
 
 	private:
-		std::fstream m_file; //!< The file stream.
-		std::mutex m_mutex;	 //!< Mutex for thread safety.
-		fs::path m_filePath; //!< The path to the file.
+		std::mutex m_mutex;	 //!< Mutex guarding the file position.
+		fs::path m_filePath; //!< The path to the file, empty for temporary files.
+		u64 m_position{};	 //!< The file position, used by read(), write(), seek() and tell().
+		int m_mode{};		 //!< The Mode bits the file was opened with.
+		IoStats * m_stats;	 //!< Where the I/O of the file is counted.
+#if GEN_PLATFORM_WINDOWS
+		void * m_handle{}; //!< The native file handle.
+#else
+		int m_handle{-1}; //!< The native file handle.
+#endif
 	};
 
 } // namespace gen
@@ -1,10 +1,186 @@
 // Copyright (c) 2023-present Genesis Engine contributors (see LICENSE.txt)
 
+/**
+ * @file fileAsync.hpp
+ * @brief Defines the Asynchronous File class.
+ *
+ * Reads and writes are queued and completed in the background: through io_uring on Linux,
+ * or a small pool of I/O threads where io_uring is unavailable.
+ */
+
 #pragma once
 
 #include "gen/core.hpp"
+#include "gen/io/file.hpp"
+
+#include <atomic>
+#include <cstddef>
+#include <functional>
+#include <future>
+#include <memory>
+#include <span>
+#include <string_view>
 
 namespace gen
 {
 
+	/**
+	 * @class FileAsync
+	 * @brief Asynchronous File class.
+	 *
+	 * Every operation is positional (no shared file offset), so any number of them can be in flight at once.
+	 * Submitting never waits on the disk, which keeps it safe to call from the frame loop.
+	 * Files opened with File::app take no writes, they complete with EINVAL: append through File instead.
+	 *
+	 * Buffers must stay alive (and untouched) until the operation completes.
+	 * Callbacks run on an I/O thread: keep them short and hand heavy work off elsewhere.
+	 */
+	class FileAsync
+	{
+	public:
+		/**
+		 * @brief Outcome of an operation.
+		 */
+		struct Result
+		{
+			u64 bytes{}; //!< Bytes transferred, reads are only short at the end of the file.
+			int error{}; //!< errno style error code, 0 on success.
+
+			explicit operator bool() const { return error == 0; }
+		};
+
+		using Callback = std::function<void(Result const &)>;
+
+		/**
+		 * @brief A single read (or write) in a batch.
+		 */
+		template <typename Byte>
+		struct Request
+		{
+			std::span<Byte> buffer{};
+			u64 offset{};
+			Callback callback{};
+		};
+
+		using ReadRequest  = Request<std::byte>;
+		using WriteRequest = Request<std::byte const>;
+
+		/**
+		 * @brief Backend completing the operations, chosen once per process.
+		 */
+		enum class Backend
+		{
+			eIoUring,
+			eThreadPool,
+		};
+
+		/**
+		 * @brief Default constructor.
+		 */
+		FileAsync();
+
+		/**
+		 * @brief Constructor tagging the I/O of the file with a category, see IoStats.
+		 */
+		explicit FileAsync(std::string_view category);
+
+		/**
+		 * @brief Waits for outstanding operations, then closes the file.
+		 */
+		~FileAsync();
+
+		// Disable copy and assignment
+		FileAsync(const FileAsync &)			 = delete;
+		FileAsync & operator=(const FileAsync &) = delete;
+
+		/**
+		 * @brief Opens a file with the specified file path.
+		 * @param filePath The path to the file.
+		 * @param mode Combination of File::Mode bits, as for File::open().
+		 * @return `true` if the file is successfully opened, `false` otherwise.
+		 */
+		bool open(const fs::path & filePath, int mode = File::in | File::binary);
+
+		/**
+		 * @brief Waits for outstanding operations, then closes the file.
+		 */
+		void close();
+
+		/**
+		 * @brief Checks if the file is valid and open.
+		 */
+		GEN_NODISCARD bool isValid() const;
+
+		/**
+		 * @brief Returns the size of the file in bytes, or -1 if the file is not valid.
+		 */
+		GEN_NODISCARD i64 getFileSize() const;
+
+		/**
+		 * @brief Queues a read of buffer.size() bytes at offset.
+		 */
+		void read(std::span<std::byte> buffer, u64 offset, Callback callback);
+
+		/**
+		 * @brief Queues a read of buffer.size() bytes at offset.
+		 * @return Future completed with the Result.
+		 */
+		std::future<Result> read(std::span<std::byte> buffer, u64 offset);
+
+		/**
+		 * @brief Queues a batch of reads, submitted together.
+		 */
+		void read(std::span<ReadRequest> requests);
+
+		/**
+		 * @brief Queues a write of buffer at offset.
+		 */
+		void write(std::span<std::byte const> buffer, u64 offset, Callback callback);
+
+		/**
+		 * @brief Queues a write of buffer at offset.
+		 * @return Future completed with the Result.
+		 */
+		std::future<Result> write(std::span<std::byte const> buffer, u64 offset);
+
+		/**
+		 * @brief Queues a batch of writes, submitted together.
+		 */
+		void write(std::span<WriteRequest> requests);
+
+		/**
+		 * @brief Blocks until every operation queued on this file has completed (including its callback).
+		 */
+		void wait() const;
+
+		/**
+		 * @brief Returns the number of operations queued on this file that have not completed yet.
+		 */
+		GEN_NODISCARD u32 getPending() const;
+
+		/**
+		 * @brief Returns the Backend in use.
+		 */
+		static Backend getBackend();
+
+		/**
+		 * @brief State shared with in-flight operations, which may outlive the FileAsync by a few instructions.
+		 */
+		struct State
+		{
+			std::atomic<u32> pending{};
+			IoStats * stats{}; //!< Where the I/O of the file is counted, from submission to completion.
+		};
+
+	private:
+		std::shared_ptr<State> m_state; //!< Outstanding operation count.
+		fs::path m_filePath;			//!< The path to the file.
+		bool m_append{};				//!< Opened with File::app, which rejects positional writes.
+#if GEN_PLATFORM_WINDOWS
+		void * m_handle{}; //!< The native file handle.
+#else
+		int m_handle{-1}; //!< The native file handle.
+#endif
+	};
+
 } // namespace gen
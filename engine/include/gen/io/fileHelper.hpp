@@ -1,12 +1,46 @@
 // Copyright (c) 2023-present Genesis Engine contributors (see LICENSE.txt)
 
+/**
+ * @file fileHelper.hpp
+ * @brief Defines helpers for loading whole files.
+ */
+
 #pragma once
 
+#include "gen/core.hpp"
+#include "gen/io/file.hpp"
+
+#include <cstddef>
+#include <memory_resource>
+#include <optional>
+#include <span>
+
 namespace gen
 {
 
 	class fileHelper
 	{
+	public:
+		/**
+		 * @brief Reads a whole file into memory from an arena: one open, one fstat, one allocation and one read.
+		 *
+		 * The buffer belongs to the arena, release it with arena.deallocate(data, size, alignment) unless the arena
+		 * releases everything at once (eg std::pmr::monotonic_buffer_resource). Large files that are only read
+		 * are better mapped with MappedFile, which costs neither the copy nor the memory.
+		 *
+		 * @param filePath The path to the file.
+		 * @param arena The memory resource to allocate the buffer from.
+		 * @param alignment The alignment of the buffer, the default suits SPIR-V (see asSpirv()).
+		 * @return The contents of the file, empty for an empty file, or `std::nullopt` if the file could not be read.
+		 */
+		static std::optional<std::span<std::byte>> readAll(const fs::path & filePath, std::pmr::memory_resource & arena,
+														   std::size_t alignment = alignof(std::max_align_t));
+
+		/**
+		 * @brief Views SPIR-V bytecode as the 32-bit words vk::ShaderModuleCreateInfo takes.
+		 * @return The words, empty if data is not 4-byte aligned or not a whole number of words.
+		 */
+		static std::span<u32 const> asSpirv(std::span<std::byte const> data);
 	};
 
 } // namespace gen
@@ -0,0 +1,155 @@
+// Copyright (c) 2023-present Genesis Engine contributors (see LICENSE.txt)
+
+/**
+ * @file fileWatcher.hpp
+ * @brief Defines the File Watcher class, reporting changes to files on a background thread.
+ *
+ * Replaces polling File::getFileTimeStamp() every frame to hot reload shaders and assets:
+ * the OS reports changes (inotify), and bursts of changes are coalesced into one batch per watch.
+ */
+
+#pragma once
+
+#include "gen/core.hpp"
+#include "gen/io/file.hpp"
+
+#include <chrono>
+#include <functional>
+#include <map>
+#include <memory>
+#include <mutex>
+#include <span>
+#include <thread>
+#include <vector>
+
+namespace gen
+{
+	namespace io
+	{
+		class WatchBackend;
+	} // namespace io
+
+	/**
+	 * @class FileWatcher
+	 * @brief Watches files and directories, delivering batched change notifications on a background thread.
+	 *
+	 * Changes are collected until none arrived for the latency (or for at most max_delay_factor_v times the latency),
+	 * then each watch receives the changes under it, sorted by path, with the changes to a single path coalesced:
+	 * an editor saving through a temporary file reports one change, not a create, a few writes and a rename.
+	 * Only files are reported, directories show up as the files added or removed in them.
+	 */
+	class FileWatcher
+	{
+	public:
+		/**
+		 * @brief What happened to a path since the previous batch.
+		 */
+		enum class Action
+		{
+			eAdded,	   //!< Created or moved in, which may replace an existing file.
+			eModified, //!< Written to (reported once the writer closed it).
+			eRemoved,  //!< Deleted or moved out.
+			eRescan,   //!< Changes were lost (eg the OS queue overflowed), anything under the path may have changed.
+		};
+
+		struct Change
+		{
+			fs::path path{}; //!< Absolute path of the file.
+			Action action{};
+		};
+
+		/**
+		 * @brief Receives a batch of changes, on the watcher thread.
+		 *
+		 * Keep it short (eg queue the paths for the main thread), the next batch waits for it.
+		 */
+		using Callback = std::function<void(std::span<Change const>)>;
+
+		using WatchId = u32;
+
+		/**
+		 * @brief Source of the changes.
+		 */
+		enum class Backend
+		{
+			eInotify, //!< Reported by the OS (Linux).
+			ePolling, //!< Found by comparing timestamps and sizes every poll_interval_v.
+		};
+
+		static constexpr WatchId invalid_watch_v{0};
+		static constexpr std::chrono::milliseconds default_latency_v{100};
+		static constexpr std::chrono::milliseconds poll_interval_v{500};
+		static constexpr u32 max_delay_factor_v{4};
+
+		/**
+		 * @brief Constructor, the watcher thread starts with the first watch.
+		 * @param latency How long to wait for more changes before delivering a batch.
+		 * @param backend The preferred Backend, polling is used when it is unavailable.
+		 */
+		explicit FileWatcher(std::chrono::milliseconds latency = default_latency_v, Backend backend = Backend::eInotify);
+
+		/**
+		 * @brief Stops the watcher thread, dropping changes not delivered yet.
+		 */
+		~FileWatcher();
+
+		// Disable copy and assignment
+		FileWatcher(const FileWatcher &)			 = delete;
+		FileWatcher & operator=(const FileWatcher &) = delete;
+
+		/**
+		 * @brief Starts watching a directory or a file.
+		 *
+		 * Watching a file watches its directory for that name, so it keeps working when the file is replaced,
+		 * or when it does not exist yet.
+		 *
+		 * @param path The directory or file to watch.
+		 * @param callback Receives the changes under path.
+		 * @param recursive Whether to watch subdirectories, ignored for files.
+		 * @return An id for unwatch(), or invalid_watch_v if path could not be watched.
+		 */
+		WatchId watch(const fs::path & path, Callback callback, bool recursive = true);
+
+		/**
+		 * @brief Stops a watch.
+		 *
+		 * Once it returns, callback is no longer running nor called, unless unwatch() is called from a callback:
+		 * the watch may then still receive the rest of the current batch.
+		 */
+		void unwatch(WatchId id);
+
+		/**
+		 * @brief Returns the Backend in use.
+		 */
+		GEN_NODISCARD Backend getBackend() const;
+
+	private:
+		using Clock = std::chrono::steady_clock;
+
+		struct Watch
+		{
+			WatchId id{};
+			fs::path directory{}; //!< The watched directory, or the directory of the watched file.
+			fs::path file{};	  //!< Name of the watched file, empty when watching a directory.
+			bool recursive{};
+			Callback callback{};
+		};
+
+		void run(std::stop_token const & stop);
+		void record(const fs::path & path, Action action);
+		void deliver();
+		GEN_NODISCARD Clock::time_point getDueTime() const;
+
+		std::unique_ptr<io::WatchBackend> m_backend; //!< Reports the changes.
+		std::chrono::milliseconds m_latency;		 //!< How long to wait for more changes before delivering a batch.
+		std::mutex m_mutex;							 //!< Guards m_watches and m_nextId.
+		std::vector<Watch> m_watches{};				 //!< Active watches.
+		WatchId m_nextId{1};						 //!< Id of the next watch.
+		std::mutex m_deliverMutex;					 //!< Held while callbacks run.
+		std::map<fs::path, Action> m_pending{};		 //!< Coalesced changes not delivered yet, used by the watcher thread only.
+		Clock::time_point m_first{};				 //!< When the first pending change arrived.
+		Clock::time_point m_last{};					 //!< When the last pending change arrived.
+		std::jthread m_thread;						 //!< The watcher thread, reading changes and running callbacks.
+	};
+
+} // namespace gen
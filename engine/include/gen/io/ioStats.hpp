@@ -0,0 +1,115 @@
+// Copyright (c) 2023-present Genesis Engine contributors (see LICENSE.txt)
+
+/**
+ * @file ioStats.hpp
+ * @brief Defines the I/O Stats class, counting bytes, operations and latencies per caller category.
+ *
+ * Files are tagged with a category when constructed, the same way loggers are (File m_file{"shaders"}),
+ * so a slow level load can be traced to the subsystem issuing the I/O.
+ */
+
+#pragma once
+
+#include "gen/core.hpp"
+
+#include <array>
+#include <atomic>
+#include <chrono>
+#include <string>
+#include <string_view>
+#include <vector>
+
+namespace gen
+{
+	class Logger;
+
+	/**
+	 * @class IoStats
+	 * @brief Counters and latency histograms of the I/O of one category.
+	 *
+	 * Recording is a handful of relaxed atomic adds, cheap enough to leave on in release builds.
+	 * Latencies land in log-linear buckets (4 per power of two), so percentiles are within 12.5% of the exact value.
+	 */
+	class IoStats
+	{
+	public:
+		using Clock = std::chrono::steady_clock;
+
+		static constexpr std::string_view default_category_v{"io"};
+
+		enum class Op : u8
+		{
+			eRead,
+			eWrite,
+			eSync,
+			eCount,
+		};
+
+		/**
+		 * @brief Totals of one Op of one category.
+		 */
+		struct Summary
+		{
+			std::string_view category{};
+			Op op{};
+			u64 count{};
+			u64 bytes{};
+			std::chrono::nanoseconds p50{};
+			std::chrono::nanoseconds p99{};
+			std::chrono::nanoseconds max{};
+		};
+
+		/**
+		 * @brief Returns the stats of a category, created on first use and alive until the process exits.
+		 *
+		 * Takes a lock, look the category up once (when a file is constructed) rather than per operation.
+		 */
+		static IoStats & get(std::string_view category);
+
+		/**
+		 * @brief Returns the totals of every category and Op with at least one operation, sorted by category.
+		 */
+		static std::vector<Summary> getSummaries();
+
+		/**
+		 * @brief Logs the totals of every category, eg at shutdown.
+		 */
+		static void dump(Logger const & logger);
+
+		/**
+		 * @brief Clears the counters of every category, eg before a load to measure it alone.
+		 */
+		static void resetAll();
+
+		/**
+		 * @brief Records a completed operation, from any thread.
+		 */
+		void record(Op op, u64 bytes, Clock::duration latency);
+
+		GEN_NODISCARD std::string_view getCategory() const { return m_category; }
+
+		// Disable copy and assignment
+		IoStats(const IoStats &)			 = delete;
+		IoStats & operator=(const IoStats &) = delete;
+
+	private:
+		static constexpr std::size_t bucket_count_v{64 * 4};
+
+		struct Counters
+		{
+			std::atomic<u64> count{};
+			std::atomic<u64> bytes{};
+			std::atomic<u64> max{}; //!< Nanoseconds.
+			std::array<std::atomic<u64>, bucket_count_v> buckets{};
+		};
+
+		explicit IoStats(std::string_view category) : m_category(category) {}
+
+		GEN_NODISCARD Summary summarize(Op op) const;
+		void reset();
+
+		std::string m_category;												//!< The category, as given to get().
+		std::array<Counters, static_cast<std::size_t>(Op::eCount)> m_ops{}; //!< Counters of each Op.
+	};
+
+} // namespace gen
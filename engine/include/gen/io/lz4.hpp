@@ -0,0 +1,41 @@
+// Copyright (c) 2023-present Genesis Engine contributors (see LICENSE.txt)
+
+/**
+ * @file lz4.hpp
+ * @brief Declares the LZ4 block codec used by packed asset archives.
+ *
+ * Reads and writes the standard LZ4 block format (no frame), so blocks interoperate with the reference library.
+ * This header is self-contained (no engine dependencies) so tools can use it directly.
+ */
+
+#pragma once
+
+#include <cstddef>
+#include <span>
+
+namespace gen::lz4
+{
+	/**
+	 * @brief Returns the worst case compressed size of size bytes.
+	 */
+	constexpr std::size_t compressBound(std::size_t const size)
+	{
+		return size + size / 255 + 16;
+	}
+
+	/**
+	 * @brief Compresses src into a single block.
+	 * @param src The data to compress.
+	 * @param dst The buffer to compress into, compressBound(src.size()) bytes always suffice.
+	 * @return The size of the block, or 0 if it does not fit in dst.
+	 */
+	std::size_t compress(std::span<std::byte const> src, std::span<std::byte> dst);
+
+	/**
+	 * @brief Decompresses a single block.
+	 * @param src The block.
+	 * @param dst The buffer to decompress into, its size must be exactly the original size.
+	 * @return `true` if the block is valid and decompresses to exactly dst.size() bytes, `false` otherwise.
+	 */
+	bool decompress(std::span<std::byte const> src, std::span<std::byte> dst);
+} // namespace gen::lz4
@@ -0,0 +1,115 @@
+// Copyright (c) 2023-present Genesis Engine contributors (see LICENSE.txt)
+
+/**
+ * @file mappedFile.hpp
+ * @brief Defines the read-only Memory Mapped File class.
+ *
+ * Maps a whole file into memory, letting large assets be consumed in place without copying them through a stream buffer.
+ */
+
+#pragma once
+
+#include "gen/core.hpp"
+
+#include <cstddef>
+#include <filesystem>
+#include <span>
+
+namespace gen
+{
+
+	namespace fs = std::filesystem;
+
+	/**
+	 * @brief Read-only view into a MappedFile, valid while the MappedFile stays open.
+	 */
+	using FileView = std::span<std::byte const>;
+
+	/**
+	 * @class MappedFile
+	 * @brief Read-only Memory Mapped File class.
+	 *
+	 * The mapping is immutable, so views may be read from any number of threads without locking.
+	 */
+	class MappedFile
+	{
+	public:
+		/**
+		 * @brief Expected access pattern, forwarded to the OS (madvise) to tune read-ahead.
+		 */
+		enum class Access
+		{
+			eNormal,	 //!< No particular pattern.
+			eSequential, //!< Read front to back: aggressive read-ahead, pages can be dropped soon after use.
+			eRandom,	 //!< Scattered reads: no read-ahead.
+			eWillNeed,	 //!< Start paging the range in now.
+		};
+
+		/**
+		 * @brief Default constructor.
+		 */
+		MappedFile() = default;
+
+		/**
+		 * @brief Unmaps the file.
+		 */
+		~MappedFile();
+
+		MappedFile(MappedFile && other) noexcept;
+		MappedFile & operator=(MappedFile && other) noexcept;
+
+		// Disable copy and assignment
+		MappedFile(const MappedFile &)			   = delete;
+		MappedFile & operator=(const MappedFile &) = delete;
+
+		/**
+		 * @brief Maps the file at the specified file path.
+		 * @param filePath The path to the file.
+		 * @param access Expected access pattern for the whole file.
+		 * @param hugePages Align the mapping to huge pages and ask for them (only honored where supported, eg Linux with THP for page cache).
+		 * @return `true` if the file is successfully mapped (an empty file maps to an empty view), `false` otherwise.
+		 */
+		bool open(const fs::path & filePath, Access access = Access::eNormal, bool hugePages = false);
+
+		/**
+		 * @brief Unmaps the file, invalidating every view.
+		 */
+		void close();
+
+		/**
+		 * @brief Checks if a file is mapped.
+		 */
+		GEN_NODISCARD bool isValid() const { return m_valid; }
+
+		/**
+		 * @brief Returns a view of the whole file.
+		 */
+		GEN_NODISCARD FileView getData() const { return {m_data, m_size}; }
+
+		/**
+		 * @brief Returns a view of size bytes at offset, clamped to the file.
+		 */
+		GEN_NODISCARD FileView getView(std::size_t offset, std::size_t size) const;
+
+		/**
+		 * @brief Returns the size of the file in bytes.
+		 */
+		GEN_NODISCARD std::size_t getSize() const { return m_size; }
+
+		/**
+		 * @brief Hints the access pattern of a range (eg eWillNeed before streaming a texture out of a pack).
+		 */
+		void advise(Access access, FileView view) const;
+
+	private:
+		std::byte const * m_data{}; //!< Start of the file in memory.
+		std::size_t m_size{};		//!< The size of the file.
+		void * m_mapping{};			//!< Start of the mapping, may precede m_data.
+		std::size_t m_mappingSize{};	//!< The size of the mapping.
+		bool m_valid{};				//!< Whether a file is mapped.
+#if GEN_PLATFORM_WINDOWS
+		void * m_section{}; //!< File mapping object.
+#endif
+	};
+
+} // namespace gen
@@ -0,0 +1,173 @@
+// Copyright (c) 2023-present Genesis Engine contributors (see LICENSE.txt)
+
+/**
+ * @file pakFile.hpp
+ * @brief Defines the Packed Asset Archive class.
+ *
+ * Thousands of small assets are shipped as one .gpak archive (built by tools/pak-builder),
+ * replacing a file open per asset with a single open and a memory-mapped table of contents.
+ */
+
+#pragma once
+
+#include "gen/core.hpp"
+#include "gen/io/fileAsync.hpp"
+#include "gen/io/mappedFile.hpp"
+#include "gen/io/pakFormat.hpp"
+
+#include <cstddef>
+#include <optional>
+#include <span>
+#include <string_view>
+#include <vector>
+
+namespace gen
+{
+
+	/**
+	 * @class PakFile
+	 * @brief Read-only Packed Asset Archive class.
+	 *
+	 * Names resolve in constant time through the hash-indexed table of contents, read in place from the mapping.
+	 * Entries are read (and decompressed) straight out of the mapping, or streamed through FileAsync.
+	 * Once open, every const member may be called from any number of threads.
+	 */
+	class PakFile
+	{
+	public:
+		/**
+		 * @brief An entry in the archive, valid while the archive stays open.
+		 */
+		struct Entry
+		{
+			std::string_view name{};		//!< Relative path with '/' separators.
+			u64 offset{};					//!< Offset of the stored data in the archive.
+			u64 storedSize{};				//!< Size of the stored (possibly compressed) data.
+			u64 size{};						//!< Size of the original data.
+			pak::Compression compression{}; //!< How the data is stored.
+			u32 blockSize{};				//!< Original size of each block, 0 when compressed as a whole.
+		};
+
+		/**
+		 * @brief An independently decompressible part of an entry.
+		 */
+		struct Block
+		{
+			u64 offset{};					//!< Offset of the stored data in the archive.
+			u64 storedSize{};				//!< Size of the stored (possibly compressed) data.
+			u64 size{};						//!< Size of the original data.
+			pak::Compression compression{}; //!< How the data is stored.
+		};
+
+		/**
+		 * @brief Default constructor.
+		 */
+		PakFile() = default;
+
+		/**
+		 * @brief Waits for outstanding reads, then closes the archive.
+		 */
+		~PakFile() = default;
+
+		// Disable copy and assignment
+		PakFile(const PakFile &)			 = delete;
+		PakFile & operator=(const PakFile &) = delete;
+
+		/**
+		 * @brief Opens the archive at the specified file path and validates its table of contents.
+		 * @param filePath The path to the archive.
+		 * @return `true` if the archive is successfully opened, `false` otherwise.
+		 */
+		bool open(const fs::path & filePath);
+
+		/**
+		 * @brief Waits for outstanding reads, then closes the archive, invalidating every Entry.
+		 */
+		void close();
+
+		/**
+		 * @brief Checks if an archive is open.
+		 */
+		GEN_NODISCARD bool isValid() const { return m_mapping.isValid(); }
+
+		/**
+		 * @brief Returns the path of the archive.
+		 */
+		GEN_NODISCARD const fs::path & getPath() const { return m_filePath; }
+
+		/**
+		 * @brief Returns the number of entries in the archive.
+		 */
+		GEN_NODISCARD u32 getEntryCount() const { return static_cast<u32>(m_entries.size()); }
+
+		/**
+		 * @brief Returns the entry at index, entries are ordered by name hash.
+		 */
+		GEN_NODISCARD Entry getEntry(u32 index) const;
+
+		/**
+		 * @brief Looks up an entry by name.
+		 * @return The entry, or `std::nullopt` if the archive has no entry with that name.
+		 */
+		GEN_NODISCARD std::optional<Entry> find(std::string_view name) const;
+
+		/**
+		 * @brief Returns the stored bytes of an entry in place, which are the original data unless it is compressed.
+		 */
+		GEN_NODISCARD FileView getView(Entry const & entry) const;
+
+		/**
+		 * @brief Returns the blocks of an entry in order, a single block unless the entry was compressed in blocks.
+		 * @return The blocks, empty if the block table is corrupt.
+		 */
+		GEN_NODISCARD std::vector<Block> getBlocks(Entry const & entry) const;
+
+		/**
+		 * @brief Reads (and decompresses) an entry from the mapping.
+		 * @param entry The entry to read.
+		 * @param buffer The buffer to read into, its size must be entry.size.
+		 * @return `true` if the entry is successfully read, `false` otherwise.
+		 */
+		bool read(Entry const & entry, std::span<std::byte> buffer) const;
+
+		/**
+		 * @brief Reads (and decompresses) an entry from the mapping.
+		 * @return The data, empty if the entry could not be read.
+		 */
+		GEN_NODISCARD std::vector<std::byte> read(Entry const & entry) const;
+
+		/**
+		 * @brief Queues a read of an entry through FileAsync instead of the mapping.
+		 *
+		 * Compressed entries are staged in a temporary buffer and decompressed on the I/O thread before callback runs,
+		 * see BlockStream to stream large entries with bounded memory and parallel decompression.
+		 *
+		 * @param entry The entry to read.
+		 * @param buffer The buffer to read into, its size must be entry.size. Must stay alive until callback runs.
+		 * @param callback Receives the Result, bytes is entry.size on success.
+		 */
+		void readAsync(Entry const & entry, std::span<std::byte> buffer, FileAsync::Callback callback);
+
+		/**
+		 * @brief Blocks until every readAsync() has completed (including its callback).
+		 */
+		void wait() const { m_async.wait(); }
+
+		/**
+		 * @brief Checks whether entries stored with compression can be read by this build.
+		 */
+		static bool supports(pak::Compression compression);
+
+	private:
+		GEN_NODISCARD Entry toEntry(pak::Entry const & entry) const;
+
+		fs::path m_filePath;					 //!< The path to the archive.
+		MappedFile m_mapping;					 //!< The whole archive.
+		FileAsync m_async;						 //!< The archive, for streamed reads.
+		std::span<pak::Entry const> m_entries{}; //!< Table of contents, sorted by hash.
+		std::span<u32 const> m_buckets{};		 //!< First entry of each bucket, plus one past the last.
+		std::string_view m_names{};				 //!< Entry names.
+		u32 m_bucketBits{};						 //!< Number of hash bits selecting a bucket.
+	};
+
+} // namespace gen
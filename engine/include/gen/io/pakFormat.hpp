@@ -0,0 +1,127 @@
+// Copyright (c) 2023-present Genesis Engine contributors (see LICENSE.txt)
+
+/**
+ * @file pakFormat.hpp
+ * @brief Defines the on-disk layout of packed asset archives (.gpak).
+ *
+ * This header is self-contained (no engine dependencies) so tools/pak-builder can use it directly.
+ */
+
+#pragma once
+
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <string_view>
+
+/**
+ * @brief Packed asset archive layout, all values are little endian.
+ *
+ * | Header | Entry[entryCount] | u32 buckets[(1 << bucketBits) + 1] | names | data... |
+ *
+ * Entries are sorted by name hash, every section starts on a toc_alignment_v boundary and every entry's data
+ * starts on a Header::dataAlignment boundary. The table of contents (everything before the data) is read in place
+ * through a memory mapping: a name resolves to its bucket (the top bucketBits of its hash), and the bucket
+ * holds the range of entries sharing those bits, so a lookup touches one bucket and about one entry.
+ *
+ * Large compressed entries are split into independently compressed blocks (Entry::blockSize > 0), so they can be
+ * streamed and decompressed in parallel. Their stored data is a u32 table of stored block sizes followed by the blocks,
+ * a size with raw_block_bit_v set is a block stored as is because it did not compress.
+ */
+namespace gen::pak
+{
+	inline constexpr std::array<char, 4> magic_v{'G', 'P', 'A', 'K'};
+	inline constexpr std::uint32_t version_v{1};
+	inline constexpr std::size_t toc_alignment_v{64};
+	inline constexpr std::uint32_t default_data_alignment_v{64};
+	inline constexpr std::uint32_t default_block_size_v{256 << 10};
+	inline constexpr std::uint32_t max_block_size_v{1 << 30};
+	inline constexpr std::uint32_t raw_block_bit_v{0x80000000};
+
+	/**
+	 * @brief Per-entry compression.
+	 */
+	enum class Compression : std::uint32_t
+	{
+		eNone, //!< Stored as is, readable in place.
+		eLz4,  //!< LZ4 blocks (see gen/io/lz4.hpp).
+		eZstd, //!< zstd frames, only readable when built with zstd (GEN_HAS_ZSTD).
+	};
+
+	struct Header
+	{
+		std::array<char, 4> magic{magic_v};
+		std::uint32_t version{version_v};
+		std::uint32_t entryCount{};
+		std::uint32_t bucketBits{};
+		std::uint64_t entriesOffset{};
+		std::uint64_t bucketsOffset{};
+		std::uint64_t namesOffset{};
+		std::uint64_t namesSize{};
+		std::uint64_t dataOffset{}; //!< End of the table of contents.
+		std::uint32_t dataAlignment{default_data_alignment_v};
+		std::uint32_t reserved{};
+	};
+
+	struct Entry
+	{
+		std::uint64_t hash{};		 //!< hashName() of the name.
+		std::uint64_t offset{};		 //!< Offset of the stored data from the start of the archive.
+		std::uint64_t storedSize{};	 //!< Size of the stored (possibly compressed) data.
+		std::uint64_t size{};		 //!< Size of the original data.
+		std::uint32_t nameOffset{};	 //!< Offset of the name in the names section.
+		std::uint32_t nameSize{};	 //!< Size of the name, names are not null terminated.
+		Compression compression{};	 //!< How the data is stored.
+		std::uint32_t blockSize{};	 //!< Original size of each block (the last may be shorter), 0 when compressed as a whole.
+	};
+
+	static_assert(sizeof(Header) == 64 && alignof(Header) <= toc_alignment_v);
+	static_assert(sizeof(Entry) == 48 && alignof(Entry) <= toc_alignment_v);
+
+	/**
+	 * @brief 64-bit FNV-1a hash of an entry name.
+	 *
+	 * Names are relative paths with '/' separators, matched exactly (case sensitive).
+	 */
+	constexpr std::uint64_t hashName(std::string_view const name)
+	{
+		auto ret = std::uint64_t{0xcbf29ce484222325};
+		for (char const c : name)
+		{
+			ret ^= static_cast<std::uint8_t>(c);
+			ret *= 0x100000001b3;
+		}
+		return ret;
+	}
+
+	/**
+	 * @brief Bucket of a hash, its top bucketBits bits (so sorting entries by hash groups them by bucket).
+	 */
+	constexpr std::uint32_t bucketOf(std::uint64_t const hash, std::uint32_t const bucketBits)
+	{
+		return bucketBits == 0 ? 0 : static_cast<std::uint32_t>(hash >> (64 - bucketBits));
+	}
+
+	/**
+	 * @brief Number of bucket bits for entryCount entries: about one entry per bucket.
+	 */
+	constexpr std::uint32_t bucketBitsFor(std::uint32_t const entryCount)
+	{
+		auto ret = std::uint32_t{};
+		while (ret < 31 && (std::uint32_t{1} << ret) < entryCount) { ++ret; }
+		return ret;
+	}
+
+	/**
+	 * @brief Number of blocks of an entry, entries compressed as a whole are a single block.
+	 */
+	constexpr std::uint64_t blockCount(Entry const & entry)
+	{
+		return entry.blockSize == 0 ? 1 : (entry.size + entry.blockSize - 1) / entry.blockSize;
+	}
+
+	constexpr std::uint64_t alignUp(std::uint64_t const value, std::uint64_t const alignment)
+	{
+		return (value + alignment - 1) / alignment * alignment;
+	}
+} // namespace gen::pak
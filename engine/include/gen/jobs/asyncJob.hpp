@@ -0,0 +1,166 @@
+// Copyright (c) 2023-present Genesis Engine contributors (see LICENSE.txt)
+
+/**
+ * @file asyncJob.hpp
+ * @brief Defines the Async Job coroutine type, and the awaitables it can suspend on.
+ *
+ * A job that would block a thread on a file read, a GPU fence or another job's counter is written as a coroutine
+ * instead: it co_awaits the completion, and the thread runs other jobs until the coroutine is resumed.
+ */
+
+#pragma once
+
+#include "gen/core.hpp"
+#include "gen/io/fileAsync.hpp"
+#include "gen/jobs/coroutineFrame.hpp"
+#include "gen/jobs/jobSystem.hpp"
+
+#include <coroutine>
+#include <cstddef>
+#include <exception>
+#include <functional>
+#include <span>
+#include <type_traits>
+#include <utility>
+
+namespace gen
+{
+
+	/**
+	 * @class AsyncJob
+	 * @brief Coroutine job, started with JobSystem::run() and resumed on whichever job thread is free.
+	 *
+	 * Nothing runs until the job is passed to run(), which owns the coroutine from then on:
+	 * @code
+	 * AsyncJob loadMesh(FileAsync & file, std::span<std::byte> buffer)
+	 * {
+	 *	auto const result = co_await asyncRead(file, buffer, 0);
+	 *	...
+	 * }
+	 * JobSystem::getInstance().run(loadMesh(file, buffer), &counter);
+	 * @endcode
+	 * Arguments are copied into the coroutine frame (from the coroutine frame pool), references must outlive the job.
+	 * Like any job it must not throw.
+	 */
+	class AsyncJob
+	{
+	public:
+		struct promise_type : jobs::CoroutineFrameAllocated
+		{
+			struct FinalAwaiter
+			{
+				bool await_ready() const noexcept { return false; }
+				void await_suspend(std::coroutine_handle<promise_type> const handle) const noexcept
+				{
+					// the frame goes first, waiters may free what its locals referenced once the counter drops
+					auto * const counter = handle.promise().counter;
+					handle.destroy();
+					JobSystem::getInstance().finish(counter);
+				}
+				void await_resume() const noexcept {}
+			};
+
+			AsyncJob get_return_object() { return AsyncJob{std::coroutine_handle<promise_type>::from_promise(*this)}; }
+			std::suspend_always initial_suspend() const noexcept { return {}; }
+			FinalAwaiter final_suspend() const noexcept { return {}; }
+			void return_void() const {}
+			void unhandled_exception() const { std::terminate(); }
+
+			JobSystem::Counter * counter{}; //!< Set by JobSystem::run().
+		};
+
+		AsyncJob(AsyncJob && other) noexcept : m_handle(std::exchange(other.m_handle, nullptr)) {}
+		AsyncJob & operator=(AsyncJob && other) noexcept
+		{
+			std::swap(m_handle, other.m_handle);
+			return *this;
+		}
+
+		/**
+		 * @brief Destroys the coroutine if it was never started.
+		 */
+		~AsyncJob()
+		{
+			if (m_handle) { m_handle.destroy(); }
+		}
+
+		AsyncJob(const AsyncJob &)			   = delete;
+		AsyncJob & operator=(const AsyncJob &) = delete;
+
+	private:
+		friend class JobSystem;
+
+		explicit AsyncJob(std::coroutine_handle<promise_type> const handle) : m_handle(handle) {}
+
+		std::coroutine_handle<promise_type> m_handle; //!< The coroutine, until run() takes it.
+	};
+
+	/**
+	 * @brief Awaitable resuming the coroutine on a job thread once ready() returns true, see JobSystem::resumeWhen().
+	 */
+	struct ResumeWhen
+	{
+		std::function<bool()> ready;
+
+		bool await_ready() const { return ready(); }
+		void await_suspend(std::coroutine_handle<> const handle) { JobSystem::getInstance().resumeWhen(handle, std::move(ready)); }
+		void await_resume() const {}
+	};
+
+	/**
+	 * @brief Suspends until every job tagged with counter is done: co_await counter.
+	 */
+	inline ResumeWhen operator co_await(JobSystem::Counter const & counter)
+	{
+		return ResumeWhen{[&counter] { return counter.isDone(); }};
+	}
+
+	/**
+	 * @brief Awaitable FileAsync operation, resuming the coroutine on a job thread with the Result.
+	 */
+	template <typename Byte>
+	class FileAwaiter
+	{
+	public:
+		FileAwaiter(FileAsync & file, std::span<Byte> const buffer, u64 const offset) : m_file(&file), m_buffer(buffer), m_offset(offset) {}
+
+		bool await_ready() const { return false; }
+
+		void await_suspend(std::coroutine_handle<> const handle)
+		{
+			// resumption may run before read() returns, this must not be touched after it
+			auto callback = [this, handle](FileAsync::Result const & result)
+			{
+				m_result = result;
+				JobSystem::getInstance().resume(handle);
+			};
+			if constexpr (std::is_const_v<Byte>) { m_file->write(m_buffer, m_offset, std::move(callback)); }
+			else { m_file->read(m_buffer, m_offset, std::move(callback)); }
+		}
+
+		FileAsync::Result await_resume() const { return m_result; }
+
+	private:
+		FileAsync * m_file;
+		std::span<Byte> m_buffer;
+		u64 m_offset;
+		FileAsync::Result m_result{};
+	};
+
+	/**
+	 * @brief Reads buffer.size() bytes at offset: auto const result = co_await asyncRead(file, buffer, offset).
+	 */
+	GEN_NODISCARD inline FileAwaiter<std::byte> asyncRead(FileAsync & file, std::span<std::byte> const buffer, u64 const offset)
+	{
+		return FileAwaiter<std::byte>{file, buffer, offset};
+	}
+
+	/**
+	 * @brief Writes buffer at offset: auto const result = co_await asyncWrite(file, buffer, offset).
+	 */
+	GEN_NODISCARD inline FileAwaiter<std::byte const> asyncWrite(FileAsync & file, std::span<std::byte const> const buffer, u64 const offset)
+	{
+		return FileAwaiter<std::byte const>{file, buffer, offset};
+	}
+
+} // namespace gen
@@ -0,0 +1,39 @@
+// Copyright (c) 2023-present Genesis Engine contributors (see LICENSE.txt)
+
+/**
+ * @file coroutineFrame.hpp
+ * @brief Defines where coroutine frames (Task, AsyncJob) are allocated.
+ *
+ * Frames come from a pool of recycled blocks sized for them rather than from the global heap, so starting a coroutine
+ * each frame costs a free list pop. They cannot come from a per-frame arena reset every frame: a task waiting
+ * on delay() or nextFrame() outlives the frame that started it, and its frame would be reused under it.
+ */
+
+#pragma once
+
+#include "gen/core.hpp"
+
+#include <cstddef>
+#include <memory_resource>
+#include <new>
+
+namespace gen::jobs
+{
+	/**
+	 * @brief Returns the thread-safe pool coroutine frames are allocated from, alive until the process exits.
+	 */
+	std::pmr::memory_resource & getCoroutineFrameResource();
+
+	/**
+	 * @brief Base of promise types, allocating their coroutine frames from getCoroutineFrameResource().
+	 */
+	struct CoroutineFrameAllocated
+	{
+		static void * operator new(std::size_t const size) { return getCoroutineFrameResource().allocate(size, __STDCPP_DEFAULT_NEW_ALIGNMENT__); }
+
+		static void operator delete(void * const pointer, std::size_t const size)
+		{
+			getCoroutineFrameResource().deallocate(pointer, size, __STDCPP_DEFAULT_NEW_ALIGNMENT__);
+		}
+	};
+} // namespace gen::jobs
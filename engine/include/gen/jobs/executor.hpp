@@ -0,0 +1,171 @@
+// Copyright (c) 2023-present Genesis Engine contributors (see LICENSE.txt)
+
+/**
+ * @file executor.hpp
+ * @brief Defines the Executor class, resuming Tasks on the main thread at fixed points of the frame loop.
+ */
+
+#pragma once
+
+#include "gen/core.hpp"
+#include "gen/core/monoInstance.hpp"
+#include "gen/jobs/jobSystem.hpp"
+#include "gen/jobs/task.hpp"
+
+#include <coroutine>
+#include <functional>
+#include <mutex>
+#include <queue>
+#include <thread>
+#include <unordered_set>
+#include <vector>
+
+namespace gen
+{
+
+	/**
+	 * @class Executor
+	 * @brief Owns spawned Tasks and resumes those waiting on nextFrame(), delay() or resumeOnMainThread().
+	 *
+	 * Application::run() calls update() at the start of every frame, before Application::update(), so a task resumed
+	 * there sees the state the previous frame left and runs before this frame's game code. Tasks may hop to a job
+	 * thread with resumeOnWorker() and come back with resumeOnMainThread(), suspending from any thread is safe.
+	 */
+	class Executor : public MonoInstance<Executor>
+	{
+	public:
+		/**
+		 * @brief Constructor, the calling thread becomes the main thread.
+		 */
+		Executor();
+
+		/**
+		 * @brief Destroys the tasks that have not returned, without resuming them.
+		 */
+		~Executor();
+
+		Executor(const Executor &)			   = delete;
+		Executor(Executor &&)				   = delete;
+		Executor & operator=(const Executor &) = delete;
+		Executor & operator=(Executor &&)	   = delete;
+
+		/**
+		 * @brief Starts a task on the calling thread and keeps it alive until it returns.
+		 *
+		 * An exception escaping a spawned task terminates, as one escaping a std::thread does.
+		 */
+		void spawn(Task<> task);
+
+		/**
+		 * @brief Resumes the tasks due this frame, main thread only.
+		 * @param deltaTime Seconds since the last frame, as given by Time::GetDeltaTime() (so scaled by the time scale).
+		 */
+		void update(float deltaTime);
+
+		/**
+		 * @brief Queues a coroutine for the next update(), from any thread.
+		 */
+		void resumeNextFrame(std::coroutine_handle<> handle);
+
+		/**
+		 * @brief Queues a coroutine for the first update() at least seconds of game time from now, from any thread.
+		 */
+		void resumeAfter(float seconds, std::coroutine_handle<> handle);
+
+		/**
+		 * @brief Returns the game time accumulated by update(), in seconds.
+		 */
+		GEN_NODISCARD double getTime() const;
+
+		/**
+		 * @brief Returns the number of spawned tasks that have not returned.
+		 */
+		GEN_NODISCARD std::size_t getTaskCount() const;
+
+		GEN_NODISCARD bool isMainThread() const { return std::this_thread::get_id() == m_mainThread; }
+
+	private:
+		friend struct jobs::TaskPromiseBase;
+
+		struct Timer
+		{
+			double time{};
+			std::coroutine_handle<> handle{};
+
+			bool operator>(Timer const & other) const { return time > other.time; }
+		};
+
+		void finish(std::coroutine_handle<> task) noexcept;
+
+		std::thread::id m_mainThread;											  //!< The thread update() runs on.
+		mutable std::mutex m_mutex;												  //!< Guards everything below but m_resuming.
+		std::unordered_set<void *> m_tasks;										  //!< Frame addresses of the spawned tasks.
+		std::vector<std::coroutine_handle<>> m_ready;							  //!< Coroutines for the next update().
+		std::priority_queue<Timer, std::vector<Timer>, std::greater<>> m_timers; //!< Coroutines waiting on delay(), soonest first.
+		double m_time{};														  //!< Game time accumulated by update().
+		std::vector<std::coroutine_handle<>> m_resuming;						  //!< Coroutines resumed by the current update().
+	};
+
+	/**
+	 * @brief Awaitable resuming the coroutine on the main thread, in the next Executor::update().
+	 */
+	struct NextFrame
+	{
+		bool await_ready() const { return false; }
+		void await_suspend(std::coroutine_handle<> const handle) const { Executor::getInstance().resumeNextFrame(handle); }
+		void await_resume() const {}
+	};
+
+	/**
+	 * @brief Awaitable resuming the coroutine on the main thread once seconds of game time have passed.
+	 */
+	struct Delay
+	{
+		float seconds{};
+
+		bool await_ready() const { return seconds <= 0.0f; }
+		void await_suspend(std::coroutine_handle<> const handle) const { Executor::getInstance().resumeAfter(seconds, handle); }
+		void await_resume() const {}
+	};
+
+	/**
+	 * @brief Awaitable moving the coroutine to the main thread, a no-op if it is already there.
+	 */
+	struct ResumeOnMainThread
+	{
+		bool await_ready() const { return Executor::getInstance().isMainThread(); }
+		void await_suspend(std::coroutine_handle<> const handle) const { Executor::getInstance().resumeNextFrame(handle); }
+		void await_resume() const {}
+	};
+
+	/**
+	 * @brief Awaitable moving the coroutine to a job thread, see JobSystem.
+	 */
+	struct ResumeOnWorker
+	{
+		bool await_ready() const { return false; }
+		void await_suspend(std::coroutine_handle<> const handle) const { JobSystem::getInstance().resume(handle); }
+		void await_resume() const {}
+	};
+
+	GEN_NODISCARD inline NextFrame nextFrame()
+	{
+		return {};
+	}
+
+	GEN_NODISCARD inline Delay delay(float const seconds)
+	{
+		return Delay{seconds};
+	}
+
+	GEN_NODISCARD inline ResumeOnMainThread resumeOnMainThread()
+	{
+		return {};
+	}
+
+	GEN_NODISCARD inline ResumeOnWorker resumeOnWorker()
+	{
+		return {};
+	}
+
+} // namespace gen
@@ -0,0 +1,154 @@
+// Copyright (c) 2023-present Genesis Engine contributors (see LICENSE.txt)
+
+/**
+ * @file jobSystem.hpp
+ * @brief Defines the Job System class, spreading work over every core.
+ */
+
+#pragma once
+
+#include "gen/core.hpp"
+#include "gen/core/monoInstance.hpp"
+
+#include <atomic>
+#include <coroutine>
+#include <deque>
+#include <functional>
+#include <limits>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+namespace gen
+{
+	class AsyncJob;
+
+	/**
+	 * @class JobSystem
+	 * @brief Work-stealing job system, one thread per hardware thread counting the thread that created it.
+	 *
+	 * Each thread runs jobs from its own deque (newest first, cache warm) and steals from the others (oldest first)
+	 * when it runs dry. Completion is tracked with counters: waiting on one runs other jobs meanwhile,
+	 * so the main thread helps instead of blocking, and jobs may wait on jobs they spawned.
+	 * Idle threads spin briefly, then sleep until work arrives.
+	 */
+	class JobSystem : public MonoInstance<JobSystem>
+	{
+	public:
+		/**
+		 * @brief Number of unfinished jobs tagged with it, which must outlive them.
+		 */
+		class Counter
+		{
+		public:
+			Counter() = default;
+
+			// Disable copy and assignment
+			Counter(const Counter &)			 = delete;
+			Counter & operator=(const Counter &) = delete;
+
+			GEN_NODISCARD bool isDone() const { return m_pending.load(std::memory_order_acquire) == 0; }
+
+		private:
+			friend class JobSystem;
+
+			std::atomic<u32> m_pending{};
+		};
+
+		using Job = std::function<void()>;
+
+		static constexpr u32 invalid_thread_v{std::numeric_limits<u32>::max()};
+
+		/**
+		 * @brief Starts threadCount - 1 workers, the calling thread is thread 0 and runs jobs while it waits.
+		 * @param threadCount Total number of threads, the number of hardware threads by default.
+		 */
+		explicit JobSystem(u32 threadCount = std::thread::hardware_concurrency());
+
+		/**
+		 * @brief Runs every job left, then stops the workers.
+		 */
+		~JobSystem();
+
+		JobSystem(const JobSystem &)			 = delete;
+		JobSystem(JobSystem &&)				 = delete;
+		JobSystem & operator=(const JobSystem &) = delete;
+		JobSystem & operator=(JobSystem &&)		 = delete;
+
+		/**
+		 * @brief Queues a job, from any thread.
+		 * @param job The job, must not throw.
+		 * @param counter Incremented now and decremented once the job has run, may be nullptr.
+		 */
+		void run(Job job, Counter * counter = nullptr);
+
+		/**
+		 * @brief Starts a coroutine job, from any thread.
+		 * @param job The coroutine, first resumed on a job thread.
+		 * @param counter Incremented now and decremented once the coroutine has returned, may be nullptr.
+		 */
+		void run(AsyncJob job, Counter * counter = nullptr);
+
+		/**
+		 * @brief Queues the resumption of a suspended coroutine, from any thread (eg an I/O completion callback).
+		 */
+		void resume(std::coroutine_handle<> handle);
+
+		/**
+		 * @brief Resumes a suspended coroutine on a job thread once ready() returns true, for completions nothing signals.
+		 *
+		 * Idle threads poll ready(), and sleep in short intervals rather than indefinitely while any coroutine waits.
+		 */
+		void resumeWhen(std::coroutine_handle<> handle, std::function<bool()> ready);
+
+		/**
+		 * @brief Runs jobs until counter drops to zero, from any thread (jobs included).
+		 */
+		void wait(Counter const & counter);
+
+		GEN_NODISCARD u32 getThreadCount() const { return static_cast<u32>(m_workers.size()); }
+
+		/**
+		 * @brief Returns the index of the calling thread, or invalid_thread_v if it is not one of the job system's.
+		 */
+		static u32 getThreadIndex();
+
+	private:
+		friend class AsyncJob;
+
+		struct Entry;
+		struct Worker;
+
+		struct Parked
+		{
+			std::coroutine_handle<> handle{};
+			std::function<bool()> ready{};
+		};
+
+		void work(u32 index, std::stop_token const & stop);
+		Entry * find(Worker * worker);
+		Entry * take(Worker * worker);
+		bool poll();
+		void finish(Counter * counter);
+		void execute(Worker * worker, Entry * entry);
+		void sleep(Counter const * counter);
+		void wake(bool all);
+		GEN_NODISCARD bool hasWork() const;
+
+		std::vector<std::unique_ptr<Worker>> m_workers; //!< Deques of every thread, index 0 is the creating thread's.
+		std::mutex m_mutex;								//!< Guards m_injected.
+		std::deque<Entry *> m_injected;					//!< Jobs queued by threads outside the job system.
+		std::atomic<u32> m_injectedCount{};				//!< Size of m_injected, checked without the lock.
+		std::atomic<u32> m_outstanding{};				//!< Jobs queued or running, and coroutine jobs not returned yet.
+		std::atomic<u32> m_sleepers{};					//!< Threads about to sleep or sleeping on m_epoch.
+		std::atomic<u32> m_epoch{};						//!< Bumped (and notified) when work arrives or a counter drops to zero.
+		std::atomic<bool> m_stopping{};					//!< Set once the workers may exit.
+		std::mutex m_parkedMutex;						//!< Guards m_parked.
+		std::vector<Parked> m_parked;					//!< Coroutines waiting in resumeWhen().
+		std::atomic<u32> m_parkedCount{};				//!< Size of m_parked, checked without the lock.
+		// destroyed first, joining the threads
+		std::vector<std::jthread> m_threads;
+	};
+
+} // namespace gen
@@ -0,0 +1,73 @@
+// Copyright (c) 2023-present Genesis Engine contributors (see LICENSE.txt)
+
+/**
+ * @file parallelFor.hpp
+ * @brief Defines parallel_for, running a callable over every element of a range on the job system.
+ */
+
+#pragma once
+
+#include "gen/core.hpp"
+#include "gen/jobs/jobSystem.hpp"
+
+#include <algorithm>
+#include <atomic>
+#include <cstddef>
+#include <iterator>
+#include <ranges>
+
+namespace gen
+{
+
+	/**
+	 * @brief Calls fn(element) for every element of range, spread over the job system's threads.
+	 *
+	 * The range is cut in chunks of grainSize elements, claimed in order by the calling thread and at most one
+	 * job per other thread, so a call costs a handful of jobs whatever the size of the range.
+	 * Returns once every element is done, the calling thread working meanwhile. Runs inline when the range fits
+	 * in one chunk or no job system exists. Use std::views::iota(0u, count) to iterate over indices.
+	 *
+	 * @param range Random access range, not modified while the call runs.
+	 * @param grainSize Elements per chunk, large enough that a chunk outweighs claiming it (a few microseconds of work).
+	 * @param fn Callable taking an element, called concurrently, must not throw.
+	 */
+	template <std::ranges::random_access_range Range, typename Fn>
+		requires std::ranges::sized_range<Range> && std::invocable<Fn &, std::ranges::range_reference_t<Range>>
+	void parallel_for(Range && range, std::size_t const grainSize, Fn && fn)
+	{
+		auto const size		  = static_cast<std::size_t>(std::ranges::size(range));
+		auto const grain	  = std::max(grainSize, std::size_t{1});
+		auto const chunkCount = (size + grain - 1) / grain;
+		auto const first	  = std::ranges::begin(range);
+		auto const runChunk	  = [&](std::size_t const chunk)
+		{
+			auto const begin = chunk * grain;
+			auto const end	 = std::min(begin + grain, size);
+			for (auto index = begin; index < end; ++index) { fn(first[static_cast<std::iter_difference_t<decltype(first)>>(index)]); }
+		};
+
+		if (chunkCount <= 1 || !JobSystem::exists())
+		{
+			for (std::size_t chunk = 0; chunk < chunkCount; ++chunk) { runChunk(chunk); }
+			return;
+		}
+
+		auto & jobSystem = JobSystem::getInstance();
+		auto next		 = std::atomic<std::size_t>{};
+		auto const claim = [&]
+		{
+			for (auto chunk = next.fetch_add(1, std::memory_order_relaxed); chunk < chunkCount; chunk = next.fetch_add(1, std::memory_order_relaxed))
+			{
+				runChunk(chunk);
+			}
+		};
+
+		// no more helpers than threads, each one loops over the chunks
+		auto const helpers = std::min<std::size_t>(jobSystem.getThreadCount(), chunkCount) - 1;
+		auto counter	   = JobSystem::Counter{};
+		for (std::size_t helper = 0; helper < helpers; ++helper) { jobSystem.run(claim, &counter); }
+		claim();
+		jobSystem.wait(counter);
+	}
+
+} // namespace gen
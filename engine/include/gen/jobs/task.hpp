@@ -0,0 +1,166 @@
+// Copyright (c) 2023-present Genesis Engine contributors (see LICENSE.txt)
+
+/**
+ * @file task.hpp
+ * @brief Defines the Task class, a coroutine producing a value that other coroutines co_await.
+ */
+
+#pragma once
+
+#include "gen/core.hpp"
+#include "gen/jobs/coroutineFrame.hpp"
+
+#include <coroutine>
+#include <exception>
+#include <optional>
+#include <utility>
+
+namespace gen
+{
+	class Executor;
+
+	template <typename T>
+	class Task;
+
+	namespace jobs
+	{
+		/**
+		 * @brief Part of the promise of a Task shared by every T.
+		 */
+		struct TaskPromiseBase : CoroutineFrameAllocated
+		{
+			struct FinalAwaiter
+			{
+				bool await_ready() const noexcept { return false; }
+				template <typename Promise>
+				std::coroutine_handle<> await_suspend(std::coroutine_handle<Promise> const handle) const noexcept
+				{
+					return handle.promise().complete(handle);
+				}
+				void await_resume() const noexcept {}
+			};
+
+			std::suspend_always initial_suspend() const noexcept { return {}; }
+			FinalAwaiter final_suspend() const noexcept { return {}; }
+			void unhandled_exception() { exception = std::current_exception(); }
+
+			/**
+			 * @brief Returns the coroutine to continue with once this one has returned.
+			 */
+			std::coroutine_handle<> complete(std::coroutine_handle<> self) noexcept;
+
+			std::coroutine_handle<> continuation{}; //!< The coroutine awaiting this one.
+			Executor * executor{};					//!< The executor owning this coroutine, if spawned.
+			std::exception_ptr exception{};			//!< Rethrown to the awaiting coroutine.
+		};
+
+		template <typename T>
+		struct TaskPromise : TaskPromiseBase
+		{
+			Task<T> get_return_object() { return Task<T>{std::coroutine_handle<TaskPromise>::from_promise(*this)}; }
+
+			template <typename Value>
+			void return_value(Value && result)
+			{
+				value.emplace(std::forward<Value>(result));
+			}
+
+			T result()
+			{
+				if (exception) { std::rethrow_exception(exception); }
+				return std::move(*value);
+			}
+
+			std::optional<T> value{};
+		};
+
+		template <>
+		struct TaskPromise<void> : TaskPromiseBase
+		{
+			Task<void> get_return_object();
+
+			void return_void() const {}
+
+			void result() const
+			{
+				if (exception) { std::rethrow_exception(exception); }
+			}
+		};
+	} // namespace jobs
+
+	/**
+	 * @class Task
+	 * @brief Lazy coroutine: starts when co_awaited, resumes its awaiter with the result (or exception) when done.
+	 *
+	 * Replaces per-frame polling of gameplay state machines with straight-line code:
+	 * @code
+	 * Task<> openDoor(Door & door)
+	 * {
+	 *	door.play("open");
+	 *	co_await delay(2.0f);
+	 *	co_await resumeOnWorker();
+	 *	auto navMesh = co_await rebuildNavMesh(door.getRoom());
+	 *	co_await nextFrame();
+	 *	door.getRoom().setNavMesh(std::move(navMesh));
+	 * }
+	 * Executor::getInstance().spawn(openDoor(door));
+	 * @endcode
+	 * Frames come from the coroutine frame pool, see coroutineFrame.hpp.
+	 */
+	template <typename T = void>
+	class Task
+	{
+	public:
+		using promise_type = jobs::TaskPromise<T>;
+
+		class Awaiter
+		{
+		public:
+			explicit Awaiter(std::coroutine_handle<promise_type> const handle) : m_handle(handle) {}
+
+			bool await_ready() const noexcept { return false; }
+
+			std::coroutine_handle<> await_suspend(std::coroutine_handle<> const awaiting) noexcept
+			{
+				m_handle.promise().continuation = awaiting;
+				return m_handle;
+			}
+
+			T await_resume() { return m_handle.promise().result(); }
+
+		private:
+			std::coroutine_handle<promise_type> m_handle;
+		};
+
+		Task(Task && other) noexcept : m_handle(std::exchange(other.m_handle, nullptr)) {}
+		Task & operator=(Task && other) noexcept
+		{
+			std::swap(m_handle, other.m_handle);
+			return *this;
+		}
+
+		~Task()
+		{
+			if (m_handle) { m_handle.destroy(); }
+		}
+
+		Task(const Task &)			   = delete;
+		Task & operator=(const Task &) = delete;
+
+		Awaiter operator co_await() && noexcept { return Awaiter{m_handle}; }
+
+	private:
+		friend promise_type;
+		friend class Executor;
+
+		explicit Task(std::coroutine_handle<promise_type> const handle) : m_handle(handle) {}
+
+		std::coroutine_handle<promise_type> m_handle; //!< The coroutine, until an Executor takes it.
+	};
+
+	inline Task<void> jobs::TaskPromise<void>::get_return_object()
+	{
+		return Task<void>{std::coroutine_handle<TaskPromise>::from_promise(*this)};
+	}
+
+} // namespace gen
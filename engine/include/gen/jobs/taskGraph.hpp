@@ -0,0 +1,100 @@
+// Copyright (c) 2023-present Genesis Engine contributors (see LICENSE.txt)
+
+/**
+ * @file taskGraph.hpp
+ * @brief Defines the Task Graph class, running stages on the job system in the order their data accesses require.
+ */
+
+#pragma once
+
+#include "gen/core.hpp"
+#include "gen/jobs/jobSystem.hpp"
+
+#include <atomic>
+#include <functional>
+#include <memory>
+#include <string>
+#include <string_view>
+#include <vector>
+
+namespace gen
+{
+
+	/**
+	 * @class TaskGraph
+	 * @brief Stages declaring the resources they read and write, scheduled across cores on every execute().
+	 *
+	 * Ordering follows registration order wherever two stages conflict on a resource: a writer runs after the
+	 * earlier readers and writer of it, a reader after the earlier writer. Stages that do not conflict run concurrently.
+	 * Resources are plain names ("transforms", "physics"), they only exist to compute the ordering.
+	 */
+	class TaskGraph
+	{
+	public:
+		using Task = std::function<void()>;
+
+		/**
+		 * @brief Resources a stage accesses.
+		 */
+		struct Access
+		{
+			std::vector<std::string> reads;
+			std::vector<std::string> writes;
+		};
+
+		/**
+		 * @brief Default constructor.
+		 */
+		TaskGraph() = default;
+
+		/**
+		 * @brief Destructor.
+		 */
+		~TaskGraph() = default;
+
+		// Disable copy and assignment
+		TaskGraph(const TaskGraph &)			 = delete;
+		TaskGraph & operator=(const TaskGraph &) = delete;
+
+		/**
+		 * @brief Registers a stage, run by every later execute().
+		 * @param name Name of the stage, for debugging.
+		 * @param task The work of the stage, must not throw.
+		 * @param access Resources the stage reads and writes.
+		 */
+		void add(std::string name, Task task, Access access = {});
+
+		/**
+		 * @brief Removes every stage.
+		 */
+		void clear();
+
+		/**
+		 * @brief Runs every stage once and returns when all are done, the calling thread working meanwhile.
+		 *
+		 * Runs the stages in registration order on the calling thread when no job system exists.
+		 * Not reentrant: a stage must not execute its own graph.
+		 */
+		void execute();
+
+		GEN_NODISCARD std::size_t getStageCount() const { return m_stages.size(); }
+
+	private:
+		struct Stage
+		{
+			std::string name{};
+			Task task{};
+			Access access{};
+			std::vector<u32> successors{}; //!< Stages waiting on this one.
+			u32 predecessorCount{};		   //!< Stages this one waits on.
+			std::atomic<u32> remaining{};  //!< Predecessors not done yet, during execute().
+		};
+
+		void compile();
+		void runStage(u32 index, JobSystem::Counter & counter);
+
+		std::vector<std::unique_ptr<Stage>> m_stages; //!< Stages in registration order, which is a valid serial order.
+		bool m_compiled{true};						  //!< Whether successors and predecessorCount are up to date.
+	};
+
+} // namespace gen
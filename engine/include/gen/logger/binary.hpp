@@ -0,0 +1,305 @@
+// Copyright (c) 2023-present Genesis Engine contributors (see LICENSE.txt)
+
+#pragma once
+#include <array>
+#include <concepts>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <format>
+#include <iterator>
+#include <string>
+#include <string_view>
+#include <type_traits>
+#include <vector>
+
+///
+/// \brief Binary encoding for deferred (GEN_LOG_DEFERRED) logging.
+///
+/// Call sites only record the format string and raw argument bytes, formatting happens later:
+/// on the logger's writer thread, or offline through tools/log-decoder when the log file is written in binary.
+///
+/// This header is self-contained (no engine dependencies) so tools can use it directly.
+///
+namespace gen::logger::binary
+{
+	///
+	/// \brief Binary log file layout, all values are in native byte order.
+	///
+	/// header: magic_v, version_v (u16), endian_v (u16)
+	/// followed by records, each starting with a RecordKind (u8):
+	///  eFormat: u32 id, string format
+	///  eText: string line (already formatted, including the newline)
+	///  eLog: u32 format id, u8 level, i32 thread, i64 timestamp (microseconds since epoch), string category,
+	///        u8 has location [string func, string file, i32 line], string args
+	/// strings are a u32 size followed by that many bytes.
+	///
+	inline constexpr std::string_view magic_v{"GLOG"};
+	inline constexpr std::uint16_t version_v{1};
+	inline constexpr std::uint16_t endian_v{0x0102};
+
+	enum class RecordKind : std::uint8_t
+	{
+		eFormat = 1,
+		eText,
+		eLog,
+	};
+
+	enum class ArgType : std::uint8_t
+	{
+		eBool,
+		eChar,
+		eI64,
+		eU64,
+		eF32,
+		eF64,
+		eString,
+		ePointer,
+	};
+
+	///
+	/// \brief Argument types that can be captured as raw bytes.
+	///
+	/// Anything else (user formatters etc.) is formatted eagerly at the call site.
+	///
+	template <typename Type>
+	concept Encodable = (std::is_arithmetic_v<std::remove_cvref_t<Type>> && !std::same_as<std::remove_cvref_t<Type>, long double>) ||
+						std::same_as<std::decay_t<Type>, void *> || std::same_as<std::decay_t<Type>, void const *> ||
+						std::same_as<std::remove_cvref_t<Type>, std::nullptr_t> || std::convertible_to<Type const &, std::string_view>;
+
+	template <typename Type>
+		requires std::is_trivially_copyable_v<Type>
+	void write(std::string & out, Type const value)
+	{
+		auto bytes = std::array<char, sizeof(Type)>{};
+		std::memcpy(bytes.data(), &value, sizeof(Type));
+		out.append(bytes.data(), bytes.size());
+	}
+
+	inline void writeString(std::string & out, std::string_view const text)
+	{
+		write(out, static_cast<std::uint32_t>(text.size()));
+		out.append(text);
+	}
+
+	///
+	/// \brief Append a tagged argument to out.
+	///
+	template <Encodable Type>
+	void encode(std::string & out, Type const & value)
+	{
+		using Raw = std::remove_cvref_t<Type>;
+		if constexpr (std::same_as<Raw, bool>)
+		{
+			write(out, ArgType::eBool);
+			write(out, value);
+		}
+		else if constexpr (std::same_as<Raw, char>)
+		{
+			write(out, ArgType::eChar);
+			write(out, value);
+		}
+		else if constexpr (std::is_integral_v<Raw> && std::is_signed_v<Raw>)
+		{
+			write(out, ArgType::eI64);
+			write(out, static_cast<std::int64_t>(value));
+		}
+		else if constexpr (std::is_integral_v<Raw>)
+		{
+			write(out, ArgType::eU64);
+			write(out, static_cast<std::uint64_t>(value));
+		}
+		else if constexpr (std::same_as<Raw, float>)
+		{
+			write(out, ArgType::eF32);
+			write(out, value);
+		}
+		else if constexpr (std::is_floating_point_v<Raw>)
+		{
+			write(out, ArgType::eF64);
+			write(out, static_cast<double>(value));
+		}
+		else if constexpr (std::is_convertible_v<Type const &, std::string_view>)
+		{
+			write(out, ArgType::eString);
+			writeString(out, std::string_view{value});
+		}
+		else
+		{
+			write(out, ArgType::ePointer);
+			// NOLINTNEXTLINE
+			write(out, static_cast<std::uint64_t>(reinterpret_cast<std::uintptr_t>(static_cast<void const *>(value))));
+		}
+	}
+
+	///
+	/// \brief Sequential reader over binary data, sets ok to false on underflow.
+	///
+	struct Reader
+	{
+		std::string_view bytes{};
+		bool ok{true};
+
+		template <typename Type>
+			requires std::is_trivially_copyable_v<Type>
+		Type read()
+		{
+			auto ret = Type{};
+			if (bytes.size() < sizeof(Type))
+			{
+				ok	  = false;
+				bytes = {};
+				return ret;
+			}
+			std::memcpy(&ret, bytes.data(), sizeof(Type));
+			bytes.remove_prefix(sizeof(Type));
+			return ret;
+		}
+
+		std::string_view readString()
+		{
+			auto const size = read<std::uint32_t>();
+			if (bytes.size() < size)
+			{
+				ok	  = false;
+				bytes = {};
+				return {};
+			}
+			auto const ret = bytes.substr(0, size);
+			bytes.remove_prefix(size);
+			return ret;
+		}
+
+		[[nodiscard]] bool atEnd() const { return bytes.empty(); }
+	};
+
+	///
+	/// \brief A decoded argument.
+	///
+	struct Arg
+	{
+		ArgType type{};
+		std::uint64_t bits{};
+		double real{};
+		std::string_view text{};
+	};
+
+	inline std::vector<Arg> decodeArgs(std::string_view const args)
+	{
+		auto ret	= std::vector<Arg>{};
+		auto reader = Reader{args};
+		while (reader.ok && !reader.atEnd())
+		{
+			auto arg = Arg{.type = reader.read<ArgType>()};
+			switch (arg.type)
+			{
+			case ArgType::eBool: arg.bits = reader.read<bool>() ? 1 : 0; break;
+			case ArgType::eChar: arg.bits = static_cast<std::uint64_t>(static_cast<unsigned char>(reader.read<char>())); break;
+			case ArgType::eI64: arg.bits = static_cast<std::uint64_t>(reader.read<std::int64_t>()); break;
+			case ArgType::eU64:
+			case ArgType::ePointer: arg.bits = reader.read<std::uint64_t>(); break;
+			case ArgType::eF32: arg.real = static_cast<double>(reader.read<float>()); break;
+			case ArgType::eF64: arg.real = reader.read<double>(); break;
+			case ArgType::eString: arg.text = reader.readString(); break;
+			default: reader.ok = false; break;
+			}
+			if (reader.ok) { ret.push_back(arg); }
+		}
+		return ret;
+	}
+
+	///
+	/// \brief Format a single argument with a replacement field spec (eg ":>8.2f").
+	///
+	inline void formatArg(std::string & out, Arg const & arg, std::string_view const spec)
+	{
+		auto const field = std::string{"{"}.append(spec).append("}");
+		auto const apply = [&](auto const & value) { std::vformat_to(std::back_inserter(out), field, std::make_format_args(value)); };
+		try
+		{
+			switch (arg.type)
+			{
+			case ArgType::eBool: apply(arg.bits != 0); break;
+			case ArgType::eChar: apply(static_cast<char>(arg.bits)); break;
+			case ArgType::eI64: apply(static_cast<std::int64_t>(arg.bits)); break;
+			case ArgType::eU64: apply(arg.bits); break;
+			// float keeps its own (shortest round trip) representation
+			case ArgType::eF32: apply(static_cast<float>(arg.real)); break;
+			case ArgType::eF64: apply(arg.real); break;
+			case ArgType::eString: apply(arg.text); break;
+			// NOLINTNEXTLINE
+			case ArgType::ePointer: apply(reinterpret_cast<void const *>(static_cast<std::uintptr_t>(arg.bits))); break;
+			}
+		}
+		catch (std::format_error const &)
+		{
+			out.append("{?}");
+		}
+	}
+
+	///
+	/// \brief Render a format string with encoded arguments, equivalent to std::format for supported replacement fields.
+	///
+	/// Nested (dynamic width / precision) replacement fields are not supported and render as "{?}".
+	///
+	inline std::string render(std::string_view format, std::string_view const args)
+	{
+		auto const decoded = decodeArgs(args);
+		auto ret		   = std::string{};
+		ret.reserve(format.size() + args.size());
+		auto next = std::size_t{};
+		while (!format.empty())
+		{
+			auto const brace = format.find_first_of("{}");
+			ret.append(format.substr(0, brace));
+			if (brace == std::string_view::npos) { break; }
+			auto const current = format[brace];
+			format.remove_prefix(brace + 1);
+			// escaped brace
+			if (!format.empty() && format.front() == current)
+			{
+				ret += current;
+				format.remove_prefix(1);
+				continue;
+			}
+			if (current == '}')
+			{
+				ret += current;
+				continue;
+			}
+			auto const close = format.find('}');
+			if (close == std::string_view::npos)
+			{
+				ret += current;
+				continue;
+			}
+			auto const field = format.substr(0, close);
+			format.remove_prefix(close + 1);
+			auto const colon = field.find(':');
+			auto const index = field.substr(0, colon);
+			auto const spec	 = colon == std::string_view::npos ? std::string_view{} : field.substr(colon);
+			auto position	 = next;
+			if (index.empty()) { ++next; }
+			else
+			{
+				position = 0;
+				for (char const digit : index)
+				{
+					if (digit < '0' || digit > '9')
+					{
+						position = decoded.size();
+						break;
+					}
+					position = position * 10 + static_cast<std::size_t>(digit - '0');
+				}
+			}
+			if (position >= decoded.size())
+			{
+				ret.append("{?}");
+				continue;
+			}
+			formatArg(ret, decoded[position], spec);
+		}
+		return ret;
+	}
+} // namespace gen::logger::binary
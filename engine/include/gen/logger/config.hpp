@@ -2,6 +2,8 @@
 
 #pragma once
 #include <cassert>
+#include <chrono>
+#include <cstdint>
 #include <string>
 #include <unordered_map>
 #include "gen/util/fixed_string.hpp"
@@ -19,6 +21,69 @@ namespace gen::logger
 		eUtc
 	};
 
+	///
+	/// \brief Timestamp precision.
+	///
+	enum class TimestampPrecision
+	{
+		eSeconds,
+		eMilliseconds,
+		eMicroseconds,
+	};
+
+	///
+	/// \brief Behaviour of the console and file sinks when their record ring is full.
+	///
+	enum class Overflow
+	{
+		eBlock,		 ///< wait for the writer thread to make room.
+		eDropNewest, ///< discard the incoming record.
+		eDropOldest, ///< discard the oldest queued record.
+	};
+
+	///
+	/// \brief How deferred (GEN_LOG_DEFERRED) logs are written to the log file.
+	///
+	enum class DeferredOutput
+	{
+		eText,	 ///< formatted on the writer thread.
+		eBinary, ///< written as binary records, to be formatted offline by tools/log-decoder.
+	};
+
+	///
+	/// \brief Size based log file rotation.
+	///
+	struct Rotation
+	{
+		///
+		/// \brief Max size of the log file in bytes before it is rotated, 0 disables rotation.
+		///
+		std::uint64_t maxSize{};
+
+		///
+		/// \brief Number of rotated files to keep ("<path>.1" being the most recent), 0 keeps none.
+		///
+		std::uint32_t maxFiles{};
+	};
+
+	///
+	/// \brief Per call site rate limit (token bucket).
+	///
+	/// Call sites are identified by file and line for verbose logs, else by category and format string.
+	///
+	struct RateLimit
+	{
+		///
+		/// \brief Logs a call site may print in a burst, 0 disables rate limiting.
+		///
+		std::uint32_t burst{};
+
+		///
+		/// \brief Time for a call site to regain one log after its burst is used up.
+		///
+		std::chrono::milliseconds interval{std::chrono::seconds{1}};
+	};
+
 	struct Config
 	{
 		///
@@ -83,5 +148,64 @@ namespace gen::logger
 		/// \brief Timestamp mode.
 		///
 		Timestamp timestamp{Timestamp::eLocal};
+
+		///
+		/// \brief Timestamp precision, sub-second digits are appended after the seconds ("12:34:56.789").
+		///
+		TimestampPrecision timestampPrecision{TimestampPrecision::eSeconds};
+
+		///
+		/// \brief Console and file sink overflow policy.
+		///
+		/// Dropped records are counted and reported by the sink once its writer catches up.
+		///
+		Overflow overflow{Overflow::eBlock};
+
+		///
+		/// \brief Write errors to the console on the logging thread instead of the console writer thread.
+		///
+		/// Queued lines are written first, so ordering is preserved.
+		/// Blocks the caller, but errors reach the terminal even if the process crashes right after.
+		///
+		bool syncErrors{};
+
+		///
+		/// \brief Log file rotation.
+		///
+		/// Only read when the Instance is created.
+		///
+		Rotation rotation{};
+
+		///
+		/// \brief Minimum interval between fdatasync calls on the log file, zero disables syncing.
+		///
+		/// Only read when the Instance is created.
+		///
+		std::chrono::milliseconds syncInterval{};
+
+		///
+		/// \brief Log file output for deferred logs.
+		///
+		/// With eBinary the whole log file is binary (formatted records are embedded as text records).
+		/// Only read when the Instance is created.
+		///
+		DeferredOutput deferredOutput{DeferredOutput::eText};
+
+		///
+		/// \brief Per call site rate limiting.
+		///
+		/// Once a rate limited call site may log again, the number of logs it suppressed is printed first.
+		///
+		RateLimit rateLimit{};
+
+		///
+		/// \brief Collapse consecutive identical logs on a thread into "last message repeated N times".
+		///
+		bool collapseRepeats{};
+
+		///
+		/// \brief Max time collapsed repeats are held back before their count is printed.
+		///
+		std::chrono::milliseconds reportInterval{std::chrono::seconds{5}};
 	};
 } // namespace gen::logger
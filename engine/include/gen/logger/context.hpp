@@ -17,6 +17,18 @@ namespace gen::logger
 	{
 	};
 
+	///
+	/// \brief Source of a log, identifies it for rate limiting.
+	///
+	/// Identified by address: format and file must have static storage duration (string literals, __FILE__).
+	///
+	struct CallSite
+	{
+		std::string_view format{};
+		std::string_view file{};
+		int line{};
+	};
+
 	///
 	/// \brief Log context.
 	///
@@ -52,11 +52,30 @@ namespace gen::logger
 		///
 		void addSink(std::unique_ptr<Sink> sink);
 
+		///
+		/// \brief Check whether a log would pass the active Config's level filters.
+		/// \returns false if no Instance exists.
+		///
+		static bool isEnabled(Level level, std::string_view category);
+
+		///
+		/// \brief Check a log against the active Config's rate limit.
+		/// \returns true if no Instance exists or rate limiting is disabled.
+		///
+		static bool admit(Level level, std::string_view category, CallSite const & site);
+
 		///
 		/// \brief Entrypoint for logging (free) functions.
 		///
 		static void print(std::string_view message, Context const & context);
 
+		///
+		/// \brief Entrypoint for deferred logging: formatting happens on the writer thread (or offline).
+		/// \param format Format string, must have static storage duration.
+		/// \param args Arguments encoded via binary::encode.
+		///
+		static void printDeferred(std::string_view format, std::string_view args, Context const & context);
+
 	private:
 		struct Impl;
 		struct Deleter
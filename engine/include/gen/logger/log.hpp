@@ -3,15 +3,58 @@
 #pragma once
 #include <format>
 #include <string_view>
+#include "binary.hpp"
+#include "context.hpp"
 #include "level.hpp"
 #include "target.hpp"
 
+#if !defined(GEN_LOG_MIN_LEVEL)
+	#define GEN_LOG_MIN_LEVEL 3 // Level::eDebug
+#endif
+
 namespace gen
 {
 	namespace logger
 	{
+		///
+		/// \brief Least severe Level compiled in, set through the GENESIS_LOG_MIN_LEVEL CMake option.
+		///
+		/// Logs less severe than this are removed at compile time, their arguments are never evaluated by the GEN_LOG_* macros.
+		///
+		inline constexpr Level min_level_v{GEN_LOG_MIN_LEVEL};
+
+		constexpr bool isCompiledIn(Level const level)
+		{
+			return level <= min_level_v;
+		}
+
+		///
+		/// \brief Check whether a log with level and category would be printed by the active Instance.
+		///
+		/// Cheap enough to call before formatting anything.
+		///
+		bool isEnabled(Level level, std::string_view category);
+
+		///
+		/// \brief Check a log against the active Config's rate limit, call after isEnabled and before formatting anything.
+		/// \returns false if the log must be suppressed.
+		///
+		bool admit(Level level, std::string_view category, CallSite const & site);
+
 		void print(Level level, std::string_view category, std::string_view message);
 		void print(Level level, std::string_view category, std::string_view function, std::string_view filePath, int curLine, std::string_view message);
+
+		///
+		/// \brief Calling thread's scratch buffer for encoding deferred arguments (cleared).
+		///
+		std::string & deferredBuffer();
+
+		///
+		/// \brief Entrypoints for deferred logging, format must have static storage duration.
+		///
+		void printDeferred(Level level, std::string_view category, std::string_view format, std::string_view args);
+		void printDeferred(
+			Level level, std::string_view category, std::string_view function, std::string_view filePath, int curLine, std::string_view format, std::string_view args);
 	} // namespace logger
 
 	class Logger
@@ -21,40 +64,42 @@ namespace gen
 
 		explicit Logger(std::string_view category);
 
+		[[nodiscard]] bool isEnabled(Level const level) const { return logger::isCompiledIn(level) && logger::isEnabled(level, m_category); }
+
 		template <typename... Args>
 		void error(std::format_string<Args...> fmt, Args &&... args) const
 		{
-			logger::print(Level::eError, m_category, std::format(fmt, std::forward<Args>(args)...));
+			print<Level::eError>(fmt, std::forward<Args>(args)...);
 		}
 
 		template <typename... Args>
 		void verbose_error(std::string_view function, std::string_view filePath, int curLine, std::format_string<Args...> fmt, Args &&... args) const
 		{
-			logger::print(Level::eError, m_category, function, filePath, curLine, std::format(fmt, std::forward<Args>(args)...));
+			verbose_print<Level::eError>(function, filePath, curLine, fmt, std::forward<Args>(args)...);
 		}
 
 		template <typename... Args>
 		void warn(std::format_string<Args...> fmt, Args &&... args) const
 		{
-			logger::print(Level::eWarn, m_category, std::format(fmt, std::forward<Args>(args)...));
+			print<Level::eWarn>(fmt, std::forward<Args>(args)...);
 		}
 
 		template <typename... Args>
 		void verbose_warn(std::string_view function, std::string_view filePath, int curLine, std::format_string<Args...> fmt, Args &&... args) const
 		{
-			logger::print(Level::eWarn, m_category, function, filePath, curLine, std::format(fmt, std::forward<Args>(args)...));
+			verbose_print<Level::eWarn>(function, filePath, curLine, fmt, std::forward<Args>(args)...);
 		}
 
 		template <typename... Args>
 		void info(std::format_string<Args...> fmt, Args &&... args) const
 		{
-			logger::print(Level::eInfo, m_category, std::format(fmt, std::forward<Args>(args)...));
+			print<Level::eInfo>(fmt, std::forward<Args>(args)...);
 		}
 
 		template <typename... Args>
 		void verbose_info(std::string_view function, std::string_view filePath, int curLine, std::format_string<Args...> fmt, Args &&... args) const
 		{
-			logger::print(Level::eInfo, m_category, function, filePath, curLine, std::format(fmt, std::forward<Args>(args)...));
+			verbose_print<Level::eInfo>(function, filePath, curLine, fmt, std::forward<Args>(args)...);
 		}
 
 		template <typename... Args>
@@ -72,16 +117,58 @@ namespace gen
 		template <typename... Args>
 		void debug(std::format_string<Args...> fmt, Args &&... args) const
 		{
-			logger::print(Level::eDebug, m_category, std::format(fmt, std::forward<Args>(args)...));
+			print<Level::eDebug>(fmt, std::forward<Args>(args)...);
 		}
 
 		template <typename... Args>
 		void verbose_debug(std::string_view function, std::string_view filePath, int curLine, std::format_string<Args...> fmt, Args &&... args) const
 		{
-			logger::print(Level::eDebug, m_category, function, filePath, curLine, std::format(fmt, std::forward<Args>(args)...));
+			verbose_print<Level::eDebug>(function, filePath, curLine, fmt, std::forward<Args>(args)...);
 		}
 
 	private:
+#if defined(GEN_LOG_DEFERRED)
+		// deferred builds capture raw arguments instead of formatting them, when every argument type allows it.
+		template <typename... Args>
+		static constexpr bool deferred_v = (logger::binary::Encodable<Args> && ...);
+#else
+		template <typename... Args>
+		static constexpr bool deferred_v = false;
+#endif
+
+		template <typename... Args>
+		static std::string_view encode(Args const &... args)
+		{
+			auto & buffer = logger::deferredBuffer();
+			(logger::binary::encode(buffer, args), ...);
+			return buffer;
+		}
+
+		// all logging funnels through here: compiled out levels vanish, disabled levels return before std::format.
+		template <Level level, typename... Args>
+		void print(std::format_string<Args...> fmt, Args &&... args) const
+		{
+			if constexpr (logger::isCompiledIn(level))
+			{
+				if (!logger::isEnabled(level, m_category)) { return; }
+				if (!logger::admit(level, m_category, {.format = fmt.get()})) { return; }
+				if constexpr (deferred_v<Args...>) { logger::printDeferred(level, m_category, fmt.get(), encode(args...)); }
+				else { logger::print(level, m_category, std::format(fmt, std::forward<Args>(args)...)); }
+			}
+		}
+
+		template <Level level, typename... Args>
+		void verbose_print(std::string_view function, std::string_view filePath, int curLine, std::format_string<Args...> fmt, Args &&... args) const
+		{
+			if constexpr (logger::isCompiledIn(level))
+			{
+				if (!logger::isEnabled(level, m_category)) { return; }
+				if (!logger::admit(level, m_category, {.format = fmt.get(), .file = filePath, .line = curLine})) { return; }
+				if constexpr (deferred_v<Args...>) { logger::printDeferred(level, m_category, function, filePath, curLine, fmt.get(), encode(args...)); }
+				else { logger::print(level, m_category, function, filePath, curLine, std::format(fmt, std::forward<Args>(args)...)); }
+			}
+		}
+
 		std::string_view m_category{};
 	};
 
@@ -92,14 +179,18 @@ namespace gen
 } // namespace gen
 
 // NOLINTBEGIN
-#define INTERNAL_GEN_LOG(logger, level, message, ...)                                                                                                          \
+// arguments are only evaluated if severity is compiled in and enabled at runtime.
+#define INTERNAL_GEN_LOG(genLogger, level, severity, message, ...)                                                                                             \
 	do {                                                                                                                                                       \
-		logger.verbose_##level(__func__, __FILE__, __LINE__, message, ##__VA_ARGS__);                                                                          \
+		if constexpr (::gen::logger::isCompiledIn(severity))                                                                                                   \
+		{                                                                                                                                                      \
+			if ((genLogger).isEnabled(severity)) { (genLogger).verbose_##level(__func__, __FILE__, __LINE__, message, ##__VA_ARGS__); }                        \
+		}                                                                                                                                                      \
 	} while ((void)0, 0)
 
-#define GEN_LOG(logger, message, ...)		INTERNAL_GEN_LOG(logger, log, message, ##__VA_ARGS__)
-#define GEN_LOG_ERROR(logger, message, ...) INTERNAL_GEN_LOG(logger, error, message, ##__VA_ARGS__)
-#define GEN_LOG_WARN(logger, message, ...)	INTERNAL_GEN_LOG(logger, warn, message, ##__VA_ARGS__)
-#define GEN_LOG_INFO(logger, message, ...)	INTERNAL_GEN_LOG(logger, info, message, ##__VA_ARGS__)
-#define GEN_LOG_DEBUG(logger, message, ...) INTERNAL_GEN_LOG(logger, debug, message, ##__VA_ARGS__)
+#define GEN_LOG(genLogger, message, ...)		INTERNAL_GEN_LOG(genLogger, log, ::gen::logger::Level::eInfo, message, ##__VA_ARGS__)
+#define GEN_LOG_ERROR(genLogger, message, ...) INTERNAL_GEN_LOG(genLogger, error, ::gen::logger::Level::eError, message, ##__VA_ARGS__)
+#define GEN_LOG_WARN(genLogger, message, ...)	INTERNAL_GEN_LOG(genLogger, warn, ::gen::logger::Level::eWarn, message, ##__VA_ARGS__)
+#define GEN_LOG_INFO(genLogger, message, ...)	INTERNAL_GEN_LOG(genLogger, info, ::gen::logger::Level::eInfo, message, ##__VA_ARGS__)
+#define GEN_LOG_DEBUG(genLogger, message, ...) INTERNAL_GEN_LOG(genLogger, debug, ::gen::logger::Level::eDebug, message, ##__VA_ARGS__)
 // NOLINTEND
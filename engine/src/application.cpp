@@ -17,7 +17,12 @@ namespace gen
 	{
 		while (!Window::getInstance().shouldClose())
 		{
-			update(Time::GetDeltaTime());
+			m_engine->getFrameArena().nextFrame();
+			Time::UpdateDeltaTime();
+			auto const deltaTime = Time::GetDeltaTime();
+			m_executor.update(deltaTime);
+			update(deltaTime);
+			m_frameGraph.execute();
 			draw();
 		}
 	}
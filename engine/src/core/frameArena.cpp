@@ -0,0 +1,70 @@
+// Copyright (c) 2023-present Genesis Engine contributors (see LICENSE.txt)
+
+#include "gen/core/frameArena.hpp"
+
+#include <algorithm>
+#include <bit>
+
+namespace gen
+{
+	FrameArena::FrameArena(std::size_t const capacity, u32 const bufferCount)
+	{
+		for (u32 index = 0; index < std::max(bufferCount, 1u); ++index)
+		{
+			auto buffer		 = std::make_unique<Buffer>();
+			buffer->memory	 = std::make_unique_for_overwrite<std::byte[]>(capacity);
+			buffer->capacity = capacity;
+			m_buffers.push_back(std::move(buffer));
+		}
+	}
+
+	FrameArena::~FrameArena()
+	{
+		for (auto const & buffer : m_buffers) { freeOverflow(*buffer); }
+	}
+
+	void FrameArena::nextFrame()
+	{
+		auto const next = (m_current.load(std::memory_order_relaxed) + 1) % getBufferCount();
+		// reset before publishing, the release makes a regrown buffer visible to the acquire in allocate()
+		reset(*m_buffers[next]);
+		m_current.store(next, std::memory_order_release);
+	}
+
+	std::size_t FrameArena::getUsed() const
+	{
+		auto & buffer = *m_buffers[m_current.load(std::memory_order_acquire)];
+		auto lock	  = std::scoped_lock{buffer.mutex};
+		return std::min(buffer.offset.load(std::memory_order_relaxed), buffer.capacity) + buffer.overflowSize;
+	}
+
+	void * FrameArena::allocateOverflow(Buffer & buffer, std::size_t const size, std::size_t const alignment)
+	{
+		auto const align = std::align_val_t{std::max(alignment, std::size_t{__STDCPP_DEFAULT_NEW_ALIGNMENT__})};
+		auto * const ret = ::operator new(size, align);
+		auto lock		 = std::scoped_lock{buffer.mutex};
+		buffer.overflow.emplace_back(ret, align);
+		buffer.overflowSize += size;
+		return ret;
+	}
+
+	void FrameArena::reset(Buffer & buffer)
+	{
+		if (!buffer.overflow.empty())
+		{
+			// regrown to the peak of the frame, so the next one fits
+			auto const capacity = std::bit_ceil(buffer.capacity + buffer.overflowSize);
+			freeOverflow(buffer);
+			buffer.memory	= std::make_unique_for_overwrite<std::byte[]>(capacity);
+			buffer.capacity = capacity;
+		}
+		buffer.offset.store(0, std::memory_order_relaxed);
+	}
+
+	void FrameArena::freeOverflow(Buffer & buffer)
+	{
+		for (auto const & [pointer, alignment] : buffer.overflow) { ::operator delete(pointer, alignment); }
+		buffer.overflow.clear();
+		buffer.overflowSize = 0;
+	}
+} // namespace gen
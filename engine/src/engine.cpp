@@ -1,13 +1,171 @@
 // Copyright (c) 2023-present Genesis Engine contributors (see LICENSE.txt)
 
 #include "gen/engine.hpp"
+#include "gen/io/ioStats.hpp"
+#include "gen/io/mappedFile.hpp"
+
+#include <algorithm>
+#include <array>
+#include <cstdlib>
+#include <format>
+#include <string>
+#include <string_view>
+#include <system_error>
+#include <utility>
+#include <vector>
 
 namespace gen
 {
+	namespace
+	{
+		/**
+		 * @brief Returns the shader type of an HLSL file from its name suffix, as the build does, or an empty view for included files.
+		 */
+		std::string_view getShaderType(const fs::path & path)
+		{
+			constexpr auto types = std::array<std::pair<std::string_view, std::string_view>, 7>{{
+				{"VS.hlsl", "vs"},
+				{"PS.hlsl", "ps"},
+				{"CS.hlsl", "cs"},
+				{"GS.hlsl", "gs"},
+				{"DS.hlsl", "ds"},
+				{"HS.hlsl", "hs"},
+				{"LIB.hlsl", "lib"},
+			}};
+			auto const name = path.filename().string();
+			for (auto const & [suffix, type] : types)
+			{
+				if (std::string_view{name}.ends_with(suffix)) { return type; }
+			}
+			return {};
+		}
+
+		DerivedDataCache::KeyBuilder & addFile(DerivedDataCache::KeyBuilder & key, const fs::path & path)
+		{
+			auto file = MappedFile{};
+			return key.add(file.open(path) ? file.getData() : FileView{});
+		}
+	} // namespace
+
 	Engine::Engine(const char * appName, const u32 appVersion, mim::vec2i const & initialSize)
 		: m_window(std::make_unique<Window>(initialSize, appName)), m_renderer(std::make_unique<Renderer>(appName, appVersion))
 	{
+#if defined(GEN_DEBUG) && defined(GEN_SHADER_SOURCE_DIR)
+		if (!m_derivedDataCache.open(GEN_DERIVED_DATA_DIR)) { m_logger.warn("Failed to open the derived data cache in {}", GEN_DERIVED_DATA_DIR); }
+		m_shaderWatch = m_fileWatcher.watch(GEN_SHADER_SOURCE_DIR, [this](std::span<FileWatcher::Change const> changes) { queueShaderChanges(changes); });
+		if (m_shaderWatch == FileWatcher::invalid_watch_v)
+		{
+			m_logger.warn("Failed to watch shaders in {}", GEN_SHADER_SOURCE_DIR);
+		}
+#endif
 		m_logger.info("Engine created");
 	}
 
+	Engine::~Engine()
+	{
+		// no batch is queued once unwatch() returns, the job compiling the last ones uses the cache and the logger
+		if (m_shaderWatch != FileWatcher::invalid_watch_v) { m_fileWatcher.unwatch(m_shaderWatch); }
+		m_jobSystem.wait(m_shaderJob);
+		IoStats::dump(m_logger);
+	}
+
+	void Engine::queueShaderChanges(std::span<FileWatcher::Change const> const changes)
+	{
+		{
+			std::lock_guard<std::mutex> lock(m_shaderMutex);
+			m_shaderChanges.insert(m_shaderChanges.end(), changes.begin(), changes.end());
+			if (std::exchange(m_compilingShaders, true)) { return; }
+		}
+
+		// DXC takes seconds, so it runs on a job rather than holding up the next batch on the watcher thread
+		m_jobSystem.run(
+			[this]
+			{
+				for (auto batch = std::vector<FileWatcher::Change>{};; batch.clear())
+				{
+					{
+						std::lock_guard<std::mutex> lock(m_shaderMutex);
+						if (m_shaderChanges.empty())
+						{
+							m_compilingShaders = false;
+							return;
+						}
+						batch.swap(m_shaderChanges);
+					}
+					recompileShaders(batch);
+				}
+			},
+			&m_shaderJob);
+	}
+
+	void Engine::recompileShaders(std::span<FileWatcher::Change const> const changes)
+	{
+#if defined(GEN_SHADER_SOURCE_DIR)
+		auto shaders = std::vector<fs::path>{};
+		for (auto const & change : changes)
+		{
+			if (change.action == FileWatcher::Action::eRemoved) { continue; }
+			// an included file (or lost changes) may affect any shader
+			if (change.action == FileWatcher::Action::eRescan || getShaderType(change.path).empty())
+			{
+				shaders.clear();
+				auto ec = std::error_code{};
+				for (auto it = fs::recursive_directory_iterator{GEN_SHADER_SOURCE_DIR, ec}; !ec && it != fs::end(it); it.increment(ec))
+				{
+					if (!getShaderType(it->path()).empty()) { shaders.push_back(it->path()); }
+				}
+				break;
+			}
+			shaders.push_back(change.path);
+		}
+		// batches queued while compiling are merged, and may name a shader more than once
+		std::sort(shaders.begin(), shaders.end());
+		shaders.erase(std::unique(shaders.begin(), shaders.end()), shaders.end());
+
+		// included files are not tracked per shader, so all of them are part of every key
+		auto includes = DerivedDataCache::KeyBuilder{}.add(std::string_view{GEN_DXC_EXECUTABLE}).add(std::string_view{GEN_SHADER_MODEL});
+		auto sources  = std::vector<fs::path>{};
+		auto ec		  = std::error_code{};
+		for (auto it = fs::recursive_directory_iterator{GEN_SHADER_SOURCE_DIR, ec}; !ec && it != fs::end(it); it.increment(ec))
+		{
+			if (it->is_regular_file(ec) && getShaderType(it->path()).empty()) { sources.push_back(it->path()); }
+		}
+		std::sort(sources.begin(), sources.end());
+		for (auto const & source : sources) { addFile(includes.add(source.filename().string()), source); }
+
+		for (auto const & shader : shaders)
+		{
+			auto const type	  = getShaderType(shader);
+			auto const output = fs::path{GEN_SHADER_OUTPUT_DIR} / (shader.stem().string() + ".spv");
+			auto const key	  = addFile(DerivedDataCache::KeyBuilder{includes}.add(type), shader).finish();
+			if (auto const spirv = m_derivedDataCache.get(key))
+			{
+				auto file = File{};
+				if (file.open(output, File::out | File::trunc | File::binary) && file.write(spirv->data(), spirv->size(), 0))
+				{
+					m_logger.info("Loaded shader {} from the derived data cache", shader.filename().string());
+					continue;
+				}
+			}
+
+			auto command = std::format(R"("{}" -spirv -T {}_{} -E main "{}" -Fo "{}")", GEN_DXC_EXECUTABLE, type, GEN_SHADER_MODEL, shader.string(),
+									   output.string());
+	#if GEN_PLATFORM_WINDOWS
+			// cmd strips the outer quotes of a command starting with one
+			command = '"' + command + '"';
+	#endif
+			if (std::system(command.c_str()) != 0)
+			{
+				m_logger.error("Failed to recompile shader {}", shader.filename().string());
+				continue;
+			}
+			m_logger.info("Recompiled shader {}", shader.filename().string());
+			auto spirv = MappedFile{};
+			if (spirv.open(output)) { m_derivedDataCache.put(key, spirv.getData()); }
+		}
+#else
+		static_cast<void>(changes);
+#endif
+	}
+
 } // namespace gen
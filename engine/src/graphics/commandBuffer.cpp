@@ -3,6 +3,7 @@
 #include "gen/graphics/commandBuffer.hpp"
 
 #include "gen/graphics/graphicsExceptions.hpp"
+#include "gen/jobs/jobSystem.hpp"
 
 namespace gen
 {
@@ -21,9 +22,32 @@ namespace gen
 		m_commandBuffer.begin({vk::CommandBufferUsageFlagBits::eOneTimeSubmit});
 	}
 
+	bool CommandBuffer::Submission::await_ready() const
+	{
+		return !fence || Device::self().isFenceSignaled(*fence);
+	}
+
+	void CommandBuffer::Submission::await_suspend(std::coroutine_handle<> handle) const
+	{
+		// polled by idle job threads, the one that was waiting moves on to other jobs
+		JobSystem::getInstance().resumeWhen(handle, [fence = *fence] { return Device::self().isFenceSignaled(fence); });
+	}
+
 	void CommandBuffer::submit()
 	{
-		if (!m_commandBuffer) { return; }
+		auto const fence = submitWithFence();
+		if (!fence) { return; }
+		[[maybe_unused]] auto const signaled = Device::self().waitForFence(*fence);
+	}
+
+	CommandBuffer::Submission CommandBuffer::submitAsync()
+	{
+		return Submission{submitWithFence()};
+	}
+
+	vk::UniqueFence CommandBuffer::submitWithFence()
+	{
+		if (!m_commandBuffer) { return {}; }
 
 		m_commandBuffer.end();
 
@@ -33,8 +57,10 @@ namespace gen
 		submitInfoTwo.pCommandBufferInfos	 = &cBufferSubmitInfo;
 		auto & device						 = Device::self();
 		auto fence							 = device.getDevice().createFenceUnique({});
-		device.submit(submitInfoTwo, *fence);
-		device.waitForFence(*fence);
-		m_commandBuffer = vk::CommandBuffer{};
+		auto const submitted				 = device.submit(submitInfoTwo, *fence);
+		m_commandBuffer						 = vk::CommandBuffer{};
+		// an unsubmitted fence never signals, no fence makes waiting on it a no-op
+		if (!submitted) { return {}; }
+		return fence;
 	}
 } // namespace gen
\ No newline at end of file
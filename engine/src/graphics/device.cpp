@@ -179,6 +179,19 @@ namespace gen
 		return getDevice().waitForFences(fence, vk::True, timeout) == vk::Result::eSuccess;
 	}
 
+	bool Device::isFenceSignaled(vk::Fence fence) const
+	{
+		// polled from job threads, which must not throw: a lost device never signals, so report it done
+		try
+		{
+			return getDevice().getFenceStatus(fence) != vk::Result::eNotReady;
+		}
+		catch (vk::SystemError const &)
+		{
+			return true;
+		}
+	}
+
 	bool Device::submit(const vk::SubmitInfo2 & submitInfo, vk::Fence signal) const
 	{
 		auto lock = std::scoped_lock{m_queueMutex};
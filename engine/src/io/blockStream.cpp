@@ -0,0 +1,216 @@
+// Copyright (c) 2023-present Genesis Engine contributors (see LICENSE.txt)
+
+#include "gen/io/blockStream.hpp"
+#include "pakCodec.hpp"
+
+#include <algorithm>
+#include <deque>
+#include <functional>
+#include <thread>
+
+namespace gen
+{
+	namespace
+	{
+		/**
+		 * @brief Worker threads decompressing blocks for every stream.
+		 */
+		class DecodePool
+		{
+		public:
+			static DecodePool & get()
+			{
+				static auto s_pool = DecodePool{std::max(std::thread::hardware_concurrency() / 2, 1u)};
+				return s_pool;
+			}
+
+			void post(std::function<void()> task)
+			{
+				{
+					auto lock = std::scoped_lock{m_mutex};
+					m_tasks.push_back(std::move(task));
+				}
+				m_condition.notify_one();
+			}
+
+		private:
+			explicit DecodePool(u32 const threads)
+			{
+				for (u32 index = 0; index < threads; ++index)
+				{
+					m_threads.emplace_back([this](std::stop_token const & stop) { run(stop); });
+				}
+			}
+
+			void run(std::stop_token const & stop)
+			{
+				while (true)
+				{
+					auto task = std::function<void()>{};
+					{
+						auto lock = std::unique_lock{m_mutex};
+						m_condition.wait(lock, stop, [this] { return !m_tasks.empty(); });
+						if (m_tasks.empty()) { return; }
+						task = std::move(m_tasks.front());
+						m_tasks.pop_front();
+					}
+					task();
+				}
+			}
+
+			std::mutex m_mutex;
+			std::condition_variable_any m_condition;
+			std::deque<std::function<void()>> m_tasks;
+			// destroyed first, joining the threads
+			std::vector<std::jthread> m_threads;
+		};
+	} // namespace
+
+	struct BlockStream::Slot
+	{
+		enum class State
+		{
+			eIdle,
+			eBusy,
+			eReady,
+			eFailed,
+		};
+
+		std::vector<std::byte> stored{}; //!< Compressed data, reused from block to block.
+		std::vector<std::byte> data{};	 //!< Decompressed data, reused from block to block.
+		State state{};
+	};
+
+	BlockStream::BlockStream() = default;
+
+	BlockStream::~BlockStream()
+	{
+		close();
+	}
+
+	bool BlockStream::open(const fs::path & filePath, std::span<Block const> const blocks, u32 const maxInFlight)
+	{
+		close();
+		if (!m_file.open(filePath)) { return false; }
+
+		// raw data can be split anywhere, so large uncompressed blocks still stream with bounded memory
+		m_blocks.reserve(blocks.size());
+		for (auto const & block : blocks)
+		{
+			if (block.compression != pak::Compression::eNone)
+			{
+				m_blocks.push_back(block);
+				continue;
+			}
+			for (u64 offset = 0; offset < block.size || (offset == 0 && block.size == 0); offset += pak::default_block_size_v)
+			{
+				auto const size = std::min<u64>(block.size - offset, pak::default_block_size_v);
+				m_blocks.push_back(Block{block.offset + offset, size, size, pak::Compression::eNone});
+			}
+		}
+		m_slotCount = std::max(maxInFlight, 1u);
+		m_slots		= std::make_unique<Slot[]>(m_slotCount);
+		for (u32 block = 0; block < std::min(m_slotCount, getBlockCount()); ++block) { issue(block); }
+		return true;
+	}
+
+	bool BlockStream::open(PakFile const & pak, PakFile::Entry const & entry, u32 const maxInFlight)
+	{
+		auto const blocks = pak.getBlocks(entry);
+		if (blocks.empty()) { return false; }
+		return open(pak.getPath(), blocks, maxInFlight);
+	}
+
+	void BlockStream::close()
+	{
+		// reads first, they may still queue decodes
+		m_file.wait();
+		{
+			auto lock = std::unique_lock{m_mutex};
+			m_ready.wait(lock, [this] { return m_decoding == 0; });
+		}
+		m_file.close();
+		m_blocks.clear();
+		m_slots.reset();
+		m_slotCount = 0;
+		m_next		= 0;
+		m_failed	= false;
+	}
+
+	std::optional<FileView> BlockStream::next()
+	{
+		// the consumer is done with the previous block, its slot moves on to the next block not in flight yet
+		if (m_next > 0 && m_next - 1 + m_slotCount < getBlockCount() && !hasFailed()) { issue(m_next - 1 + m_slotCount); }
+
+		auto lock = std::unique_lock{m_mutex};
+		if (m_failed || m_next >= getBlockCount()) { return std::nullopt; }
+		auto & slot = slotOf(m_next);
+		m_ready.wait(lock, [&slot] { return slot.state == Slot::State::eReady || slot.state == Slot::State::eFailed; });
+		if (slot.state == Slot::State::eFailed)
+		{
+			m_failed = true;
+			return std::nullopt;
+		}
+		++m_next;
+		return FileView{slot.data};
+	}
+
+	bool BlockStream::hasFailed() const
+	{
+		auto lock = std::scoped_lock{m_mutex};
+		return m_failed;
+	}
+
+	void BlockStream::issue(u32 const block)
+	{
+		auto & slot		   = slotOf(block);
+		auto const & desc  = m_blocks[block];
+		auto const is_raw  = desc.compression == pak::Compression::eNone;
+		auto & destination = is_raw ? slot.data : slot.stored;
+		{
+			auto lock  = std::scoped_lock{m_mutex};
+			slot.state = Slot::State::eBusy;
+		}
+		// raw blocks are read straight into place
+		destination.resize(static_cast<std::size_t>(is_raw ? desc.size : desc.storedSize));
+		m_file.read(destination, desc.offset, [this, block](FileAsync::Result const & result) { complete(block, result); });
+	}
+
+	void BlockStream::complete(u32 const block, FileAsync::Result const & result)
+	{
+		auto & slot		  = slotOf(block);
+		auto const & desc = m_blocks[block];
+		auto const is_raw = desc.compression == pak::Compression::eNone;
+		auto const ok	  = result && result.bytes == (is_raw ? desc.size : desc.storedSize);
+		if (ok && !is_raw)
+		{
+			{
+				auto lock = std::scoped_lock{m_mutex};
+				++m_decoding;
+			}
+			DecodePool::get().post([this, block] { decode(block); });
+			return;
+		}
+		auto lock  = std::scoped_lock{m_mutex};
+		slot.state = ok ? Slot::State::eReady : Slot::State::eFailed;
+		m_ready.notify_all();
+	}
+
+	void BlockStream::decode(u32 const block)
+	{
+		auto & slot		  = slotOf(block);
+		auto const & desc = m_blocks[block];
+		slot.data.resize(static_cast<std::size_t>(desc.size));
+		auto const ok = io::decompress(desc.compression, slot.stored, slot.data);
+		// notify under the lock: once m_decoding drops to 0, close() may destroy the stream
+		auto lock  = std::scoped_lock{m_mutex};
+		slot.state = ok ? Slot::State::eReady : Slot::State::eFailed;
+		--m_decoding;
+		m_ready.notify_all();
+	}
+
+	BlockStream::Slot & BlockStream::slotOf(u32 const block) const
+	{
+		return m_slots[block % m_slotCount];
+	}
+} // namespace gen
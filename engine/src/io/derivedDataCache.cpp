@@ -0,0 +1,328 @@
+// Copyright (c) 2023-present Genesis Engine contributors (see LICENSE.txt)
+
+#include "gen/io/derivedDataCache.hpp"
+#include "nativeFile.hpp"
+
+#include <algorithm>
+#include <atomic>
+#include <bit>
+#include <charconv>
+#include <chrono>
+#include <cstring>
+#include <format>
+#include <random>
+#include <system_error>
+#include <tuple>
+
+namespace gen
+{
+	namespace
+	{
+		constexpr u64 c1_v{0x87c37b91114253d5};
+		constexpr u64 c2_v{0x4cf5ad432745937f};
+
+		// temporary files older than this were left by a crashed writer
+		constexpr auto stale_temporary_v = std::chrono::hours{1};
+
+		constexpr u64 fmix(u64 k)
+		{
+			k ^= k >> 33;
+			k *= 0xff51afd7ed558ccd;
+			k ^= k >> 33;
+			k *= 0xc4ceb9fe1a85ec53;
+			k ^= k >> 33;
+			return k;
+		}
+
+		u64 load(std::byte const * data)
+		{
+			auto ret = u64{};
+			std::memcpy(&ret, data, sizeof(ret));
+			return ret;
+		}
+
+		/**
+		 * @brief Returns a file name no other writer uses, in this process or another one.
+		 */
+		std::string getTemporaryName(DerivedDataCache::Key const & key)
+		{
+			static auto const s_process = std::random_device{}();
+			static auto s_counter		= std::atomic<u32>{};
+			return std::format("{}.{:08x}{:08x}.tmp", key.toString(), s_process, s_counter.fetch_add(1, std::memory_order_relaxed));
+		}
+
+		bool writeFile(const fs::path & path, std::span<std::byte const> const data)
+		{
+			auto const handle = native::open(path, native::OpenFlags{.write = true, .create = true, .truncate = true});
+			if (handle == native::invalid_handle_v) { return false; }
+			// synced before the rename, or a crash could leave a renamed but empty artifact
+			auto const ok = native::writeAt(handle, data.data(), data.size(), 0) == static_cast<i64>(data.size()) && native::sync(handle);
+			native::close(handle);
+			return ok;
+		}
+
+		std::optional<std::vector<std::byte>> readFile(const fs::path & path)
+		{
+			auto const handle = native::open(path, native::OpenFlags{.read = true});
+			if (handle == native::invalid_handle_v) { return std::nullopt; }
+			auto ret		= std::optional<std::vector<std::byte>>{};
+			auto const size = native::size(handle);
+			if (size >= 0)
+			{
+				auto data = std::vector<std::byte>(static_cast<std::size_t>(size));
+				if (native::readAt(handle, data.data(), data.size(), 0) == size) { ret = std::move(data); }
+			}
+			native::close(handle);
+			return ret;
+		}
+	} // namespace
+
+	std::string DerivedDataCache::Key::toString() const
+	{
+		return std::format("{:016x}{:016x}", high, low);
+	}
+
+	std::optional<DerivedDataCache::Key> DerivedDataCache::Key::fromString(std::string_view const text)
+	{
+		if (text.size() != 32) { return std::nullopt; }
+		auto ret		 = Key{};
+		auto const parse = [](std::string_view const digits, u64 & value)
+		{
+			auto const [end, ec] = std::from_chars(digits.data(), digits.data() + digits.size(), value, 16);
+			return ec == std::errc{} && end == digits.data() + digits.size();
+		};
+		if (!parse(text.substr(0, 16), ret.high) || !parse(text.substr(16), ret.low)) { return std::nullopt; }
+		return ret;
+	}
+
+	DerivedDataCache::KeyBuilder & DerivedDataCache::KeyBuilder::add(std::span<std::byte const> const data)
+	{
+		add(static_cast<u64>(data.size()));
+		update(data);
+		return *this;
+	}
+
+	DerivedDataCache::Key DerivedDataCache::KeyBuilder::finish() const
+	{
+		auto h1	  = m_h1;
+		auto h2	  = m_h2;
+		auto tail = std::array<std::byte, 16>{};
+		std::copy_n(m_tail.begin(), m_tailSize, tail.begin());
+		if (m_tailSize > 8) { h2 ^= std::rotl(load(tail.data() + 8) * c2_v, 33) * c1_v; }
+		if (m_tailSize > 0) { h1 ^= std::rotl(load(tail.data()) * c1_v, 31) * c2_v; }
+
+		h1 ^= m_length;
+		h2 ^= m_length;
+		h1 += h2;
+		h2 += h1;
+		h1 = fmix(h1);
+		h2 = fmix(h2);
+		h1 += h2;
+		h2 += h1;
+		return Key{h1, h2};
+	}
+
+	void DerivedDataCache::KeyBuilder::update(std::span<std::byte const> data)
+	{
+		m_length += data.size();
+		if (m_tailSize > 0)
+		{
+			auto const count = std::min(m_tail.size() - m_tailSize, data.size());
+			std::copy_n(data.begin(), count, m_tail.begin() + static_cast<std::ptrdiff_t>(m_tailSize));
+			m_tailSize += count;
+			data = data.subspan(count);
+			if (m_tailSize < m_tail.size()) { return; }
+			mix(load(m_tail.data()), load(m_tail.data() + 8));
+			m_tailSize = 0;
+		}
+		while (data.size() >= 16)
+		{
+			mix(load(data.data()), load(data.data() + 8));
+			data = data.subspan(16);
+		}
+		std::copy(data.begin(), data.end(), m_tail.begin());
+		m_tailSize = data.size();
+	}
+
+	void DerivedDataCache::KeyBuilder::mix(u64 k1, u64 k2)
+	{
+		k1 = std::rotl(k1 * c1_v, 31) * c2_v;
+		m_h1 ^= k1;
+		m_h1 = (std::rotl(m_h1, 27) + m_h2) * 5 + 0x52dce729;
+
+		k2 = std::rotl(k2 * c2_v, 33) * c1_v;
+		m_h2 ^= k2;
+		m_h2 = (std::rotl(m_h2, 31) + m_h1) * 5 + 0x38495ab5;
+	}
+
+	bool DerivedDataCache::open(const fs::path & directory, u64 const capacity)
+	{
+		close();
+		auto ec = std::error_code{};
+		fs::create_directories(directory / "tmp", ec);
+		if (ec) { return false; }
+
+		// artifacts live in <directory>/<first 2 hex digits>/<other 30>, index them from least to most recently used
+		auto found = std::vector<std::tuple<fs::file_time_type, Key, u64>>{};
+		for (auto it = fs::recursive_directory_iterator{directory, fs::directory_options::skip_permission_denied, ec}; !ec && it != fs::end(it);
+			 it.increment(ec))
+		{
+			auto const & path = it->path();
+			auto entryEc	  = std::error_code{};
+			if (it.depth() != 1 || !it->is_regular_file(entryEc)) { continue; }
+			if (path.parent_path().filename() == "tmp")
+			{
+				if (fs::file_time_type::clock::now() - it->last_write_time(entryEc) > stale_temporary_v) { fs::remove(path, entryEc); }
+				continue;
+			}
+			auto const key = Key::fromString(path.parent_path().filename().string() + path.filename().string());
+			if (!key) { continue; }
+			auto const time = it->last_write_time(entryEc);
+			auto const size = it->file_size(entryEc);
+			if (!entryEc) { found.emplace_back(time, *key, size); }
+		}
+		if (ec) { return false; }
+		std::sort(found.begin(), found.end(), [](auto const & lhs, auto const & rhs) { return std::get<0>(lhs) < std::get<0>(rhs); });
+
+		auto lock	= std::scoped_lock{m_mutex};
+		m_directory = directory;
+		m_capacity	= capacity;
+		for (auto const & [time, key, size] : found) { touch(key, size); }
+		evict();
+		return true;
+	}
+
+	void DerivedDataCache::close()
+	{
+		auto lock = std::scoped_lock{m_mutex};
+		m_directory.clear();
+		m_uses.clear();
+		m_items.clear();
+		m_size = 0;
+	}
+
+	bool DerivedDataCache::isValid() const
+	{
+		auto lock = std::scoped_lock{m_mutex};
+		return !m_directory.empty();
+	}
+
+	std::optional<std::vector<std::byte>> DerivedDataCache::get(Key const & key)
+	{
+		auto path = fs::path{};
+		{
+			auto lock = std::scoped_lock{m_mutex};
+			if (m_directory.empty()) { return std::nullopt; }
+			path = getPath(key);
+		}
+		auto ret = readFile(path);
+
+		auto lock = std::scoped_lock{m_mutex};
+		if (!ret)
+		{
+			// evicted, maybe by another process
+			forget(key);
+			return std::nullopt;
+		}
+		if (m_directory.empty()) { return ret; }
+		touch(key, ret->size());
+		auto ec = std::error_code{};
+		fs::last_write_time(path, fs::file_time_type::clock::now(), ec);
+		return ret;
+	}
+
+	bool DerivedDataCache::put(Key const & key, std::span<std::byte const> const data)
+	{
+		auto path	   = fs::path{};
+		auto temporary = fs::path{};
+		{
+			auto lock = std::scoped_lock{m_mutex};
+			if (m_directory.empty() || data.size() > m_capacity) { return false; }
+			path	  = getPath(key);
+			temporary = m_directory / "tmp" / getTemporaryName(key);
+		}
+		auto ec = std::error_code{};
+		fs::create_directories(path.parent_path(), ec);
+		if (ec || !writeFile(temporary, data))
+		{
+			fs::remove(temporary, ec);
+			return false;
+		}
+		// atomically replaces any previous artifact, readers never see a partial one
+		fs::rename(temporary, path, ec);
+		if (ec)
+		{
+			fs::remove(temporary, ec);
+			return false;
+		}
+
+		auto lock = std::scoped_lock{m_mutex};
+		if (m_directory.empty()) { return true; }
+		touch(key, data.size());
+		evict();
+		return true;
+	}
+
+	void DerivedDataCache::remove(Key const & key)
+	{
+		auto lock = std::scoped_lock{m_mutex};
+		if (m_directory.empty()) { return; }
+		forget(key);
+		auto ec = std::error_code{};
+		fs::remove(getPath(key), ec);
+	}
+
+	u64 DerivedDataCache::getSize() const
+	{
+		auto lock = std::scoped_lock{m_mutex};
+		return m_size;
+	}
+
+	u64 DerivedDataCache::getCapacity() const
+	{
+		auto lock = std::scoped_lock{m_mutex};
+		return m_capacity;
+	}
+
+	fs::path DerivedDataCache::getPath(Key const & key) const
+	{
+		auto const name = key.toString();
+		return m_directory / name.substr(0, 2) / name.substr(2);
+	}
+
+	void DerivedDataCache::touch(Key const & key, u64 const size)
+	{
+		auto const [it, inserted] = m_items.try_emplace(key);
+		if (inserted) { it->second.use = m_uses.insert(m_uses.begin(), key); }
+		else
+		{
+			m_size -= it->second.size;
+			m_uses.splice(m_uses.begin(), m_uses, it->second.use);
+		}
+		it->second.size = size;
+		m_size += size;
+	}
+
+	void DerivedDataCache::forget(Key const & key)
+	{
+		auto const it = m_items.find(key);
+		if (it == m_items.end()) { return; }
+		m_size -= it->second.size;
+		m_uses.erase(it->second.use);
+		m_items.erase(it);
+	}
+
+	void DerivedDataCache::evict()
+	{
+		auto ec = std::error_code{};
+		while (m_size > m_capacity && !m_uses.empty())
+		{
+			auto const key = m_uses.back();
+			auto const it  = m_items.find(key);
+			fs::remove(getPath(key), ec);
+			m_size -= it->second.size;
+			m_items.erase(it);
+			m_uses.pop_back();
+		}
+	}
+} // namespace gen
@@ -1,37 +1,57 @@
 // Copyright (c) 2023-present Genesis Engine contributors (see LICENSE.txt)
 
 #include "gen/io/file.hpp"
+#include "nativeFile.hpp"
+#include <algorithm>
 #include <chrono>
-#include <stdexcept>
+#include <system_error>
 
 namespace gen
 {
 
-	bool File::open(const fs::path & filePath)
+	File::~File()
+	{
+		close();
+	}
+
+	bool File::open(const fs::path & filePath, int const mode)
 	{
 		std::lock_guard<std::mutex> lock(m_mutex); // Lock the mutex to ensure thread safety
 
-		m_filePath = filePath;
+		native::close(m_handle);
+		m_handle   = native::open(filePath, native::toOpenFlags(mode));
+		m_mode	   = mode;
+		m_filePath = (mode & temporary) != 0 ? fs::path{} : filePath;
+		m_position = 0;
+		if (m_handle == native::invalid_handle_v) { return false; }
 
-		std::ofstream createFile(filePath);
-		if (!createFile.is_open()) { return false; }
+		if ((mode & ate) != 0) { m_position = static_cast<u64>(std::max(native::size(m_handle), i64{0})); }
+		return true;
+	}
 
-		m_file.open(filePath, std::ios::in | std::ios::out | std::ios::binary);
+	void File::close()
+	{
+		std::lock_guard<std::mutex> lock(m_mutex);
 
-		return m_file.is_open();
+		native::close(m_handle);
+		m_handle = native::invalid_handle_v;
+		m_filePath.clear();
+		m_position = 0;
 	}
 
 	bool File::read(void * data, const std::size_t dataSize, u64 & /* [out] */ bytesRead)
 	{
 		std::lock_guard<std::mutex> lock(m_mutex);
 
-		if (m_file.is_open() && data != nullptr && dataSize > 0)
+		if (m_handle != native::invalid_handle_v && data != nullptr && dataSize > 0)
 		{
-			m_file.read(static_cast<char *>(data), static_cast<std::streamsize>(dataSize));
-			const std::streamsize readSize = m_file.gcount();
+			auto const start   = IoStats::Clock::now();
+			const i64 readSize = native::readAt(m_handle, data, dataSize, m_position);
+			m_stats->record(IoStats::Op::eRead, readSize > 0 ? static_cast<u64>(readSize) : 0, IoStats::Clock::now() - start);
 			if (readSize > 0)
 			{
-				bytesRead = static_cast<std::uint32_t>(readSize);
+				m_position += static_cast<u64>(readSize);
+				bytesRead = static_cast<u64>(readSize);
 				return true;
 			}
 		}
@@ -41,98 +61,95 @@ namespace gen
 
 	bool File::read(const void * data, const std::size_t dataSize, u64 & bytesRead)
 	{
-		std::lock_guard<std::mutex> lock(m_mutex);
-
-		if (m_file.is_open() && data != nullptr && dataSize > 0)
-		{
-			m_file.read(reinterpret_cast<char *>(const_cast<void *>(data)), static_cast<std::streamsize>(dataSize));
-			const std::streamsize readSize = m_file.gcount();
-			if (readSize > 0)
-			{
-				bytesRead = static_cast<std::uint32_t>(readSize);
-				return true;
-			}
-		}
-		bytesRead = -1;
-		return false;
+		return read(const_cast<void *>(data), dataSize, bytesRead);
 	}
 
 	bool File::write(const void * data, const std::size_t dataSize, const std::streampos position, const std::ios_base::openmode mode, const bool flush)
 	{
 		std::lock_guard<std::mutex> lock(m_mutex); // Lock the mutex to ensure thread safety
 
-		if (m_file.is_open())
-		{
-			if (position != -1)
-			{
-				// Seek to the specified position in the file
-				m_file.seekp(position);
-			}
+		if (m_handle == native::invalid_handle_v) { return false; }
 
-			// Write the data to the file
-			m_file.write(static_cast<const char *>(data), static_cast<std::streamsize>(dataSize));
+		auto const append = (m_mode & app) != 0;
+		if (append && position != -1) { return false; }
 
-			if (flush) { m_file.flush(); }
+		u64 offset = m_position;
+		if (position != -1) { offset = static_cast<u64>(static_cast<std::streamoff>(position)); }
+		// the end is read under the mutex, so concurrent appends through this File never overlap
+		else if (append || (mode & std::ios::app) != 0) { offset = static_cast<u64>(std::max(native::size(m_handle), i64{0})); }
 
-			return true;
+		auto start		  = IoStats::Clock::now();
+		const i64 written = native::writeAt(m_handle, data, dataSize, offset);
+		m_stats->record(IoStats::Op::eWrite, written > 0 ? static_cast<u64>(written) : 0, IoStats::Clock::now() - start);
+		if (written < 0) { return false; }
+		m_position = offset + static_cast<u64>(written);
+
+		if (flush)
+		{
+			start		  = IoStats::Clock::now();
+			auto const ok = native::sync(m_handle);
+			m_stats->record(IoStats::Op::eSync, 0, IoStats::Clock::now() - start);
+			if (!ok) { return false; }
 		}
 
-		return false;
+		return static_cast<std::size_t>(written) == dataSize;
+	}
+
+	i64 File::readAt(const u64 offset, const std::span<std::byte> buffer) const
+	{
+		if (m_handle == native::invalid_handle_v) { return -1; }
+		auto const start = IoStats::Clock::now();
+		const i64 result = native::readAt(m_handle, buffer.data(), buffer.size(), offset);
+		m_stats->record(IoStats::Op::eRead, result > 0 ? static_cast<u64>(result) : 0, IoStats::Clock::now() - start);
+		return result < 0 ? -1 : result;
+	}
+
+	i64 File::writeAt(const u64 offset, const std::span<std::byte const> buffer) const
+	{
+		if (m_handle == native::invalid_handle_v || (m_mode & app) != 0) { return -1; }
+		auto const start = IoStats::Clock::now();
+		const i64 result = native::writeAt(m_handle, buffer.data(), buffer.size(), offset);
+		m_stats->record(IoStats::Op::eWrite, result > 0 ? static_cast<u64>(result) : 0, IoStats::Clock::now() - start);
+		return result < 0 ? -1 : result;
 	}
 
 	i64 File::seek(const i64 position)
 	{
 		std::lock_guard<std::mutex> lock(m_mutex);
 
-		if (m_file.is_open())
-		{
-			m_file.seekg(position, std::ios::beg);
-			m_file.seekp(position, std::ios::beg);
+		if (m_handle == native::invalid_handle_v || position < 0) { return -1; }
 
-			if (m_file.fail()) { return -1; }
-
-			return tell();
-		}
-		else { return -1; }
+		m_position = static_cast<u64>(position);
+		return position;
 	}
 
 	i64 File::tell()
 	{
 		std::lock_guard<std::mutex> lock(m_mutex); // Lock the mutex to ensure thread safety
 
-		if (m_file.is_open()) { return static_cast<i64>(m_file.tellg()); }
+		if (m_handle != native::invalid_handle_v) { return static_cast<i64>(m_position); }
 		else { return -1; }
 	}
 
 	bool File::isValid() const
 	{
-		return m_file.is_open();
+		return m_handle != native::invalid_handle_v;
 	}
 
 	i64 File::getFileSize()
 	{
-		std::lock_guard<std::mutex> lock(m_mutex); // Lock the mutex to ensure thread safety
-
-		if (m_file.is_open())
-		{
-			m_file.seekg(0, std::ios::end);
-			const std::streampos fileSize = m_file.tellg();
-
-			if (fileSize != -1) { return static_cast<i64>(fileSize); }
-		}
-
-		return -1; // Return -1 if the file is not valid or if there was an error getting the file size
+		return native::size(m_handle); // -1 if the file is not valid or if there was an error getting the file size
 	}
 
 	i64 File::getFileTimeStamp()
 	{
 		std::lock_guard<std::mutex> lock(m_mutex); // Lock the mutex to ensure thread safety
 
-		if (m_file.is_open())
+		if (m_handle != native::invalid_handle_v && !m_filePath.empty())
 		{
-			const std::filesystem::path filePath				= m_filePath;
-			const std::filesystem::file_time_type lastWriteTime = std::filesystem::last_write_time(filePath);
-			return std::chrono::duration_cast<std::chrono::seconds>(lastWriteTime.time_since_epoch()).count();
+			std::error_code error;
+			const std::filesystem::file_time_type lastWriteTime = std::filesystem::last_write_time(m_filePath, error);
+			if (!error) { return std::chrono::duration_cast<std::chrono::seconds>(lastWriteTime.time_since_epoch()).count(); }
 		}
 
 		return -1; // Return -1 if the file is not valid or if there was an error getting the file timestamp
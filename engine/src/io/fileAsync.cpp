@@ -1,8 +1,174 @@
 // Copyright (c) 2023-present Genesis Engine contributors (see LICENSE.txt)
 
 #include "gen/io/fileAsync.hpp"
+#include "ioQueue.hpp"
+#include "nativeFile.hpp"
+
+#include <cerrno>
+#include <type_traits>
+#include <vector>
 
 namespace gen
 {
+	namespace
+	{
+		template <typename Byte>
+		std::unique_ptr<io::IoRequest> make_request(native::Handle const handle, std::shared_ptr<FileAsync::State> const & state, FileAsync::Request<Byte> & request)
+		{
+			auto ret = std::make_unique<io::IoRequest>();
+			ret->op	 = std::is_const_v<Byte> ? io::IoRequest::Op::eWrite : io::IoRequest::Op::eRead;
+			ret->handle = handle;
+			// writes never write through data, the queue just has a single pointer type
+			// NOLINTNEXTLINE
+			ret->data	  = const_cast<std::byte *>(request.buffer.data());
+			ret->size	  = request.buffer.size();
+			ret->offset	  = request.offset;
+			ret->callback = std::move(request.callback);
+			ret->state	  = state;
+			ret->start	  = IoStats::Clock::now();
+			return ret;
+		}
+
+		template <typename Byte>
+		void fail(std::span<FileAsync::Request<Byte>> const requests, int const error)
+		{
+			for (auto & request : requests)
+			{
+				if (request.callback) { request.callback(FileAsync::Result{.error = error}); }
+			}
+		}
+
+		template <typename Byte>
+		void submit(native::Handle const handle, std::shared_ptr<FileAsync::State> const & state, std::span<FileAsync::Request<Byte>> const requests)
+		{
+			if (requests.empty()) { return; }
+			if (handle == native::invalid_handle_v)
+			{
+				fail(requests, EBADF);
+				return;
+			}
+
+			auto batch = std::vector<std::unique_ptr<io::IoRequest>>{};
+			batch.reserve(requests.size());
+			for (auto & request : requests) { batch.push_back(make_request(handle, state, request)); }
+			state->pending.fetch_add(static_cast<u32>(batch.size()), std::memory_order_relaxed);
+			io::IoQueue::get().submit(batch);
+		}
+
+		template <typename Byte>
+		std::future<FileAsync::Result> submit_one(native::Handle const handle, std::shared_ptr<FileAsync::State> const & state, std::span<Byte> const buffer, u64 const offset)
+		{
+			// std::function must be copyable, hence the shared promise
+			auto promise = std::make_shared<std::promise<FileAsync::Result>>();
+			auto ret	 = promise->get_future();
+			auto request = FileAsync::Request<Byte>{buffer, offset, [promise](FileAsync::Result const & result) { promise->set_value(result); }};
+			submit(handle, state, std::span{&request, 1});
+			return ret;
+		}
+	} // namespace
+
+	FileAsync::FileAsync() : FileAsync(IoStats::default_category_v)
+	{
+	}
+
+	FileAsync::FileAsync(std::string_view const category) : m_state(std::make_shared<State>())
+	{
+		m_state->stats = &IoStats::get(category);
+	}
+
+	FileAsync::~FileAsync()
+	{
+		close();
+	}
+
+	bool FileAsync::open(const fs::path & filePath, int const mode)
+	{
+		close();
+		m_filePath = filePath;
+		m_append   = (mode & File::app) != 0;
+
+		m_handle = native::open(filePath, native::toOpenFlags(mode));
+		return isValid();
+	}
+
+	void FileAsync::close()
+	{
+		if (!isValid()) { return; }
+		wait();
+		native::close(m_handle);
+		m_handle = native::invalid_handle_v;
+	}
+
+	bool FileAsync::isValid() const
+	{
+		return m_handle != native::invalid_handle_v;
+	}
+
+	i64 FileAsync::getFileSize() const
+	{
+		return native::size(m_handle);
+	}
+
+	void FileAsync::read(std::span<std::byte> const buffer, u64 const offset, Callback callback)
+	{
+		auto request = ReadRequest{buffer, offset, std::move(callback)};
+		read(std::span{&request, 1});
+	}
+
+	std::future<FileAsync::Result> FileAsync::read(std::span<std::byte> const buffer, u64 const offset)
+	{
+		return submit_one(m_handle, m_state, buffer, offset);
+	}
+
+	void FileAsync::read(std::span<ReadRequest> const requests)
+	{
+		submit(m_handle, m_state, requests);
+	}
+
+	void FileAsync::write(std::span<std::byte const> const buffer, u64 const offset, Callback callback)
+	{
+		auto request = WriteRequest{buffer, offset, std::move(callback)};
+		write(std::span{&request, 1});
+	}
+
+	std::future<FileAsync::Result> FileAsync::write(std::span<std::byte const> const buffer, u64 const offset)
+	{
+		if (m_append)
+		{
+			auto promise = std::promise<Result>{};
+			promise.set_value(Result{.error = EINVAL});
+			return promise.get_future();
+		}
+		return submit_one(m_handle, m_state, buffer, offset);
+	}
+
+	void FileAsync::write(std::span<WriteRequest> const requests)
+	{
+		// every write here is positional, see File::app
+		if (m_append)
+		{
+			fail(requests, EINVAL);
+			return;
+		}
+		submit(m_handle, m_state, requests);
+	}
+
+	void FileAsync::wait() const
+	{
+		for (auto pending = m_state->pending.load(std::memory_order_acquire); pending > 0; pending = m_state->pending.load(std::memory_order_acquire))
+		{
+			m_state->pending.wait(pending, std::memory_order_acquire);
+		}
+	}
+
+	u32 FileAsync::getPending() const
+	{
+		return m_state->pending.load(std::memory_order_relaxed);
+	}
+
+	FileAsync::Backend FileAsync::getBackend()
+	{
+		return io::IoQueue::get().getBackend();
+	}
 
 } // namespace gen
@@ -1,7 +1,33 @@
 // Copyright (c) 2023-present Genesis Engine contributors (see LICENSE.txt)
 
 #include "gen/io/fileHelper.hpp"
+#include "nativeFile.hpp"
+
+#include <cstdint>
 
 namespace gen
 {
+	std::optional<std::span<std::byte>> fileHelper::readAll(const fs::path & filePath, std::pmr::memory_resource & arena, std::size_t const alignment)
+	{
+		auto const handle = native::open(filePath, native::OpenFlags{.read = true});
+		if (handle == native::invalid_handle_v) { return std::nullopt; }
+
+		auto ret		= std::optional<std::span<std::byte>>{};
+		auto const size = native::size(handle);
+		if (size == 0) { ret.emplace(); }
+		else if (size > 0)
+		{
+			auto * const data = static_cast<std::byte *>(arena.allocate(static_cast<std::size_t>(size), alignment));
+			if (native::readAt(handle, data, static_cast<std::size_t>(size), 0) == size) { ret.emplace(data, static_cast<std::size_t>(size)); }
+			else { arena.deallocate(data, static_cast<std::size_t>(size), alignment); }
+		}
+		native::close(handle);
+		return ret;
+	}
+
+	std::span<u32 const> fileHelper::asSpirv(std::span<std::byte const> const data)
+	{
+		if (data.size() % sizeof(u32) != 0 || reinterpret_cast<std::uintptr_t>(data.data()) % alignof(u32) != 0) { return {}; }
+		return {reinterpret_cast<u32 const *>(data.data()), data.size() / sizeof(u32)}; // NOLINT(cppcoreguidelines-pro-type-reinterpret-cast)
+	}
 } // namespace gen
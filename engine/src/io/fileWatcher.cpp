@@ -0,0 +1,168 @@
+// Copyright (c) 2023-present Genesis Engine contributors (see LICENSE.txt)
+
+#include "gen/io/fileWatcher.hpp"
+#include "watchBackend.hpp"
+
+#include <algorithm>
+#include <optional>
+#include <system_error>
+
+namespace gen
+{
+	namespace
+	{
+		using Action = FileWatcher::Action;
+
+		/**
+		 * @brief Merges a change into the pending change to the same path.
+		 * @return The resulting change, `std::nullopt` if the changes cancel out (a file created and deleted within a batch).
+		 */
+		std::optional<Action> coalesce(Action const previous, Action const next)
+		{
+			if (previous == Action::eRescan || next == Action::eRescan) { return Action::eRescan; }
+			switch (previous)
+			{
+			case Action::eAdded: return next == Action::eRemoved ? std::nullopt : std::optional{Action::eAdded};
+			case Action::eModified: return next == Action::eRemoved ? Action::eRemoved : Action::eModified;
+			case Action::eRemoved: return next == Action::eRemoved ? Action::eRemoved : Action::eModified;
+			default: return next;
+			}
+		}
+	} // namespace
+
+	namespace io
+	{
+		bool isUnder(const fs::path & path, const fs::path & directory)
+		{
+			auto const [it, _] = std::mismatch(directory.begin(), directory.end(), path.begin(), path.end());
+			return it == directory.end() && std::distance(path.begin(), path.end()) > std::distance(directory.begin(), directory.end());
+		}
+	} // namespace io
+
+	FileWatcher::FileWatcher(std::chrono::milliseconds const latency, Backend const backend) : m_latency(latency)
+	{
+		if (backend == Backend::eInotify) { m_backend = io::makeInotifyBackend(); }
+		if (!m_backend) { m_backend = io::makePollingBackend(poll_interval_v); }
+	}
+
+	FileWatcher::~FileWatcher()
+	{
+		if (m_thread.joinable())
+		{
+			m_thread.request_stop();
+			m_backend->wake();
+			m_thread.join();
+		}
+	}
+
+	FileWatcher::WatchId FileWatcher::watch(const fs::path & path, Callback callback, bool recursive)
+	{
+		auto ec		= std::error_code{};
+		auto target = fs::weakly_canonical(fs::absolute(path, ec), ec);
+		if (ec) { return invalid_watch_v; }
+
+		auto watch = Watch{.callback = std::move(callback)};
+		if (fs::is_directory(target, ec))
+		{
+			watch.directory = std::move(target);
+			watch.recursive = recursive;
+		}
+		else
+		{
+			watch.directory = target.parent_path();
+			watch.file		= target.filename();
+		}
+		if (!m_backend->add(watch.directory, watch.recursive)) { return invalid_watch_v; }
+
+		auto lock = std::scoped_lock{m_mutex};
+		watch.id  = m_nextId++;
+		m_watches.push_back(std::move(watch));
+		if (!m_thread.joinable())
+		{
+			m_thread = std::jthread{[this](std::stop_token const & stop) { run(stop); }};
+		}
+		return m_watches.back().id;
+	}
+
+	void FileWatcher::unwatch(WatchId const id)
+	{
+		{
+			auto lock = std::scoped_lock{m_mutex};
+			auto it	  = std::find_if(m_watches.begin(), m_watches.end(), [id](Watch const & watch) { return watch.id == id; });
+			if (it == m_watches.end()) { return; }
+			m_backend->remove(it->directory, it->recursive);
+			m_watches.erase(it);
+		}
+		// wait out a batch being delivered, unless this is its callback
+		if (std::this_thread::get_id() != m_thread.get_id()) { auto lock = std::scoped_lock{m_deliverMutex}; }
+	}
+
+	FileWatcher::Backend FileWatcher::getBackend() const
+	{
+		return m_backend->getBackend();
+	}
+
+	void FileWatcher::run(std::stop_token const & stop)
+	{
+		auto const sink = [this](const fs::path & path, Action const action) { record(path, action); };
+		while (!stop.stop_requested())
+		{
+			auto timeout = std::optional<std::chrono::milliseconds>{};
+			if (!m_pending.empty())
+			{
+				auto const remaining = std::chrono::ceil<std::chrono::milliseconds>(getDueTime() - Clock::now());
+				timeout				 = std::max(remaining, std::chrono::milliseconds{0});
+			}
+			m_backend->wait(timeout, sink);
+			if (!m_pending.empty() && Clock::now() >= getDueTime()) { deliver(); }
+		}
+	}
+
+	void FileWatcher::record(const fs::path & path, Action const action)
+	{
+		auto const now = Clock::now();
+		if (m_pending.empty()) { m_first = now; }
+		m_last = now;
+
+		auto const [it, inserted] = m_pending.try_emplace(path, action);
+		if (inserted) { return; }
+		if (auto const merged = coalesce(it->second, action)) { it->second = *merged; }
+		else { m_pending.erase(it); }
+	}
+
+	void FileWatcher::deliver()
+	{
+		auto changes = std::vector<Change>{};
+		changes.reserve(m_pending.size());
+		for (auto & [path, action] : m_pending) { changes.push_back(Change{path, action}); }
+		m_pending.clear();
+
+		auto deliverLock = std::scoped_lock{m_deliverMutex};
+		auto watches	 = std::vector<Watch>{};
+		{
+			// callbacks run unlocked, so they may watch and unwatch
+			auto lock = std::scoped_lock{m_mutex};
+			watches	  = m_watches;
+		}
+
+		auto batch = std::vector<Change>{};
+		for (auto const & watch : watches)
+		{
+			auto const matches = [&watch](Change const & change)
+			{
+				// a rescan of the directory or of one of its parents covers the whole watch
+				if (change.action == Action::eRescan && (change.path == watch.directory || io::isUnder(watch.directory, change.path))) { return true; }
+				if (!watch.file.empty()) { return change.path.parent_path() == watch.directory && change.path.filename() == watch.file; }
+				return watch.recursive ? io::isUnder(change.path, watch.directory) : change.path.parent_path() == watch.directory;
+			};
+			batch.clear();
+			std::copy_if(changes.begin(), changes.end(), std::back_inserter(batch), matches);
+			if (!batch.empty()) { watch.callback(batch); }
+		}
+	}
+
+	FileWatcher::Clock::time_point FileWatcher::getDueTime() const
+	{
+		return std::min(m_last + m_latency, m_first + m_latency * max_delay_factor_v);
+	}
+} // namespace gen
@@ -0,0 +1,216 @@
+// Copyright (c) 2023-present Genesis Engine contributors (see LICENSE.txt)
+
+#include "watchBackend.hpp"
+
+#if GEN_PLATFORM_LINUX
+	#include <poll.h>
+	#include <sys/eventfd.h>
+	#include <sys/inotify.h>
+	#include <unistd.h>
+
+	#include <algorithm>
+	#include <array>
+	#include <map>
+	#include <mutex>
+	#include <system_error>
+	#include <unordered_map>
+	#include <vector>
+#endif
+
+namespace gen::io
+{
+#if GEN_PLATFORM_LINUX
+	namespace
+	{
+		// writes are reported once the writer closes the file, not for every write() while it is half written
+		constexpr u32 watch_mask_v{IN_CREATE | IN_CLOSE_WRITE | IN_DELETE | IN_MOVED_FROM | IN_MOVED_TO | IN_MOVE_SELF | IN_ONLYDIR | IN_EXCL_UNLINK};
+
+		class InotifyBackend final : public WatchBackend
+		{
+		public:
+			InotifyBackend(int const fd, int const wakeFd) : m_fd(fd), m_wakeFd(wakeFd) {}
+
+			~InotifyBackend() override
+			{
+				::close(m_wakeFd);
+				::close(m_fd);
+			}
+
+			InotifyBackend(const InotifyBackend &)			   = delete;
+			InotifyBackend & operator=(const InotifyBackend &) = delete;
+
+			bool add(const fs::path & directory, bool const recursive) override
+			{
+				auto lock = std::scoped_lock{m_mutex};
+				if (!addDirectory(directory)) { return false; }
+				m_roots.push_back(Root{directory, recursive});
+				if (recursive) { addTree(directory, nullptr); }
+				return true;
+			}
+
+			void remove(const fs::path & directory, bool const recursive) override
+			{
+				auto lock = std::scoped_lock{m_mutex};
+				auto it	  = std::find_if(m_roots.begin(), m_roots.end(), [&](Root const & root) { return root.directory == directory && root.recursive == recursive; });
+				if (it == m_roots.end()) { return; }
+				m_roots.erase(it);
+				removeDirectories([this](const fs::path & path) { return !isCovered(path); });
+			}
+
+			void wait(std::optional<std::chrono::milliseconds> const timeout, Sink const & sink) override
+			{
+				auto fds = std::array<pollfd, 2>{pollfd{m_fd, POLLIN, 0}, pollfd{m_wakeFd, POLLIN, 0}};
+				if (::poll(fds.data(), fds.size(), timeout ? static_cast<int>(timeout->count()) : -1) <= 0) { return; }
+				if ((fds[1].revents & POLLIN) != 0)
+				{
+					auto value = u64{};
+					[[maybe_unused]] auto const bytes = ::read(m_wakeFd, &value, sizeof(value));
+				}
+				if ((fds[0].revents & POLLIN) != 0) { readEvents(sink); }
+			}
+
+			void wake() override
+			{
+				auto const value = u64{1};
+				[[maybe_unused]] auto const bytes = ::write(m_wakeFd, &value, sizeof(value));
+			}
+
+			GEN_NODISCARD FileWatcher::Backend getBackend() const override { return FileWatcher::Backend::eInotify; }
+
+		private:
+			struct Root
+			{
+				fs::path directory{};
+				bool recursive{};
+			};
+
+			void readEvents(Sink const & sink)
+			{
+				alignas(inotify_event) char buffer[64 << 10];
+				auto lock = std::scoped_lock{m_mutex};
+				while (true)
+				{
+					auto const size = ::read(m_fd, buffer, sizeof(buffer));
+					if (size <= 0) { return; }
+					for (auto offset = ssize_t{}; offset < size;)
+					{
+						auto const * event = reinterpret_cast<inotify_event const *>(buffer + offset); // NOLINT(cppcoreguidelines-pro-type-reinterpret-cast)
+						offset += static_cast<ssize_t>(sizeof(inotify_event) + event->len);
+						handle(*event, sink);
+					}
+				}
+			}
+
+			void handle(inotify_event const & event, Sink const & sink)
+			{
+				if ((event.mask & IN_Q_OVERFLOW) != 0)
+				{
+					for (auto const & root : m_roots) { sink(root.directory, FileWatcher::Action::eRescan); }
+					return;
+				}
+				auto const it = m_directories.find(event.wd);
+				if (it == m_directories.end()) { return; }
+				if ((event.mask & IN_IGNORED) != 0)
+				{
+					m_descriptors.erase(it->second);
+					m_directories.erase(it);
+					return;
+				}
+				// a watched directory itself was moved, its path (and those of everything in it) is stale
+				if ((event.mask & IN_MOVE_SELF) != 0)
+				{
+					auto const directory = it->second;
+					sink(directory, FileWatcher::Action::eRescan);
+					removeDirectories([&directory](const fs::path & path) { return path == directory || isUnder(path, directory); });
+					return;
+				}
+				if (event.len == 0) { return; }
+
+				auto const path = it->second / event.name;
+				if ((event.mask & IN_ISDIR) != 0)
+				{
+					// the files of a directory moved (or created) in are reported as added, they may never get events of their own
+					if ((event.mask & (IN_CREATE | IN_MOVED_TO)) != 0 && isCovered(path) && addDirectory(path)) { addTree(path, &sink); }
+					return;
+				}
+				if ((event.mask & (IN_CREATE | IN_MOVED_TO)) != 0) { sink(path, FileWatcher::Action::eAdded); }
+				else if ((event.mask & IN_CLOSE_WRITE) != 0) { sink(path, FileWatcher::Action::eModified); }
+				else if ((event.mask & (IN_DELETE | IN_MOVED_FROM)) != 0) { sink(path, FileWatcher::Action::eRemoved); }
+			}
+
+			bool addDirectory(const fs::path & directory)
+			{
+				auto const wd = ::inotify_add_watch(m_fd, directory.c_str(), watch_mask_v);
+				if (wd < 0) { return false; }
+				m_directories[wd]		 = directory;
+				m_descriptors[directory] = wd;
+				return true;
+			}
+
+			/**
+			 * @brief Watches the subdirectories of directory, reporting its files as added if sink is set.
+			 */
+			void addTree(const fs::path & directory, Sink const * sink)
+			{
+				auto ec = std::error_code{};
+				for (auto it = fs::recursive_directory_iterator{directory, fs::directory_options::skip_permission_denied, ec}; !ec && it != fs::end(it);
+					 it.increment(ec))
+				{
+					if (it->is_directory(ec)) { addDirectory(it->path()); }
+					else if (sink != nullptr && it->is_regular_file(ec)) { (*sink)(it->path(), FileWatcher::Action::eAdded); }
+				}
+			}
+
+			template <typename Predicate>
+			void removeDirectories(Predicate const & predicate)
+			{
+				for (auto it = m_descriptors.begin(); it != m_descriptors.end();)
+				{
+					if (!predicate(it->first))
+					{
+						++it;
+						continue;
+					}
+					::inotify_rm_watch(m_fd, it->second);
+					m_directories.erase(it->second);
+					it = m_descriptors.erase(it);
+				}
+			}
+
+			/**
+			 * @brief Checks whether a root still needs directory to be watched.
+			 */
+			GEN_NODISCARD bool isCovered(const fs::path & directory) const
+			{
+				return std::any_of(m_roots.begin(), m_roots.end(), [&directory](Root const & root)
+								   { return root.directory == directory || (root.recursive && isUnder(directory, root.directory)); });
+			}
+
+			int m_fd;
+			int m_wakeFd; //!< eventfd making wait() return.
+			std::mutex m_mutex;
+			std::vector<Root> m_roots{};
+			std::unordered_map<int, fs::path> m_directories{}; //!< Watched directories by watch descriptor.
+			std::map<fs::path, int> m_descriptors{};			   //!< Watch descriptors by directory.
+		};
+	} // namespace
+
+	std::unique_ptr<WatchBackend> makeInotifyBackend()
+	{
+		auto const fd = ::inotify_init1(IN_NONBLOCK | IN_CLOEXEC);
+		if (fd < 0) { return nullptr; }
+		auto const wakeFd = ::eventfd(0, EFD_NONBLOCK | EFD_CLOEXEC);
+		if (wakeFd < 0)
+		{
+			::close(fd);
+			return nullptr;
+		}
+		return std::make_unique<InotifyBackend>(fd, wakeFd);
+	}
+#else
+	std::unique_ptr<WatchBackend> makeInotifyBackend()
+	{
+		return nullptr;
+	}
+#endif
+} // namespace gen::io
@@ -0,0 +1,103 @@
+// Copyright (c) 2023-present Genesis Engine contributors (see LICENSE.txt)
+
+#include "ioQueue.hpp"
+
+#include <algorithm>
+#include <condition_variable>
+#include <deque>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+namespace gen::io
+{
+	namespace
+	{
+		constexpr u32 uring_entries_v{256};
+		constexpr u32 max_pool_threads_v{4};
+
+		/**
+		 * @brief Fallback queue: blocking positional I/O on a few threads.
+		 */
+		class ThreadPoolQueue final : public IoQueue
+		{
+		public:
+			explicit ThreadPoolQueue(u32 const threads)
+			{
+				for (u32 index = 0; index < threads; ++index)
+				{
+					m_threads.emplace_back([this](std::stop_token const & stop) { run(stop); });
+				}
+			}
+
+			void submit(std::span<std::unique_ptr<IoRequest>> const requests) override
+			{
+				{
+					auto lock = std::scoped_lock{m_mutex};
+					for (auto & request : requests) { m_requests.push_back(std::move(request)); }
+				}
+				if (requests.size() == 1) { m_condition.notify_one(); }
+				else { m_condition.notify_all(); }
+			}
+
+			GEN_NODISCARD FileAsync::Backend getBackend() const override { return FileAsync::Backend::eThreadPool; }
+
+		private:
+			void run(std::stop_token const & stop)
+			{
+				while (true)
+				{
+					auto request = std::unique_ptr<IoRequest>{};
+					{
+						auto lock = std::unique_lock{m_mutex};
+						// drain outstanding requests even if stop requested
+						m_condition.wait(lock, stop, [this] { return !m_requests.empty(); });
+						if (m_requests.empty()) { return; }
+						request = std::move(m_requests.front());
+						m_requests.pop_front();
+					}
+					auto const result = request->op == IoRequest::Op::eRead ? native::readAt(request->handle, request->data, request->size, request->offset)
+																			: native::writeAt(request->handle, request->data, request->size, request->offset);
+					request->complete(result);
+				}
+			}
+
+			std::mutex m_mutex;
+			std::condition_variable_any m_condition;
+			std::deque<std::unique_ptr<IoRequest>> m_requests;
+			// destroyed first, joining the threads
+			std::vector<std::jthread> m_threads;
+		};
+	} // namespace
+
+	void IoRequest::complete(i64 const result)
+	{
+		auto const state = std::move(this->state);
+		if (state && state->stats != nullptr)
+		{
+			auto const op = this->op == Op::eRead ? IoStats::Op::eRead : IoStats::Op::eWrite;
+			state->stats->record(op, result < 0 ? 0 : static_cast<u64>(result), IoStats::Clock::now() - start);
+		}
+		if (callback)
+		{
+			auto const error = result < 0 ? static_cast<int>(-result) : 0;
+			callback(FileAsync::Result{.bytes = result < 0 ? 0 : static_cast<u64>(result), .error = error});
+		}
+		if (state && state->pending.fetch_sub(1, std::memory_order_acq_rel) == 1) { state->pending.notify_all(); }
+	}
+
+	IoQueue & IoQueue::get()
+	{
+		static auto const s_queue = []
+		{
+			if (auto ret = makeIoUringQueue(uring_entries_v)) { return ret; }
+			return makeThreadPoolQueue(std::clamp(std::thread::hardware_concurrency() / 2, 1u, max_pool_threads_v));
+		}();
+		return *s_queue;
+	}
+
+	std::unique_ptr<IoQueue> makeThreadPoolQueue(u32 const threads)
+	{
+		return std::make_unique<ThreadPoolQueue>(std::max(threads, 1u));
+	}
+} // namespace gen::io
@@ -0,0 +1,72 @@
+// Copyright (c) 2023-present Genesis Engine contributors (see LICENSE.txt)
+
+#pragma once
+
+#include "gen/io/fileAsync.hpp"
+#include "nativeFile.hpp"
+
+#include <memory>
+#include <span>
+
+namespace gen::io
+{
+	/**
+	 * @brief A queued FileAsync operation.
+	 */
+	struct IoRequest
+	{
+		enum class Op : u8
+		{
+			eRead,
+			eWrite,
+		};
+
+		Op op{};
+		native::Handle handle{native::invalid_handle_v};
+		std::byte * data{};
+		std::size_t size{};
+		u64 offset{};
+		FileAsync::Callback callback{};
+		std::shared_ptr<FileAsync::State> state{};
+		IoStats::Clock::time_point start{}; //!< When the request was submitted.
+
+		// progress of a request split into several submissions (by backends with a per submission limit)
+		std::size_t done{};
+		u32 length{};
+
+		/**
+		 * @brief Invokes the callback, then marks the operation complete on its file.
+		 * @param result Bytes transferred, or -errno.
+		 */
+		void complete(i64 result);
+	};
+
+	/**
+	 * @brief Process wide queue completing FileAsync operations in the background.
+	 */
+	class IoQueue
+	{
+	public:
+		virtual ~IoQueue() = default;
+
+		/**
+		 * @brief Takes ownership of requests and queues them, without waiting on the disk.
+		 */
+		virtual void submit(std::span<std::unique_ptr<IoRequest>> requests) = 0;
+
+		GEN_NODISCARD virtual FileAsync::Backend getBackend() const = 0;
+
+		/**
+		 * @brief Returns the queue, created on first use: io_uring if available, else a thread pool.
+		 */
+		static IoQueue & get();
+	};
+
+	/**
+	 * @brief Creates an io_uring backed queue.
+	 * @return nullptr if io_uring is unsupported (or blocked) on this system.
+	 */
+	std::unique_ptr<IoQueue> makeIoUringQueue(u32 entries);
+
+	std::unique_ptr<IoQueue> makeThreadPoolQueue(u32 threads);
+} // namespace gen::io
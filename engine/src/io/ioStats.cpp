@@ -0,0 +1,158 @@
+// Copyright (c) 2023-present Genesis Engine contributors (see LICENSE.txt)
+
+#include "gen/io/ioStats.hpp"
+#include "gen/logger/log.hpp"
+
+#include <algorithm>
+#include <bit>
+#include <map>
+#include <memory>
+#include <mutex>
+
+namespace gen
+{
+	namespace
+	{
+		constexpr std::array<std::string_view, 3> op_names_v{"read", "write", "sync"};
+
+		/**
+		 * @brief Bucket of a latency: exact below 4ns, then 4 buckets per power of two.
+		 */
+		constexpr std::size_t bucket_of(u64 const nanoseconds)
+		{
+			if (nanoseconds < 4) { return static_cast<std::size_t>(nanoseconds); }
+			auto const exponent = static_cast<std::size_t>(std::bit_width(nanoseconds)) - 1;
+			return (exponent - 1) * 4 + static_cast<std::size_t>((nanoseconds >> (exponent - 2)) & 3);
+		}
+
+		/**
+		 * @brief Middle of the range of latencies of a bucket.
+		 */
+		constexpr u64 middle_of(std::size_t const bucket)
+		{
+			if (bucket < 4) { return bucket; }
+			auto const shift = bucket / 4 - 1;
+			auto const lower = (4 + u64{bucket % 4}) << shift;
+			return lower + ((u64{1} << shift) >> 1);
+		}
+
+		static_assert(bucket_of(7) == 7 && bucket_of(8) == 8 && bucket_of(~u64{}) < 64 * 4);
+		static_assert(middle_of(bucket_of(1000)) >= 896 && middle_of(bucket_of(1000)) < 1024);
+
+		struct Registry
+		{
+			std::mutex mutex;
+			std::map<std::string, std::unique_ptr<IoStats>, std::less<>> stats;
+
+			static Registry & get()
+			{
+				// never destroyed, files may record while static destructors run
+				static auto * const s_registry = new Registry{};
+				return *s_registry;
+			}
+		};
+	} // namespace
+
+	IoStats & IoStats::get(std::string_view const category)
+	{
+		auto & registry = Registry::get();
+		auto lock		= std::scoped_lock{registry.mutex};
+		auto it			= registry.stats.find(category);
+		if (it == registry.stats.end())
+		{
+			// the constructor is private, hence no make_unique
+			it = registry.stats.emplace(std::string{category}, std::unique_ptr<IoStats>{new IoStats{category}}).first;
+		}
+		return *it->second;
+	}
+
+	std::vector<IoStats::Summary> IoStats::getSummaries()
+	{
+		auto & registry = Registry::get();
+		auto lock		= std::scoped_lock{registry.mutex};
+		auto ret		= std::vector<Summary>{};
+		for (auto const & [category, stats] : registry.stats)
+		{
+			for (std::size_t op = 0; op < stats->m_ops.size(); ++op)
+			{
+				auto summary = stats->summarize(static_cast<Op>(op));
+				if (summary.count > 0) { ret.push_back(summary); }
+			}
+		}
+		return ret;
+	}
+
+	void IoStats::dump(Logger const & logger)
+	{
+		using Microseconds = std::chrono::duration<double, std::micro>;
+		for (auto const & summary : getSummaries())
+		{
+			logger.info("{} {}: {} ops, {} bytes, p50 {:.1f}us, p99 {:.1f}us, max {:.1f}us", summary.category, op_names_v[static_cast<std::size_t>(summary.op)],
+						summary.count, summary.bytes, Microseconds{summary.p50}.count(), Microseconds{summary.p99}.count(), Microseconds{summary.max}.count());
+		}
+	}
+
+	void IoStats::resetAll()
+	{
+		auto & registry = Registry::get();
+		auto lock		= std::scoped_lock{registry.mutex};
+		for (auto const & [category, stats] : registry.stats) { stats->reset(); }
+	}
+
+	void IoStats::record(Op const op, u64 const bytes, Clock::duration const latency)
+	{
+		auto & counters		   = m_ops[static_cast<std::size_t>(op)];
+		auto const nanoseconds = static_cast<u64>(std::max<i64>(std::chrono::duration_cast<std::chrono::nanoseconds>(latency).count(), 0));
+		counters.count.fetch_add(1, std::memory_order_relaxed);
+		counters.bytes.fetch_add(bytes, std::memory_order_relaxed);
+		counters.buckets[bucket_of(nanoseconds)].fetch_add(1, std::memory_order_relaxed);
+		auto max = counters.max.load(std::memory_order_relaxed);
+		while (nanoseconds > max && !counters.max.compare_exchange_weak(max, nanoseconds, std::memory_order_relaxed)) {}
+	}
+
+	IoStats::Summary IoStats::summarize(Op const op) const
+	{
+		auto const & counters = m_ops[static_cast<std::size_t>(op)];
+		auto ret			  = Summary{.category = m_category,
+										.op		  = op,
+										.count	  = counters.count.load(std::memory_order_relaxed),
+										.bytes	  = counters.bytes.load(std::memory_order_relaxed),
+										.max	  = std::chrono::nanoseconds{counters.max.load(std::memory_order_relaxed)}};
+
+		auto buckets = std::array<u64, bucket_count_v>{};
+		auto total	 = u64{};
+		for (std::size_t bucket = 0; bucket < bucket_count_v; ++bucket)
+		{
+			buckets[bucket] = counters.buckets[bucket].load(std::memory_order_relaxed);
+			total += buckets[bucket];
+		}
+		auto const percentile = [&](u64 const permille)
+		{
+			auto const rank = std::max<u64>((total * permille + 999) / 1000, 1);
+			auto seen		= u64{};
+			for (std::size_t bucket = 0; bucket < bucket_count_v; ++bucket)
+			{
+				seen += buckets[bucket];
+				if (seen >= rank) { return std::min(std::chrono::nanoseconds{middle_of(bucket)}, ret.max); }
+			}
+			return ret.max;
+		};
+		if (total > 0)
+		{
+			ret.p50 = percentile(500);
+			ret.p99 = percentile(990);
+		}
+		return ret;
+	}
+
+	void IoStats::reset()
+	{
+		for (auto & counters : m_ops)
+		{
+			counters.count.store(0, std::memory_order_relaxed);
+			counters.bytes.store(0, std::memory_order_relaxed);
+			counters.max.store(0, std::memory_order_relaxed);
+			for (auto & bucket : counters.buckets) { bucket.store(0, std::memory_order_relaxed); }
+		}
+	}
+} // namespace gen
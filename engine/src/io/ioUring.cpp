@@ -0,0 +1,308 @@
+// Copyright (c) 2023-present Genesis Engine contributors (see LICENSE.txt)
+
+#include "ioQueue.hpp"
+
+#if GEN_PLATFORM_LINUX && __has_include(<linux/io_uring.h>)
+	#define GEN_IO_URING 1
+#endif
+
+#if GEN_IO_URING
+	#include <linux/io_uring.h>
+	#include <sys/mman.h>
+	#include <sys/syscall.h>
+	#include <unistd.h>
+
+	#include <algorithm>
+	#include <atomic>
+	#include <cerrno>
+	#include <chrono>
+	#include <deque>
+	#include <mutex>
+	#include <thread>
+	#include <utility>
+	#include <vector>
+#endif
+
+namespace gen::io
+{
+#if GEN_IO_URING
+	namespace
+	{
+		// largest length submitted at once, bigger requests are split
+		constexpr u32 max_length_v{1u << 30};
+
+		// liburing is not a dependency: the two syscalls are all we need
+		int io_uring_setup(u32 const entries, io_uring_params * params)
+		{
+			return static_cast<int>(::syscall(__NR_io_uring_setup, entries, params));
+		}
+
+		int io_uring_enter(int const fd, u32 const toSubmit, u32 const minComplete, u32 const flags)
+		{
+			return static_cast<int>(::syscall(__NR_io_uring_enter, fd, toSubmit, minComplete, flags, nullptr, 0));
+		}
+
+		// ring indices are shared with the kernel
+		u32 load_acquire(u32 & value)
+		{
+			return std::atomic_ref<u32>{value}.load(std::memory_order_acquire);
+		}
+
+		void store_release(u32 & value, u32 const desired)
+		{
+			std::atomic_ref<u32>{value}.store(desired, std::memory_order_release);
+		}
+
+		/**
+		 * @brief io_uring backed queue.
+		 *
+		 * Any thread submits (under a mutex, a single non-blocking io_uring_enter per batch),
+		 * a completion thread waits for completions and invokes callbacks.
+		 * Requests the kernel refuses (EAGAIN when short of memory) complete with its error on the submitting thread.
+		 */
+		class UringQueue final : public IoQueue
+		{
+		public:
+			UringQueue() = default;
+
+			~UringQueue() override
+			{
+				if (m_thread.joinable())
+				{
+					m_thread.request_stop();
+					// wake the completion thread with a no-op, tried again until the kernel takes it
+					for (auto woken = false; !woken; std::this_thread::yield())
+					{
+						auto failed = Completions{};
+						{
+							auto lock = std::scoped_lock{m_mutex};
+							m_pending.push_back(nullptr);
+							flush(failed);
+						}
+						woken = std::ranges::none_of(failed, [](auto const & completion) { return completion.first == nullptr; });
+						complete(failed);
+					}
+					m_thread.join();
+				}
+				if (m_sqes != nullptr) { ::munmap(m_sqes, m_sqesSize); }
+				if (m_ring != nullptr) { ::munmap(m_ring, m_ringSize); }
+				if (m_fd >= 0) { ::close(m_fd); }
+			}
+
+			UringQueue(UringQueue const &)			   = delete;
+			UringQueue & operator=(UringQueue const &) = delete;
+
+			/**
+			 * @brief Sets up the ring.
+			 * @return `false` if io_uring is unavailable, or the kernel is too old (IORING_OP_READ / WRITE need 5.6).
+			 */
+			bool init(u32 const entries)
+			{
+				auto params = io_uring_params{};
+				m_fd		= io_uring_setup(entries, &params);
+				if (m_fd < 0) { return false; }
+				// FAST_POLL arrived in 5.7, after the plain read / write opcodes
+				if ((params.features & IORING_FEAT_SINGLE_MMAP) == 0 || (params.features & IORING_FEAT_FAST_POLL) == 0) { return false; }
+
+				m_ringSize = std::max(params.sq_off.array + params.sq_entries * sizeof(u32), params.cq_off.cqes + params.cq_entries * sizeof(io_uring_cqe));
+				m_ring	   = ::mmap(nullptr, m_ringSize, PROT_READ | PROT_WRITE, MAP_SHARED | MAP_POPULATE, m_fd, IORING_OFF_SQ_RING);
+				if (m_ring == MAP_FAILED)
+				{
+					m_ring = nullptr;
+					return false;
+				}
+				m_sqesSize = params.sq_entries * sizeof(io_uring_sqe);
+				auto * sqes = ::mmap(nullptr, m_sqesSize, PROT_READ | PROT_WRITE, MAP_SHARED | MAP_POPULATE, m_fd, IORING_OFF_SQES);
+				if (sqes == MAP_FAILED) { return false; }
+				m_sqes = static_cast<io_uring_sqe *>(sqes);
+
+				auto * base = static_cast<std::byte *>(m_ring);
+				// NOLINTBEGIN
+				m_sq = Ring{
+					.head  = reinterpret_cast<u32 *>(base + params.sq_off.head),
+					.tail  = reinterpret_cast<u32 *>(base + params.sq_off.tail),
+					.mask  = *reinterpret_cast<u32 *>(base + params.sq_off.ring_mask),
+					.count = params.sq_entries,
+				};
+				m_sqArray = reinterpret_cast<u32 *>(base + params.sq_off.array);
+				m_cq	  = Ring{
+						 .head	= reinterpret_cast<u32 *>(base + params.cq_off.head),
+						 .tail	= reinterpret_cast<u32 *>(base + params.cq_off.tail),
+						 .mask	= *reinterpret_cast<u32 *>(base + params.cq_off.ring_mask),
+						 .count = params.cq_entries,
+				 };
+				m_cqes = reinterpret_cast<io_uring_cqe *>(base + params.cq_off.cqes);
+				// NOLINTEND
+
+				m_thread = std::jthread{[this](std::stop_token const & stop) { run(stop); }};
+				return true;
+			}
+
+			void submit(std::span<std::unique_ptr<IoRequest>> const requests) override
+			{
+				auto failed = Completions{};
+				{
+					auto lock = std::scoped_lock{m_mutex};
+					for (auto & request : requests) { m_pending.push_back(request.release()); }
+					flush(failed);
+				}
+				complete(failed);
+			}
+
+			GEN_NODISCARD FileAsync::Backend getBackend() const override { return FileAsync::Backend::eIoUring; }
+
+		private:
+			struct Ring
+			{
+				u32 * head{};
+				u32 * tail{};
+				u32 mask{};
+				u32 count{};
+			};
+
+			// requests and their results (bytes or -errno), nullptr for a no-op
+			using Completions = std::vector<std::pair<IoRequest *, i32>>;
+
+			// caller must hold m_mutex
+			// moves pending requests into the submission ring and submits them with a single syscall
+			// whatever the kernel does not take is moved to failed, to be completed once the lock is released
+			void flush(Completions & failed)
+			{
+				// never have more in flight than the completion ring can hold
+				while (!m_pending.empty() && m_inflight < m_cq.count)
+				{
+					auto const tail = *m_sq.tail;
+					if (tail - load_acquire(*m_sq.head) >= m_sq.count) { break; }
+
+					auto * request = m_pending.front();
+					auto const index = tail & m_sq.mask;
+					auto & sqe		 = m_sqes[index];
+					sqe				 = io_uring_sqe{};
+					if (request == nullptr) { sqe.opcode = IORING_OP_NOP; }
+					else
+					{
+						request->length = static_cast<u32>(std::min<std::size_t>(request->size - request->done, max_length_v));
+						sqe.opcode		= request->op == IoRequest::Op::eRead ? IORING_OP_READ : IORING_OP_WRITE;
+						sqe.fd			= request->handle;
+						// NOLINTNEXTLINE
+						sqe.addr = reinterpret_cast<u64>(request->data + request->done);
+						sqe.len	 = request->length;
+						sqe.off	 = request->offset + request->done;
+					}
+					// NOLINTNEXTLINE
+					sqe.user_data	 = reinterpret_cast<u64>(request);
+					m_sqArray[index] = index;
+					store_release(*m_sq.tail, tail + 1);
+					m_pending.pop_front();
+					++m_inflight;
+				}
+
+				auto const unsubmitted = *m_sq.tail - load_acquire(*m_sq.head);
+				if (unsubmitted == 0) { return; }
+				auto submitted = int{};
+				while ((submitted = io_uring_enter(m_fd, unsubmitted, 0, 0)) < 0 && errno == EINTR) {}
+				auto const error = submitted < 0 ? errno : EAGAIN;
+
+				// the ring is only entered with entries to submit here, so nothing else would send these:
+				// they are taken back (rewinding the tail) rather than left to a wait that never ends
+				auto const head = load_acquire(*m_sq.head);
+				for (auto index = head; index != *m_sq.tail; ++index)
+				{
+					// NOLINTNEXTLINE
+					failed.emplace_back(reinterpret_cast<IoRequest *>(m_sqes[m_sqArray[index & m_sq.mask]].user_data), -error);
+				}
+				store_release(*m_sq.tail, head);
+			}
+
+			// invokes callbacks (or resubmits the rest of split requests) without holding m_mutex, as callbacks may submit
+			void complete(Completions & completed)
+			{
+				while (!completed.empty())
+				{
+					auto resubmit = std::vector<IoRequest *>{};
+					for (auto const & [request, result] : completed)
+					{
+						if (request == nullptr) { continue; }
+						if (result > 0)
+						{
+							request->done += static_cast<std::size_t>(result);
+							// a split request continues where the previous submission ended
+							if (static_cast<u32>(result) == request->length && request->done < request->size)
+							{
+								resubmit.push_back(request);
+								continue;
+							}
+						}
+						request->complete(result < 0 ? result : static_cast<i64>(request->done));
+						// NOLINTNEXTLINE
+						delete request;
+					}
+
+					auto lock = std::scoped_lock{m_mutex};
+					m_inflight -= static_cast<u32>(completed.size());
+					m_pending.insert(m_pending.begin(), resubmit.begin(), resubmit.end());
+					completed.clear();
+					// room was freed, the pending requests that go out may fail in turn
+					flush(completed);
+				}
+			}
+
+			void run(std::stop_token const & stop)
+			{
+				auto completed = Completions{};
+				while (true)
+				{
+					{
+						auto lock = std::scoped_lock{m_mutex};
+						// drain outstanding requests even if stop requested
+						if (stop.stop_requested() && m_inflight == 0 && m_pending.empty()) { return; }
+					}
+					// only a broken ring fails without submitting, back off rather than spin on it
+					if (io_uring_enter(m_fd, 0, 1, IORING_ENTER_GETEVENTS) < 0 && errno != EINTR) { std::this_thread::sleep_for(std::chrono::milliseconds{1}); }
+
+					auto head		= *m_cq.head;
+					auto const tail = load_acquire(*m_cq.tail);
+					for (; head != tail; ++head)
+					{
+						auto const & cqe = m_cqes[head & m_cq.mask];
+						// NOLINTNEXTLINE
+						completed.emplace_back(reinterpret_cast<IoRequest *>(cqe.user_data), cqe.res);
+					}
+					store_release(*m_cq.head, head);
+					complete(completed);
+				}
+			}
+
+			int m_fd{-1};
+			void * m_ring{};
+			std::size_t m_ringSize{};
+			io_uring_sqe * m_sqes{};
+			std::size_t m_sqesSize{};
+			Ring m_sq{};
+			u32 * m_sqArray{};
+			Ring m_cq{};
+			io_uring_cqe * m_cqes{};
+
+			// guards the submission ring, m_pending and m_inflight
+			std::mutex m_mutex;
+			// requests waiting for room in the rings (nullptr: wake up no-op)
+			std::deque<IoRequest *> m_pending;
+			u32 m_inflight{};
+
+			std::jthread m_thread;
+		};
+	} // namespace
+
+	std::unique_ptr<IoQueue> makeIoUringQueue(u32 const entries)
+	{
+		auto ret = std::make_unique<UringQueue>();
+		if (!ret->init(entries)) { return {}; }
+		return ret;
+	}
+#else
+	std::unique_ptr<IoQueue> makeIoUringQueue(u32 const /*entries*/)
+	{
+		return {};
+	}
+#endif
+} // namespace gen::io
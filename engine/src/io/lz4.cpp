@@ -0,0 +1,175 @@
+// Copyright (c) 2023-present Genesis Engine contributors (see LICENSE.txt)
+
+#include "gen/io/lz4.hpp"
+
+#include <algorithm>
+#include <array>
+#include <cstdint>
+#include <cstring>
+
+namespace gen::lz4
+{
+	namespace
+	{
+		constexpr std::size_t min_match_v{4};
+		constexpr std::size_t last_literals_v{5}; // a block always ends with at least this many literals
+		constexpr std::size_t match_limit_v{12};  // the last match starts at least this far from the end
+		constexpr std::size_t max_offset_v{65535};
+		constexpr std::size_t run_mask_v{15};
+		constexpr int hash_bits_v{12};
+
+		std::uint32_t read32(std::byte const * data)
+		{
+			auto ret = std::uint32_t{};
+			std::memcpy(&ret, data, sizeof(ret));
+			return ret;
+		}
+
+		std::size_t hash(std::uint32_t const value)
+		{
+			return (value * 2654435761U) >> (32 - hash_bits_v);
+		}
+
+		struct Writer
+		{
+			std::span<std::byte> dst{};
+			std::size_t pos{};
+			bool ok{true};
+
+			void byte(std::size_t const value)
+			{
+				if (pos >= dst.size())
+				{
+					ok = false;
+					return;
+				}
+				dst[pos++] = static_cast<std::byte>(value);
+			}
+
+			// length bytes following a saturated token nibble
+			void length(std::size_t value)
+			{
+				for (; value >= 255; value -= 255) { byte(255); }
+				byte(value);
+			}
+
+			void copy(std::span<std::byte const> const src)
+			{
+				if (dst.size() - std::min(pos, dst.size()) < src.size())
+				{
+					ok = false;
+					return;
+				}
+				if (!src.empty()) { std::memcpy(dst.data() + pos, src.data(), src.size()); }
+				pos += src.size();
+			}
+
+			// match == 0 writes the trailing literals
+			void sequence(std::span<std::byte const> const literals, std::size_t const offset, std::size_t const match)
+			{
+				auto const extra = match == 0 ? 0 : match - min_match_v;
+				byte((std::min(literals.size(), run_mask_v) << 4) | std::min(extra, run_mask_v));
+				if (literals.size() >= run_mask_v) { length(literals.size() - run_mask_v); }
+				copy(literals);
+				if (match == 0) { return; }
+				byte(offset & 0xff);
+				byte(offset >> 8);
+				if (extra >= run_mask_v) { length(extra - run_mask_v); }
+			}
+		};
+	} // namespace
+
+	std::size_t compress(std::span<std::byte const> const src, std::span<std::byte> const dst)
+	{
+		auto out	= Writer{dst};
+		auto anchor = std::size_t{};
+		if (src.size() > match_limit_v)
+		{
+			// position + 1 of the last occurrence of each hashed 4 byte sequence, 0 when empty
+			auto table		 = std::array<std::size_t, std::size_t{1} << hash_bits_v>{};
+			auto const limit = src.size() - match_limit_v;
+			auto const end	 = src.size() - last_literals_v;
+			auto pos		 = std::size_t{};
+			auto misses		 = std::size_t{};
+			while (pos < limit)
+			{
+				auto const value	 = read32(src.data() + pos);
+				auto & slot			 = table[hash(value)];
+				auto const candidate = slot;
+				slot				 = pos + 1;
+				if (candidate == 0 || pos - (candidate - 1) > max_offset_v || read32(src.data() + candidate - 1) != value)
+				{
+					// skip faster through data that does not compress
+					pos += 1 + (misses++ >> 6);
+					continue;
+				}
+				misses = 0;
+
+				auto start = pos;
+				auto ref   = candidate - 1;
+				while (start > anchor && ref > 0 && src[start - 1] == src[ref - 1])
+				{
+					--start;
+					--ref;
+				}
+				auto length = pos - start + min_match_v;
+				while (start + length < end && src[ref + length] == src[start + length]) { ++length; }
+
+				out.sequence(src.subspan(anchor, start - anchor), start - ref, length);
+				pos	   = start + length;
+				anchor = pos;
+			}
+		}
+		out.sequence(src.subspan(anchor), 0, 0);
+		return out.ok ? out.pos : 0;
+	}
+
+	bool decompress(std::span<std::byte const> const src, std::span<std::byte> const dst)
+	{
+		auto in			  = std::size_t{};
+		auto out		  = std::size_t{};
+		auto const extend = [&](std::size_t & value)
+		{
+			if (value != run_mask_v) { return true; }
+			while (in < src.size())
+			{
+				auto const next = std::to_integer<std::size_t>(src[in++]);
+				value += next;
+				if (next != 255) { return true; }
+			}
+			return false;
+		};
+
+		while (in < src.size())
+		{
+			auto const token = std::to_integer<std::size_t>(src[in++]);
+			auto literals	 = token >> 4;
+			if (!extend(literals) || src.size() - in < literals || dst.size() - out < literals) { return false; }
+			if (literals > 0) { std::memcpy(dst.data() + out, src.data() + in, literals); }
+			in += literals;
+			out += literals;
+
+			// the last sequence has no match
+			if (in == src.size()) { break; }
+
+			if (src.size() - in < 2) { return false; }
+			auto const offset = std::to_integer<std::size_t>(src[in]) | (std::to_integer<std::size_t>(src[in + 1]) << 8);
+			in += 2;
+			auto match = token & run_mask_v;
+			if (offset == 0 || offset > out || !extend(match)) { return false; }
+			match += min_match_v;
+			if (dst.size() - out < match) { return false; }
+
+			auto * target		= dst.data() + out;
+			auto const * source = target - offset;
+			if (offset >= match) { std::memcpy(target, source, match); }
+			else
+			{
+				// overlapping match, repeats the last offset bytes
+				for (std::size_t index = 0; index < match; ++index) { target[index] = source[index]; }
+			}
+			out += match;
+		}
+		return out == dst.size();
+	}
+} // namespace gen::lz4
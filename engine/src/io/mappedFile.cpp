@@ -0,0 +1,195 @@
+// Copyright (c) 2023-present Genesis Engine contributors (see LICENSE.txt)
+
+#include "gen/io/mappedFile.hpp"
+#include "nativeFile.hpp"
+
+#include <algorithm>
+#include <cstdint>
+#include <utility>
+
+#if GEN_PLATFORM_WINDOWS
+	#include "gen/system/win32/windows.hpp"
+#else
+	#include <sys/mman.h>
+	#include <unistd.h>
+#endif
+
+namespace gen
+{
+	namespace
+	{
+#if !GEN_PLATFORM_WINDOWS
+		constexpr std::size_t huge_page_size_v{std::size_t{2} << 20};
+
+		int to_advice(MappedFile::Access const access)
+		{
+			switch (access)
+			{
+			case MappedFile::Access::eSequential: return MADV_SEQUENTIAL;
+			case MappedFile::Access::eRandom: return MADV_RANDOM;
+			case MappedFile::Access::eWillNeed: return MADV_WILLNEED;
+			default: return MADV_NORMAL;
+			}
+		}
+
+		/**
+		 * @brief Maps the file at a huge page aligned address, so the kernel may back it with huge pages.
+		 * @return MAP_FAILED on failure.
+		 */
+		void * map_aligned(native::Handle const handle, std::size_t const size)
+		{
+			// reserve enough address space to place the file on a boundary, then map it over the reservation
+			auto const reserved = size + huge_page_size_v;
+			auto * reservation	= ::mmap(nullptr, reserved, PROT_NONE, MAP_PRIVATE | MAP_ANONYMOUS | MAP_NORESERVE, -1, 0);
+			if (reservation == MAP_FAILED) { return MAP_FAILED; }
+			auto const start   = reinterpret_cast<std::uintptr_t>(reservation);
+			auto const aligned = (start + huge_page_size_v - 1) & ~(huge_page_size_v - 1);
+			// NOLINTNEXTLINE
+			auto * ret = ::mmap(reinterpret_cast<void *>(aligned), size, PROT_READ, MAP_SHARED | MAP_FIXED, handle, 0);
+			if (ret == MAP_FAILED)
+			{
+				::munmap(reservation, reserved);
+				return MAP_FAILED;
+			}
+			// give back the unused head and tail of the reservation
+			if (aligned > start) { ::munmap(reservation, aligned - start); }
+			auto const page = static_cast<std::size_t>(::sysconf(_SC_PAGESIZE));
+			auto const end	= (aligned + size + page - 1) & ~(page - 1);
+			// NOLINTNEXTLINE
+			if (start + reserved > end) { ::munmap(reinterpret_cast<void *>(end), start + reserved - end); }
+			return ret;
+		}
+#endif
+	} // namespace
+
+	MappedFile::~MappedFile()
+	{
+		close();
+	}
+
+	MappedFile::MappedFile(MappedFile && other) noexcept
+		: m_data(std::exchange(other.m_data, nullptr)), m_size(std::exchange(other.m_size, 0)), m_mapping(std::exchange(other.m_mapping, nullptr)),
+		  m_mappingSize(std::exchange(other.m_mappingSize, 0)), m_valid(std::exchange(other.m_valid, false))
+#if GEN_PLATFORM_WINDOWS
+		  ,
+		  m_section(std::exchange(other.m_section, nullptr))
+#endif
+	{
+	}
+
+	MappedFile & MappedFile::operator=(MappedFile && other) noexcept
+	{
+		if (this != &other)
+		{
+			close();
+			m_data		  = std::exchange(other.m_data, nullptr);
+			m_size		  = std::exchange(other.m_size, 0);
+			m_mapping	  = std::exchange(other.m_mapping, nullptr);
+			m_mappingSize = std::exchange(other.m_mappingSize, 0);
+			m_valid		  = std::exchange(other.m_valid, false);
+#if GEN_PLATFORM_WINDOWS
+			m_section = std::exchange(other.m_section, nullptr);
+#endif
+		}
+		return *this;
+	}
+
+	bool MappedFile::open(const fs::path & filePath, Access const access, [[maybe_unused]] bool const hugePages)
+	{
+		close();
+
+		auto const handle = native::open(filePath, {.read = true});
+		if (handle == native::invalid_handle_v) { return false; }
+		auto const size = native::size(handle);
+		if (size < 0)
+		{
+			native::close(handle);
+			return false;
+		}
+		m_size = static_cast<std::size_t>(size);
+
+		// nothing to map, but still a valid (empty) file
+		if (m_size == 0)
+		{
+			native::close(handle);
+			m_valid = true;
+			return true;
+		}
+
+#if GEN_PLATFORM_WINDOWS
+		m_section = CreateFileMappingW(handle, nullptr, PAGE_READONLY, 0, 0, nullptr);
+		if (m_section != nullptr) { m_mapping = MapViewOfFile(m_section, FILE_MAP_READ, 0, 0, 0); }
+		// the mapping keeps the file open
+		native::close(handle);
+		if (m_mapping == nullptr)
+		{
+			close();
+			return false;
+		}
+		m_mappingSize = m_size;
+#else
+		auto * mapping = hugePages && m_size >= huge_page_size_v ? map_aligned(handle, m_size) : MAP_FAILED;
+		if (mapping == MAP_FAILED) { mapping = ::mmap(nullptr, m_size, PROT_READ, MAP_SHARED, handle, 0); }
+		// the mapping keeps the file open
+		native::close(handle);
+		if (mapping == MAP_FAILED)
+		{
+			m_size = 0;
+			return false;
+		}
+		m_mapping	  = mapping;
+		m_mappingSize = m_size;
+	#if defined(MADV_HUGEPAGE)
+		if (hugePages) { ::madvise(m_mapping, m_mappingSize, MADV_HUGEPAGE); }
+	#endif
+#endif
+
+		m_data	= static_cast<std::byte const *>(m_mapping);
+		m_valid = true;
+		advise(access, getData());
+		return true;
+	}
+
+	void MappedFile::close()
+	{
+#if GEN_PLATFORM_WINDOWS
+		if (m_mapping != nullptr) { UnmapViewOfFile(m_mapping); }
+		if (m_section != nullptr) { CloseHandle(m_section); }
+		m_section = nullptr;
+#else
+		if (m_mapping != nullptr) { ::munmap(m_mapping, m_mappingSize); }
+#endif
+		m_data		  = nullptr;
+		m_size		  = 0;
+		m_mapping	  = nullptr;
+		m_mappingSize = 0;
+		m_valid		  = false;
+	}
+
+	FileView MappedFile::getView(std::size_t const offset, std::size_t const size) const
+	{
+		if (offset >= m_size) { return {}; }
+		return getData().subspan(offset, std::min(size, m_size - offset));
+	}
+
+	void MappedFile::advise(Access const access, FileView const view) const
+	{
+		if (view.empty() || m_mapping == nullptr) { return; }
+#if GEN_PLATFORM_WINDOWS
+		// only prefetching has a Windows equivalent
+		if (access == Access::eWillNeed)
+		{
+			auto range = WIN32_MEMORY_RANGE_ENTRY{.VirtualAddress = const_cast<std::byte *>(view.data()), .NumberOfBytes = view.size()};
+			PrefetchVirtualMemory(GetCurrentProcess(), 1, &range, 0);
+		}
+#else
+		// madvise wants a page aligned start
+		auto const page	 = static_cast<std::uintptr_t>(::sysconf(_SC_PAGESIZE));
+		auto const begin = reinterpret_cast<std::uintptr_t>(view.data()) & ~(page - 1);
+		auto const end	 = reinterpret_cast<std::uintptr_t>(view.data() + view.size());
+		// NOLINTNEXTLINE
+		::madvise(reinterpret_cast<void *>(begin), end - begin, to_advice(access));
+#endif
+	}
+
+} // namespace gen
@@ -0,0 +1,237 @@
+// Copyright (c) 2023-present Genesis Engine contributors (see LICENSE.txt)
+
+#include "nativeFile.hpp"
+#include "gen/io/file.hpp"
+
+#include <algorithm>
+#include <array>
+#include <cerrno>
+#include <limits>
+#include <string>
+
+#if GEN_PLATFORM_WINDOWS
+	#include "gen/system/win32/windows.hpp"
+#else
+	#include <fcntl.h>
+	#include <sys/stat.h>
+	#include <unistd.h>
+#endif
+
+namespace gen::native
+{
+	OpenFlags toOpenFlags(int const mode)
+	{
+		auto ret = OpenFlags{
+			.read	   = (mode & File::in) != 0,
+			.write	   = (mode & (File::out | File::app)) != 0,
+			.truncate  = (mode & File::trunc) != 0,
+			.append	   = (mode & File::app) != 0,
+			.direct	   = (mode & File::direct) != 0,
+			.temporary = (mode & File::temporary) != 0,
+		};
+		ret.create = ret.write && (!ret.read || ret.truncate || ret.append);
+		if (!ret.read && !ret.write) { ret.read = true; }
+		// a scratch file is always new, there is nothing to truncate or append to
+		if (ret.temporary)
+		{
+			ret.read	 = true;
+			ret.write	 = true;
+			ret.create	 = true;
+			ret.truncate = false;
+			ret.append	 = false;
+		}
+		return ret;
+	}
+
+#if GEN_PLATFORM_WINDOWS
+	Handle open(std::filesystem::path const & path, OpenFlags const flags)
+	{
+		DWORD access = 0;
+		if (flags.read) { access |= GENERIC_READ; }
+		if (flags.write) { access |= GENERIC_WRITE; }
+		DWORD disposition = OPEN_EXISTING;
+		if (flags.create) { disposition = flags.truncate ? CREATE_ALWAYS : OPEN_ALWAYS; }
+		else if (flags.truncate) { disposition = TRUNCATE_EXISTING; }
+		DWORD attributes = FILE_ATTRIBUTE_NORMAL;
+		if (flags.direct) { attributes |= FILE_FLAG_NO_BUFFERING; }
+
+		auto name = path.wstring();
+		if (flags.temporary)
+		{
+			// a unique name in the directory, removed by the system once the last handle is closed
+			auto buffer = std::array<wchar_t, MAX_PATH>{};
+			if (GetTempFileNameW(path.c_str(), L"gen", 0, buffer.data()) == 0) { return invalid_handle_v; }
+			name		= buffer.data();
+			disposition = CREATE_ALWAYS;
+			attributes |= FILE_ATTRIBUTE_TEMPORARY | FILE_FLAG_DELETE_ON_CLOSE;
+		}
+
+		auto * handle = CreateFileW(name.c_str(), access, FILE_SHARE_READ | FILE_SHARE_WRITE | FILE_SHARE_DELETE, nullptr, disposition, attributes, nullptr);
+		return handle == INVALID_HANDLE_VALUE ? invalid_handle_v : handle;
+	}
+
+	void close(Handle const handle)
+	{
+		if (handle != invalid_handle_v) { CloseHandle(handle); }
+	}
+
+	bool sync(Handle const handle)
+	{
+		return handle != invalid_handle_v && FlushFileBuffers(handle) != 0;
+	}
+
+	i64 size(Handle const handle)
+	{
+		auto ret = LARGE_INTEGER{};
+		if (handle == invalid_handle_v || !GetFileSizeEx(handle, &ret)) { return -1; }
+		return static_cast<i64>(ret.QuadPart);
+	}
+
+	i64 readAt(Handle const handle, void * data, std::size_t const dataSize, u64 const offset)
+	{
+		auto ret = i64{};
+		while (static_cast<std::size_t>(ret) < dataSize)
+		{
+			auto const position = offset + static_cast<u64>(ret);
+			auto overlapped		= OVERLAPPED{};
+			overlapped.Offset	  = static_cast<DWORD>(position);
+			overlapped.OffsetHigh = static_cast<DWORD>(position >> 32);
+			auto const chunk	  = static_cast<DWORD>(std::min<std::size_t>(dataSize - static_cast<std::size_t>(ret), std::numeric_limits<DWORD>::max()));
+			DWORD read			  = 0;
+			if (!ReadFile(handle, static_cast<std::byte *>(data) + ret, chunk, &read, &overlapped))
+			{
+				if (GetLastError() == ERROR_HANDLE_EOF) { break; }
+				return -EIO;
+			}
+			if (read == 0) { break; }
+			ret += read;
+		}
+		return ret;
+	}
+
+	i64 writeAt(Handle const handle, void const * data, std::size_t const dataSize, u64 const offset)
+	{
+		auto ret = i64{};
+		while (static_cast<std::size_t>(ret) < dataSize)
+		{
+			auto const position = offset + static_cast<u64>(ret);
+			auto overlapped		= OVERLAPPED{};
+			overlapped.Offset	  = static_cast<DWORD>(position);
+			overlapped.OffsetHigh = static_cast<DWORD>(position >> 32);
+			auto const chunk	  = static_cast<DWORD>(std::min<std::size_t>(dataSize - static_cast<std::size_t>(ret), std::numeric_limits<DWORD>::max()));
+			DWORD written		  = 0;
+			if (!WriteFile(handle, static_cast<std::byte const *>(data) + ret, chunk, &written, &overlapped)) { return -EIO; }
+			ret += written;
+		}
+		return ret;
+	}
+#else
+	namespace
+	{
+		/**
+		 * @brief Turns off OS caching of an open file.
+		 */
+		bool set_direct(Handle const handle)
+		{
+	#if defined(GEN_PLATFORM_APPLE)
+			return ::fcntl(handle, F_NOCACHE, 1) == 0;
+	#elif defined(O_DIRECT)
+			auto const status = ::fcntl(handle, F_GETFL);
+			return status >= 0 && ::fcntl(handle, F_SETFL, status | O_DIRECT) == 0;
+	#else
+			return false;
+	#endif
+		}
+
+		Handle open_temporary(std::filesystem::path const & directory)
+		{
+	#if defined(O_TMPFILE)
+			// NOLINTNEXTLINE
+			auto const ret = ::open(directory.c_str(), O_TMPFILE | O_RDWR | O_CLOEXEC, 0600);
+			// not every file system supports unnamed files
+			if (ret >= 0 || (errno != EOPNOTSUPP && errno != EISDIR)) { return ret; }
+	#endif
+			auto name = (directory / "gen-scratch-XXXXXX").string();
+			auto const fd = ::mkostemp(name.data(), O_CLOEXEC);
+			if (fd >= 0) { ::unlink(name.c_str()); }
+			return fd;
+		}
+	} // namespace
+
+	Handle open(std::filesystem::path const & path, OpenFlags const flags)
+	{
+		auto ret = invalid_handle_v;
+		if (flags.temporary) { ret = open_temporary(path); }
+		else
+		{
+			auto mode = O_RDONLY;
+			if (flags.write) { mode = flags.read ? O_RDWR : O_WRONLY; }
+			if (flags.create) { mode |= O_CREAT; }
+			if (flags.truncate) { mode |= O_TRUNC; }
+			// NOLINTNEXTLINE
+			ret = ::open(path.c_str(), mode | O_CLOEXEC, 0644);
+		}
+		if (ret != invalid_handle_v && flags.direct && !set_direct(ret))
+		{
+			::close(ret);
+			return invalid_handle_v;
+		}
+		return ret;
+	}
+
+	void close(Handle const handle)
+	{
+		if (handle != invalid_handle_v) { ::close(handle); }
+	}
+
+	bool sync(Handle const handle)
+	{
+	#if defined(GEN_PLATFORM_APPLE)
+		return handle != invalid_handle_v && ::fsync(handle) == 0;
+	#else
+		return handle != invalid_handle_v && ::fdatasync(handle) == 0;
+	#endif
+	}
+
+	i64 size(Handle const handle)
+	{
+		struct stat info{};
+		if (handle == invalid_handle_v || ::fstat(handle, &info) != 0) { return -1; }
+		return static_cast<i64>(info.st_size);
+	}
+
+	i64 readAt(Handle const handle, void * data, std::size_t const dataSize, u64 const offset)
+	{
+		auto ret = i64{};
+		while (static_cast<std::size_t>(ret) < dataSize)
+		{
+			auto const read = ::pread(handle, static_cast<std::byte *>(data) + ret, dataSize - static_cast<std::size_t>(ret), static_cast<off_t>(offset + static_cast<u64>(ret)));
+			if (read < 0)
+			{
+				if (errno == EINTR) { continue; }
+				return -errno;
+			}
+			if (read == 0) { break; }
+			ret += read;
+		}
+		return ret;
+	}
+
+	i64 writeAt(Handle const handle, void const * data, std::size_t const dataSize, u64 const offset)
+	{
+		auto ret = i64{};
+		while (static_cast<std::size_t>(ret) < dataSize)
+		{
+			auto const written =
+				::pwrite(handle, static_cast<std::byte const *>(data) + ret, dataSize - static_cast<std::size_t>(ret), static_cast<off_t>(offset + static_cast<u64>(ret)));
+			if (written < 0)
+			{
+				if (errno == EINTR) { continue; }
+				return -errno;
+			}
+			ret += written;
+		}
+		return ret;
+	}
+#endif
+} // namespace gen::native
@@ -0,0 +1,75 @@
+// Copyright (c) 2023-present Genesis Engine contributors (see LICENSE.txt)
+
+#pragma once
+
+#include "gen/core.hpp"
+
+#include <cstddef>
+#include <filesystem>
+
+namespace gen::native
+{
+	/**
+	 * @brief OS file handle: a file descriptor on POSIX, a HANDLE on Windows.
+	 */
+#if GEN_PLATFORM_WINDOWS
+	using Handle = void *;
+	inline Handle const invalid_handle_v{nullptr};
+#else
+	using Handle = int;
+	inline constexpr Handle invalid_handle_v{-1};
+#endif
+
+	/**
+	 * @brief Access requested when opening a native file.
+	 */
+	struct OpenFlags
+	{
+		bool read{};
+		bool write{};
+		bool create{};
+		bool truncate{};
+		bool append{}; //!< Only decides creation, the descriptor stays positional (File::write() appends itself).
+		bool direct{};	  //!< Bypass the OS cache, transfers must be aligned to File::direct_alignment_v.
+		bool temporary{}; //!< Create an unnamed scratch file in the directory at path, deleted on close.
+	};
+
+	/**
+	 * @brief Converts File::Mode bits to OpenFlags.
+	 *
+	 * Like std::fstream, writing creates the file unless it is also opened for reading (without trunc or app),
+	 * but nothing is truncated without trunc.
+	 */
+	OpenFlags toOpenFlags(int mode);
+
+	/**
+	 * @brief Opens a file.
+	 * @return The handle, or invalid_handle_v on failure.
+	 */
+	Handle open(std::filesystem::path const & path, OpenFlags flags);
+
+	void close(Handle handle);
+
+	/**
+	 * @brief Flushes written data to storage.
+	 * @return `true` on success.
+	 */
+	bool sync(Handle handle);
+
+	/**
+	 * @brief Returns the size of an open file in bytes, or -1 on failure.
+	 */
+	i64 size(Handle handle);
+
+	/**
+	 * @brief Positional read, does not move any file offset and is safe to call concurrently.
+	 * @return Bytes read (short only at end of file), or -errno on failure.
+	 */
+	i64 readAt(Handle handle, void * data, std::size_t dataSize, u64 offset);
+
+	/**
+	 * @brief Positional write, does not move any file offset and is safe to call concurrently.
+	 * @return Bytes written, or -errno on failure.
+	 */
+	i64 writeAt(Handle handle, void const * data, std::size_t dataSize, u64 offset);
+} // namespace gen::native
@@ -0,0 +1,18 @@
+// Copyright (c) 2023-present Genesis Engine contributors (see LICENSE.txt)
+
+#pragma once
+
+#include "gen/io/pakFormat.hpp"
+
+#include <cstddef>
+#include <span>
+
+namespace gen::io
+{
+	/**
+	 * @brief Decompresses a single block (or copies it, for Compression::eNone).
+	 * @param dst The buffer to decompress into, its size must be exactly the original size.
+	 * @return `false` if the block is corrupt or compression is not supported by this build.
+	 */
+	bool decompress(pak::Compression compression, std::span<std::byte const> src, std::span<std::byte> dst);
+} // namespace gen::io
@@ -0,0 +1,255 @@
+// Copyright (c) 2023-present Genesis Engine contributors (see LICENSE.txt)
+
+#include "gen/io/pakFile.hpp"
+#include "gen/io/lz4.hpp"
+#include "pakCodec.hpp"
+
+#include <algorithm>
+#include <bit>
+#include <cerrno>
+#include <cstring>
+#include <memory>
+
+#ifndef GEN_HAS_ZSTD
+	#define GEN_HAS_ZSTD 0
+#endif
+
+#if GEN_HAS_ZSTD
+	#include <zstd.h>
+#endif
+
+namespace gen::io
+{
+	bool decompress(pak::Compression const compression, std::span<std::byte const> const src, std::span<std::byte> const dst)
+	{
+		switch (compression)
+		{
+		case pak::Compression::eNone:
+			if (src.size() != dst.size()) { return false; }
+			if (!src.empty()) { std::memcpy(dst.data(), src.data(), src.size()); }
+			return true;
+		case pak::Compression::eLz4: return lz4::decompress(src, dst);
+#if GEN_HAS_ZSTD
+		case pak::Compression::eZstd:
+		{
+			auto const size = ZSTD_decompress(dst.data(), dst.size(), src.data(), src.size());
+			return ZSTD_isError(size) == 0 && size == dst.size();
+		}
+#endif
+		default: return false;
+		}
+	}
+} // namespace gen::io
+
+namespace gen
+{
+	namespace
+	{
+		static_assert(std::endian::native == std::endian::little, "the table of contents is read in place");
+
+		bool in_range(u64 const offset, u64 const size, u64 const limit)
+		{
+			return offset <= limit && size <= limit - offset;
+		}
+
+		/**
+		 * @brief Decompresses blocks from stored, the stored data of an entry starting at offset base in the archive.
+		 */
+		bool decode(std::span<PakFile::Block const> const blocks, u64 const base, std::span<std::byte const> const stored, std::span<std::byte> const buffer)
+		{
+			auto out = std::size_t{};
+			for (auto const & block : blocks)
+			{
+				auto const src = stored.subspan(static_cast<std::size_t>(block.offset - base), static_cast<std::size_t>(block.storedSize));
+				if (!io::decompress(block.compression, src, buffer.subspan(out, static_cast<std::size_t>(block.size)))) { return false; }
+				out += static_cast<std::size_t>(block.size);
+			}
+			return !blocks.empty() && out == buffer.size();
+		}
+	} // namespace
+
+	bool PakFile::open(const fs::path & filePath)
+	{
+		close();
+		if (!m_mapping.open(filePath, MappedFile::Access::eRandom)) { return false; }
+
+		auto const data = m_mapping.getData();
+		auto header		= pak::Header{};
+		if (data.size() < sizeof(header))
+		{
+			close();
+			return false;
+		}
+		std::memcpy(&header, data.data(), sizeof(header));
+		m_filePath = filePath;
+
+		auto const entries_size = u64{header.entryCount} * sizeof(pak::Entry);
+		auto const bucket_count = u64{1} << std::min(header.bucketBits, 31U);
+		auto const buckets_size = (bucket_count + 1) * sizeof(u32);
+		auto const valid		= header.magic == pak::magic_v && header.version == pak::version_v && header.bucketBits <= 31 &&
+						   header.entriesOffset % alignof(pak::Entry) == 0 && header.bucketsOffset % alignof(u32) == 0 &&
+						   in_range(header.entriesOffset, entries_size, data.size()) && in_range(header.bucketsOffset, buckets_size, data.size()) &&
+						   in_range(header.namesOffset, header.namesSize, data.size());
+		if (!valid || !m_async.open(filePath))
+		{
+			close();
+			return false;
+		}
+
+		// the mapping is page aligned and the offsets are aligned, so the sections can be used in place
+		// NOLINTBEGIN
+		m_entries = {reinterpret_cast<pak::Entry const *>(data.data() + header.entriesOffset), header.entryCount};
+		m_buckets = {reinterpret_cast<u32 const *>(data.data() + header.bucketsOffset), static_cast<std::size_t>(bucket_count + 1)};
+		m_names	  = {reinterpret_cast<char const *>(data.data() + header.namesOffset), static_cast<std::size_t>(header.namesSize)};
+		// NOLINTEND
+		m_bucketBits = header.bucketBits;
+
+		// validate once here, so lookups and reads never have to
+		auto ok = m_buckets.front() == 0 && m_buckets.back() == header.entryCount;
+		for (std::size_t index = 1; ok && index < m_buckets.size(); ++index) { ok = m_buckets[index - 1] <= m_buckets[index]; }
+		for (std::size_t index = 0; ok && index < m_entries.size(); ++index)
+		{
+			auto const & entry = m_entries[index];
+			ok = in_range(entry.nameOffset, entry.nameSize, m_names.size()) && in_range(entry.offset, entry.storedSize, data.size()) &&
+				 entry.compression <= pak::Compression::eZstd && entry.blockSize <= pak::max_block_size_v &&
+				 (entry.compression != pak::Compression::eNone || (entry.storedSize == entry.size && entry.blockSize == 0)) &&
+				 (index == 0 || m_entries[index - 1].hash <= entry.hash);
+		}
+		if (!ok)
+		{
+			close();
+			return false;
+		}
+		return true;
+	}
+
+	void PakFile::close()
+	{
+		m_async.close();
+		m_mapping.close();
+		m_filePath.clear();
+		m_entries	 = {};
+		m_buckets	 = {};
+		m_names		 = {};
+		m_bucketBits = 0;
+	}
+
+	PakFile::Entry PakFile::getEntry(u32 const index) const
+	{
+		return toEntry(m_entries[index]);
+	}
+
+	std::optional<PakFile::Entry> PakFile::find(std::string_view const name) const
+	{
+		if (m_entries.empty()) { return std::nullopt; }
+		auto const hash	  = pak::hashName(name);
+		auto const bucket = pak::bucketOf(hash, m_bucketBits);
+		for (auto index = m_buckets[bucket]; index < m_buckets[bucket + 1]; ++index)
+		{
+			auto const & entry = m_entries[index];
+			if (entry.hash == hash && m_names.substr(entry.nameOffset, entry.nameSize) == name) { return toEntry(entry); }
+		}
+		return std::nullopt;
+	}
+
+	FileView PakFile::getView(Entry const & entry) const
+	{
+		return m_mapping.getView(static_cast<std::size_t>(entry.offset), static_cast<std::size_t>(entry.storedSize));
+	}
+
+	std::vector<PakFile::Block> PakFile::getBlocks(Entry const & entry) const
+	{
+		if (entry.blockSize == 0) { return {Block{entry.offset, entry.storedSize, entry.size, entry.compression}}; }
+
+		// the block table, followed by the blocks
+		auto const count = (entry.size + entry.blockSize - 1) / entry.blockSize;
+		auto const view	 = getView(entry);
+		if (count * sizeof(u32) > view.size()) { return {}; }
+		auto ret = std::vector<Block>{};
+		ret.reserve(static_cast<std::size_t>(count));
+		auto offset	   = count * sizeof(u32);
+		auto remaining = entry.size;
+		for (std::size_t index = 0; index < count; ++index)
+		{
+			auto stored = u32{};
+			std::memcpy(&stored, view.data() + index * sizeof(u32), sizeof(u32));
+			auto const raw	= (stored & pak::raw_block_bit_v) != 0;
+			auto const size = std::min<u64>(remaining, entry.blockSize);
+			stored &= ~pak::raw_block_bit_v;
+			if (!in_range(offset, stored, view.size()) || (raw && stored != size)) { return {}; }
+			ret.push_back(Block{entry.offset + offset, stored, size, raw ? pak::Compression::eNone : entry.compression});
+			offset += stored;
+			remaining -= size;
+		}
+		return ret;
+	}
+
+	bool PakFile::read(Entry const & entry, std::span<std::byte> const buffer) const
+	{
+		return buffer.size() == entry.size && decode(getBlocks(entry), entry.offset, getView(entry), buffer);
+	}
+
+	std::vector<std::byte> PakFile::read(Entry const & entry) const
+	{
+		auto ret = std::vector<std::byte>(static_cast<std::size_t>(entry.size));
+		if (!read(entry, ret)) { ret.clear(); }
+		return ret;
+	}
+
+	void PakFile::readAsync(Entry const & entry, std::span<std::byte> const buffer, FileAsync::Callback callback)
+	{
+		if (buffer.size() != entry.size || !supports(entry.compression))
+		{
+			if (callback) { callback(FileAsync::Result{.error = EINVAL}); }
+			return;
+		}
+
+		if (entry.compression == pak::Compression::eNone && entry.blockSize == 0)
+		{
+			m_async.read(buffer, entry.offset,
+						 [size = entry.size, callback = std::move(callback)](FileAsync::Result const & result)
+						 {
+							 if (!callback) { return; }
+							 // a short read means the archive was truncated after it was opened
+							 callback(result && result.bytes != size ? FileAsync::Result{.bytes = result.bytes, .error = EIO} : result);
+						 });
+			return;
+		}
+
+		// std::function must be copyable, hence the shared staging buffer
+		auto staging = std::make_shared<std::vector<std::byte>>(static_cast<std::size_t>(entry.storedSize));
+		m_async.read(*staging, entry.offset,
+					 [staging, buffer, base = entry.offset, blocks = getBlocks(entry), callback = std::move(callback)](FileAsync::Result const & result)
+					 {
+						 auto ret = result;
+						 if (ret && (ret.bytes != staging->size() || !decode(blocks, base, *staging, buffer))) { ret.error = EIO; }
+						 if (ret) { ret.bytes = buffer.size(); }
+						 staging->clear();
+						 staging->shrink_to_fit();
+						 if (callback) { callback(ret); }
+					 });
+	}
+
+	bool PakFile::supports(pak::Compression const compression)
+	{
+		switch (compression)
+		{
+		case pak::Compression::eNone:
+		case pak::Compression::eLz4: return true;
+		case pak::Compression::eZstd: return GEN_HAS_ZSTD != 0;
+		default: return false;
+		}
+	}
+
+	PakFile::Entry PakFile::toEntry(pak::Entry const & entry) const
+	{
+		return Entry{
+			.name		 = m_names.substr(entry.nameOffset, entry.nameSize),
+			.offset		 = entry.offset,
+			.storedSize	 = entry.storedSize,
+			.size		 = entry.size,
+			.compression = entry.compression,
+			.blockSize	 = entry.blockSize,
+		};
+	}
+} // namespace gen
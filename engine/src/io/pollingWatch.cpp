@@ -0,0 +1,157 @@
+// Copyright (c) 2023-present Genesis Engine contributors (see LICENSE.txt)
+
+#include "watchBackend.hpp"
+
+#include <algorithm>
+#include <condition_variable>
+#include <cstdint>
+#include <map>
+#include <mutex>
+#include <system_error>
+#include <vector>
+
+namespace gen::io
+{
+	namespace
+	{
+		/**
+		 * @brief Finds changes by listing the watched directories every interval, the fallback where the OS does not report them.
+		 */
+		class PollingBackend final : public WatchBackend
+		{
+		public:
+			explicit PollingBackend(std::chrono::milliseconds const interval) : m_interval(interval) {}
+
+			bool add(const fs::path & directory, bool const recursive) override
+			{
+				auto ec = std::error_code{};
+				if (!fs::is_directory(directory, ec)) { return false; }
+				auto root = Root{directory, recursive, scan(directory, recursive)};
+				auto lock = std::scoped_lock{m_mutex};
+				m_roots.push_back(std::move(root));
+				return true;
+			}
+
+			void remove(const fs::path & directory, bool const recursive) override
+			{
+				auto lock = std::scoped_lock{m_mutex};
+				auto it	  = std::find_if(m_roots.begin(), m_roots.end(), [&](Root const & root) { return root.directory == directory && root.recursive == recursive; });
+				if (it != m_roots.end()) { m_roots.erase(it); }
+			}
+
+			void wait(std::optional<std::chrono::milliseconds> const timeout, Sink const & sink) override
+			{
+				auto const now = Clock::now();
+				auto lock	   = std::unique_lock{m_mutex};
+				if (m_nextScan == Clock::time_point{}) { m_nextScan = now + m_interval; }
+				auto const until = timeout ? std::min(m_nextScan, now + *timeout) : m_nextScan;
+				m_condition.wait_until(lock, until, [this] { return m_woken; });
+				m_woken = false;
+				if (Clock::now() < m_nextScan) { return; }
+
+				for (auto & root : m_roots)
+				{
+					auto files = scan(root.directory, root.recursive);
+					compare(root.files, files, sink);
+					root.files = std::move(files);
+				}
+				m_nextScan = Clock::now() + m_interval;
+			}
+
+			void wake() override
+			{
+				{
+					auto lock = std::scoped_lock{m_mutex};
+					m_woken	  = true;
+				}
+				m_condition.notify_one();
+			}
+
+			GEN_NODISCARD FileWatcher::Backend getBackend() const override { return FileWatcher::Backend::ePolling; }
+
+		private:
+			using Clock = std::chrono::steady_clock;
+
+			struct Stamp
+			{
+				fs::file_time_type time{};
+				std::uintmax_t size{};
+
+				bool operator==(Stamp const &) const = default;
+			};
+
+			using Files = std::map<fs::path, Stamp>;
+
+			struct Root
+			{
+				fs::path directory{};
+				bool recursive{};
+				Files files{}; //!< The files found by the previous scan.
+			};
+
+			static Files scan(const fs::path & directory, bool const recursive)
+			{
+				auto ret	   = Files{};
+				auto const add = [&ret](fs::directory_entry const & entry)
+				{
+					auto ec = std::error_code{};
+					if (!entry.is_regular_file(ec)) { return; }
+					auto const time = entry.last_write_time(ec);
+					if (ec) { return; }
+					auto const size = entry.file_size(ec);
+					if (ec) { return; }
+					ret.emplace(entry.path(), Stamp{time, size});
+				};
+
+				auto ec			   = std::error_code{};
+				auto const options = fs::directory_options::skip_permission_denied;
+				if (recursive)
+				{
+					for (auto it = fs::recursive_directory_iterator{directory, options, ec}; !ec && it != fs::end(it); it.increment(ec)) { add(*it); }
+				}
+				else
+				{
+					for (auto it = fs::directory_iterator{directory, options, ec}; !ec && it != fs::end(it); it.increment(ec)) { add(*it); }
+				}
+				return ret;
+			}
+
+			static void compare(Files const & before, Files const & after, Sink const & sink)
+			{
+				auto previous = before.begin();
+				auto current  = after.begin();
+				while (previous != before.end() || current != after.end())
+				{
+					if (current == after.end() || (previous != before.end() && previous->first < current->first))
+					{
+						sink(previous->first, FileWatcher::Action::eRemoved);
+						++previous;
+					}
+					else if (previous == before.end() || current->first < previous->first)
+					{
+						sink(current->first, FileWatcher::Action::eAdded);
+						++current;
+					}
+					else
+					{
+						if (previous->second != current->second) { sink(current->first, FileWatcher::Action::eModified); }
+						++previous;
+						++current;
+					}
+				}
+			}
+
+			std::chrono::milliseconds m_interval;
+			std::mutex m_mutex;
+			std::condition_variable m_condition;
+			bool m_woken{};
+			Clock::time_point m_nextScan{};
+			std::vector<Root> m_roots{};
+		};
+	} // namespace
+
+	std::unique_ptr<WatchBackend> makePollingBackend(std::chrono::milliseconds const interval)
+	{
+		return std::make_unique<PollingBackend>(interval);
+	}
+} // namespace gen::io
@@ -0,0 +1,60 @@
+// Copyright (c) 2023-present Genesis Engine contributors (see LICENSE.txt)
+
+#pragma once
+
+#include "gen/io/fileWatcher.hpp"
+
+#include <chrono>
+#include <functional>
+#include <memory>
+#include <optional>
+
+namespace gen::io
+{
+	/**
+	 * @brief Source of FileWatcher changes, called from any thread.
+	 *
+	 * Directories may be added more than once (by overlapping watches), each add() is undone by one remove().
+	 */
+	class WatchBackend
+	{
+	public:
+		using Sink = std::function<void(const fs::path & path, FileWatcher::Action action)>;
+
+		virtual ~WatchBackend() = default;
+
+		/**
+		 * @brief Starts reporting changes to the files in directory, and in its subdirectories if recursive.
+		 * @return `false` if the directory could not be watched.
+		 */
+		virtual bool add(const fs::path & directory, bool recursive) = 0;
+
+		virtual void remove(const fs::path & directory, bool recursive) = 0;
+
+		/**
+		 * @brief Blocks until changes arrive, timeout elapses or wake() is called, passing the changes to sink.
+		 * @param timeout How long to wait, `std::nullopt` to wait for changes.
+		 */
+		virtual void wait(std::optional<std::chrono::milliseconds> timeout, Sink const & sink) = 0;
+
+		/**
+		 * @brief Makes a blocked wait() return.
+		 */
+		virtual void wake() = 0;
+
+		GEN_NODISCARD virtual FileWatcher::Backend getBackend() const = 0;
+	};
+
+	/**
+	 * @brief Checks whether path is inside directory (and not directory itself).
+	 */
+	bool isUnder(const fs::path & path, const fs::path & directory);
+
+	/**
+	 * @brief Creates an inotify backed watcher.
+	 * @return nullptr if inotify is unsupported on this system.
+	 */
+	std::unique_ptr<WatchBackend> makeInotifyBackend();
+
+	std::unique_ptr<WatchBackend> makePollingBackend(std::chrono::milliseconds interval);
+} // namespace gen::io
@@ -0,0 +1,23 @@
+// Copyright (c) 2023-present Genesis Engine contributors (see LICENSE.txt)
+
+#include "gen/jobs/coroutineFrame.hpp"
+
+namespace gen::jobs
+{
+	namespace
+	{
+		// frames are a few hundred bytes, larger ones (deep locals) go to the heap untouched
+		constexpr std::size_t largest_pooled_frame_v{4096};
+		constexpr std::size_t max_blocks_per_chunk_v{256};
+	} // namespace
+
+	std::pmr::memory_resource & getCoroutineFrameResource()
+	{
+		// never destroyed, detached coroutines may be freed while static destructors run
+		static auto * const s_resource = new std::pmr::synchronized_pool_resource{std::pmr::pool_options{
+			.max_blocks_per_chunk		 = max_blocks_per_chunk_v,
+			.largest_required_pool_block = largest_pooled_frame_v,
+		}};
+		return *s_resource;
+	}
+} // namespace gen::jobs
@@ -0,0 +1,93 @@
+// Copyright (c) 2023-present Genesis Engine contributors (see LICENSE.txt)
+
+#include "gen/jobs/executor.hpp"
+
+#include <utility>
+
+namespace gen
+{
+	std::coroutine_handle<> jobs::TaskPromiseBase::complete(std::coroutine_handle<> const self) noexcept
+	{
+		if (continuation) { return continuation; }
+		if (executor != nullptr)
+		{
+			// nobody awaits a spawned task, its exception would be lost
+			if (exception) { std::terminate(); }
+			executor->finish(self);
+		}
+		return std::noop_coroutine();
+	}
+
+	Executor::Executor() : m_mainThread(std::this_thread::get_id())
+	{
+	}
+
+	Executor::~Executor()
+	{
+		// destroying a task destroys the tasks it awaits, they are owned by its frame
+		auto lock = std::scoped_lock{m_mutex};
+		for (auto * const address : m_tasks) { std::coroutine_handle<>::from_address(address).destroy(); }
+	}
+
+	void Executor::spawn(Task<> task)
+	{
+		auto const handle		  = std::exchange(task.m_handle, nullptr);
+		handle.promise().executor = this;
+		{
+			auto lock = std::scoped_lock{m_mutex};
+			m_tasks.insert(handle.address());
+		}
+		handle.resume();
+	}
+
+	void Executor::update(float const deltaTime)
+	{
+		{
+			auto lock = std::scoped_lock{m_mutex};
+			m_time += deltaTime;
+			// swapped rather than moved, so both vectors keep their capacity and steady frames do not allocate
+			std::swap(m_resuming, m_ready);
+			while (!m_timers.empty() && m_timers.top().time <= m_time)
+			{
+				m_resuming.push_back(m_timers.top().handle);
+				m_timers.pop();
+			}
+		}
+		// resumed tasks awaiting nextFrame() again land in m_ready, for the next update()
+		for (auto const handle : m_resuming) { handle.resume(); }
+		m_resuming.clear();
+	}
+
+	void Executor::resumeNextFrame(std::coroutine_handle<> const handle)
+	{
+		auto lock = std::scoped_lock{m_mutex};
+		m_ready.push_back(handle);
+	}
+
+	void Executor::resumeAfter(float const seconds, std::coroutine_handle<> const handle)
+	{
+		auto lock = std::scoped_lock{m_mutex};
+		m_timers.push(Timer{m_time + seconds, handle});
+	}
+
+	double Executor::getTime() const
+	{
+		auto lock = std::scoped_lock{m_mutex};
+		return m_time;
+	}
+
+	std::size_t Executor::getTaskCount() const
+	{
+		auto lock = std::scoped_lock{m_mutex};
+		return m_tasks.size();
+	}
+
+	void Executor::finish(std::coroutine_handle<> const task) noexcept
+	{
+		{
+			auto lock = std::scoped_lock{m_mutex};
+			m_tasks.erase(task.address());
+		}
+		task.destroy();
+	}
+} // namespace gen
@@ -0,0 +1,298 @@
+// Copyright (c) 2023-present Genesis Engine contributors (see LICENSE.txt)
+
+#include "gen/jobs/jobSystem.hpp"
+#include "gen/jobs/asyncJob.hpp"
+#include "workStealingDeque.hpp"
+
+#include <algorithm>
+#include <chrono>
+#include <utility>
+
+namespace gen
+{
+	namespace
+	{
+		// rounds of looking for work before sleeping
+		constexpr u32 spin_count_v{64};
+		// recycled entries kept per thread, the rest are freed
+		constexpr std::size_t max_free_entries_v{256};
+		// sleep between polls while a coroutine waits in resumeWhen()
+		constexpr auto poll_interval_v = std::chrono::microseconds{100};
+
+		thread_local u32 t_threadIndex{JobSystem::invalid_thread_v};
+	} // namespace
+
+	struct JobSystem::Entry
+	{
+		Job job{};
+		Counter * counter{};
+	};
+
+	struct alignas(64) JobSystem::Worker
+	{
+		~Worker()
+		{
+			for (auto * entry : freeEntries) { delete entry; }
+		}
+
+		Entry * allocate()
+		{
+			if (freeEntries.empty()) { return new Entry{}; }
+			auto * ret = freeEntries.back();
+			freeEntries.pop_back();
+			return ret;
+		}
+
+		void release(Entry * entry)
+		{
+			if (freeEntries.size() >= max_free_entries_v)
+			{
+				delete entry;
+				return;
+			}
+			entry->job = nullptr;
+			freeEntries.push_back(entry);
+		}
+
+		/**
+		 * @brief Next thread to steal from (xorshift), so thieves spread over the victims.
+		 */
+		u32 nextVictim(u32 const count)
+		{
+			random ^= random << 13;
+			random ^= random >> 17;
+			random ^= random << 5;
+			return random % count;
+		}
+
+		jobs::WorkStealingDeque<Entry *> deque{};
+		std::vector<Entry *> freeEntries{}; //!< Recycled entries, owner thread only.
+		u32 random{};
+	};
+
+	JobSystem::JobSystem(u32 const threadCount)
+	{
+		auto const count = std::max(threadCount, 1u);
+		for (u32 index = 0; index < count; ++index)
+		{
+			m_workers.push_back(std::make_unique<Worker>());
+			m_workers.back()->random = 0x9e3779b9u * (index + 1);
+		}
+		t_threadIndex = 0;
+		for (u32 index = 1; index < count; ++index)
+		{
+			m_threads.emplace_back([this, index](std::stop_token const & stop) { work(index, stop); });
+		}
+	}
+
+	JobSystem::~JobSystem()
+	{
+		// run what is left here, jobs may still be queueing jobs
+		for (auto outstanding = m_outstanding.load(std::memory_order_acquire); outstanding > 0; outstanding = m_outstanding.load(std::memory_order_acquire))
+		{
+			if (auto * entry = find(m_workers[0].get())) { execute(m_workers[0].get(), entry); }
+			else { std::this_thread::yield(); }
+		}
+		m_stopping.store(true, std::memory_order_seq_cst);
+		for (auto & thread : m_threads) { thread.request_stop(); }
+		wake(true);
+		m_threads.clear();
+		t_threadIndex = invalid_thread_v;
+	}
+
+	void JobSystem::run(Job job, Counter * const counter)
+	{
+		if (counter != nullptr) { counter->m_pending.fetch_add(1, std::memory_order_relaxed); }
+		m_outstanding.fetch_add(1, std::memory_order_relaxed);
+
+		auto const index = t_threadIndex;
+		if (index != invalid_thread_v)
+		{
+			auto & worker  = *m_workers[index];
+			auto * entry   = worker.allocate();
+			entry->job	   = std::move(job);
+			entry->counter = counter;
+			worker.deque.push(entry);
+		}
+		else
+		{
+			auto lock = std::scoped_lock{m_mutex};
+			m_injected.push_back(new Entry{std::move(job), counter});
+			m_injectedCount.fetch_add(1, std::memory_order_relaxed);
+		}
+		wake(false);
+	}
+
+	void JobSystem::run(AsyncJob job, Counter * const counter)
+	{
+		auto const handle = std::exchange(job.m_handle, nullptr);
+		if (!handle) { return; }
+		if (counter != nullptr) { counter->m_pending.fetch_add(1, std::memory_order_relaxed); }
+		// released by finish() once the coroutine returns
+		m_outstanding.fetch_add(1, std::memory_order_relaxed);
+		handle.promise().counter = counter;
+		resume(handle);
+	}
+
+	void JobSystem::resume(std::coroutine_handle<> const handle)
+	{
+		run([handle] { handle.resume(); });
+	}
+
+	void JobSystem::resumeWhen(std::coroutine_handle<> const handle, std::function<bool()> ready)
+	{
+		{
+			auto lock = std::scoped_lock{m_parkedMutex};
+			m_parked.push_back(Parked{handle, std::move(ready)});
+			m_parkedCount.fetch_add(1, std::memory_order_seq_cst);
+		}
+		// sleepers switch to polling
+		wake(true);
+	}
+
+	void JobSystem::wait(Counter const & counter)
+	{
+		auto * const worker = t_threadIndex != invalid_thread_v ? m_workers[t_threadIndex].get() : nullptr;
+		for (u32 spin = 0; !counter.isDone();)
+		{
+			if (auto * entry = find(worker))
+			{
+				execute(worker, entry);
+				spin = 0;
+			}
+			else if (++spin < spin_count_v) { std::this_thread::yield(); }
+			else { sleep(&counter); }
+		}
+	}
+
+	u32 JobSystem::getThreadIndex()
+	{
+		return t_threadIndex;
+	}
+
+	void JobSystem::work(u32 const index, std::stop_token const & stop)
+	{
+		t_threadIndex		= index;
+		auto * const worker = m_workers[index].get();
+		for (u32 spin = 0; true;)
+		{
+			if (auto * entry = find(worker))
+			{
+				execute(worker, entry);
+				spin = 0;
+			}
+			else if (stop.stop_requested()) { return; }
+			else if (++spin < spin_count_v) { std::this_thread::yield(); }
+			else { sleep(nullptr); }
+		}
+	}
+
+	JobSystem::Entry * JobSystem::find(Worker * const worker)
+	{
+		if (auto * entry = take(worker)) { return entry; }
+		// resumed coroutines are queued like any job
+		if (poll()) { return take(worker); }
+		return nullptr;
+	}
+
+	JobSystem::Entry * JobSystem::take(Worker * const worker)
+	{
+		if (worker != nullptr)
+		{
+			if (auto * entry = worker->deque.pop()) { return entry; }
+		}
+		if (m_injectedCount.load(std::memory_order_relaxed) > 0)
+		{
+			auto lock = std::scoped_lock{m_mutex};
+			if (!m_injected.empty())
+			{
+				auto * entry = m_injected.front();
+				m_injected.pop_front();
+				m_injectedCount.fetch_sub(1, std::memory_order_relaxed);
+				return entry;
+			}
+		}
+		auto const count = getThreadCount();
+		auto const first = worker != nullptr ? worker->nextVictim(count) : 0;
+		for (u32 offset = 0; offset < count; ++offset)
+		{
+			auto & victim = *m_workers[(first + offset) % count];
+			if (&victim == worker) { continue; }
+			if (auto * entry = victim.deque.steal()) { return entry; }
+		}
+		return nullptr;
+	}
+
+	bool JobSystem::poll()
+	{
+		if (m_parkedCount.load(std::memory_order_relaxed) == 0) { return false; }
+		// one poller at a time, the others have better things to do
+		auto lock = std::unique_lock{m_parkedMutex, std::try_to_lock};
+		if (!lock) { return false; }
+		auto ready = std::vector<std::coroutine_handle<>>{};
+		for (std::size_t index = 0; index < m_parked.size();)
+		{
+			if (!m_parked[index].ready())
+			{
+				++index;
+				continue;
+			}
+			ready.push_back(m_parked[index].handle);
+			m_parked[index] = std::move(m_parked.back());
+			m_parked.pop_back();
+			m_parkedCount.fetch_sub(1, std::memory_order_relaxed);
+		}
+		lock.unlock();
+		for (auto const handle : ready) { resume(handle); }
+		return !ready.empty();
+	}
+
+	void JobSystem::finish(Counter * const counter)
+	{
+		if (counter != nullptr && counter->m_pending.fetch_sub(1, std::memory_order_acq_rel) == 1) { wake(true); }
+		m_outstanding.fetch_sub(1, std::memory_order_release);
+	}
+
+	void JobSystem::execute(Worker * const worker, Entry * const entry)
+	{
+		entry->job();
+		auto * const counter = entry->counter;
+		if (worker != nullptr) { worker->release(entry); }
+		else { delete entry; }
+
+		// waiters may be asleep, and the counter is theirs to destroy once it drops to zero
+		if (counter != nullptr && counter->m_pending.fetch_sub(1, std::memory_order_acq_rel) == 1) { wake(true); }
+		m_outstanding.fetch_sub(1, std::memory_order_release);
+	}
+
+	void JobSystem::sleep(Counter const * const counter)
+	{
+		m_sleepers.fetch_add(1, std::memory_order_seq_cst);
+		std::atomic_thread_fence(std::memory_order_seq_cst);
+		auto const epoch = m_epoch.load(std::memory_order_seq_cst);
+		// checked after announcing the sleep: anything arriving later bumps the epoch, so wait() returns at once
+		if (!hasWork() && (counter == nullptr || !counter->isDone()) && !m_stopping.load(std::memory_order_seq_cst))
+		{
+			// nothing signals what parked coroutines wait on, keep polling
+			if (m_parkedCount.load(std::memory_order_seq_cst) > 0) { std::this_thread::sleep_for(poll_interval_v); }
+			else { m_epoch.wait(epoch, std::memory_order_seq_cst); }
+		}
+		m_sleepers.fetch_sub(1, std::memory_order_seq_cst);
+	}
+
+	void JobSystem::wake(bool const all)
+	{
+		// pairs with the fence in sleep(): either the sleeper sees the work, or this sees the sleeper
+		std::atomic_thread_fence(std::memory_order_seq_cst);
+		if (m_sleepers.load(std::memory_order_seq_cst) == 0) { return; }
+		m_epoch.fetch_add(1, std::memory_order_seq_cst);
+		if (all) { m_epoch.notify_all(); }
+		else { m_epoch.notify_one(); }
+	}
+
+	bool JobSystem::hasWork() const
+	{
+		if (m_injectedCount.load(std::memory_order_seq_cst) > 0) { return true; }
+		return std::any_of(m_workers.begin(), m_workers.end(), [](auto const & worker) { return !worker->deque.isEmpty(); });
+	}
+} // namespace gen
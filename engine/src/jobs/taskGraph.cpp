@@ -0,0 +1,123 @@
+// Copyright (c) 2023-present Genesis Engine contributors (see LICENSE.txt)
+
+#include "gen/jobs/taskGraph.hpp"
+
+#include <algorithm>
+#include <limits>
+#include <optional>
+#include <unordered_map>
+
+namespace gen
+{
+	namespace
+	{
+		constexpr u32 no_stage_v{std::numeric_limits<u32>::max()};
+
+		struct ResourceState
+		{
+			std::optional<u32> writer{}; //!< Last stage writing the resource.
+			std::vector<u32> readers{};	 //!< Stages reading it since that write.
+		};
+	} // namespace
+
+	void TaskGraph::add(std::string name, Task task, Access access)
+	{
+		auto stage	  = std::make_unique<Stage>();
+		stage->name	  = std::move(name);
+		stage->task	  = std::move(task);
+		stage->access = std::move(access);
+		m_stages.push_back(std::move(stage));
+		m_compiled = false;
+	}
+
+	void TaskGraph::clear()
+	{
+		m_stages.clear();
+		m_compiled = true;
+	}
+
+	void TaskGraph::execute()
+	{
+		if (!m_compiled) { compile(); }
+
+		if (!JobSystem::exists())
+		{
+			for (auto const & stage : m_stages) { stage->task(); }
+			return;
+		}
+
+		auto & jobSystem = JobSystem::getInstance();
+		auto counter	 = JobSystem::Counter{};
+		for (auto const & stage : m_stages) { stage->remaining.store(stage->predecessorCount, std::memory_order_relaxed); }
+		for (u32 index = 0; index < m_stages.size(); ++index)
+		{
+			if (m_stages[index]->predecessorCount == 0) { jobSystem.run([this, index, &counter] { runStage(index, counter); }, &counter); }
+		}
+		jobSystem.wait(counter);
+	}
+
+	void TaskGraph::compile()
+	{
+		auto resources	  = std::unordered_map<std::string_view, ResourceState>{};
+		auto predecessors = std::vector<u32>{};
+		for (auto const & stage : m_stages) { stage->successors.clear(); }
+		for (u32 index = 0; index < m_stages.size(); ++index)
+		{
+			auto & stage		= *m_stages[index];
+			auto const & reads	= stage.access.reads;
+			auto const & writes = stage.access.writes;
+			predecessors.clear();
+
+			for (auto const & resource : writes)
+			{
+				auto & state = resources[resource];
+				if (state.writer) { predecessors.push_back(*state.writer); }
+				predecessors.insert(predecessors.end(), state.readers.begin(), state.readers.end());
+			}
+			for (auto const & resource : reads)
+			{
+				// a stage reading what it writes is ordered as a writer
+				if (std::find(writes.begin(), writes.end(), resource) != writes.end()) { continue; }
+				if (auto const & writer = resources[resource].writer) { predecessors.push_back(*writer); }
+			}
+
+			std::sort(predecessors.begin(), predecessors.end());
+			predecessors.erase(std::unique(predecessors.begin(), predecessors.end()), predecessors.end());
+			predecessors.erase(std::remove(predecessors.begin(), predecessors.end(), index), predecessors.end());
+			for (auto const predecessor : predecessors) { m_stages[predecessor]->successors.push_back(index); }
+			stage.predecessorCount = static_cast<u32>(predecessors.size());
+
+			// updated after every dependency is known, so a stage never waits on itself
+			for (auto const & resource : writes)
+			{
+				auto & state = resources[resource];
+				state.writer = index;
+				state.readers.clear();
+			}
+			for (auto const & resource : reads)
+			{
+				if (std::find(writes.begin(), writes.end(), resource) == writes.end()) { resources[resource].readers.push_back(index); }
+			}
+		}
+		m_compiled = true;
+	}
+
+	void TaskGraph::runStage(u32 index, JobSystem::Counter & counter)
+	{
+		auto & jobSystem = JobSystem::getInstance();
+		while (index != no_stage_v)
+		{
+			m_stages[index]->task();
+
+			// the first successor made ready runs next on this thread, the others become jobs
+			auto next = no_stage_v;
+			for (auto const successor : m_stages[index]->successors)
+			{
+				if (m_stages[successor]->remaining.fetch_sub(1, std::memory_order_acq_rel) != 1) { continue; }
+				if (next == no_stage_v) { next = successor; }
+				else { jobSystem.run([this, successor, &counter] { runStage(successor, counter); }, &counter); }
+			}
+			index = next;
+		}
+	}
+} // namespace gen
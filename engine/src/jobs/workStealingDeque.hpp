@@ -0,0 +1,117 @@
+// Copyright (c) 2023-present Genesis Engine contributors (see LICENSE.txt)
+
+#pragma once
+
+#include "gen/core.hpp"
+
+#include <atomic>
+#include <memory>
+#include <type_traits>
+#include <vector>
+
+namespace gen::jobs
+{
+	/**
+	 * @brief Chase-Lev work-stealing deque (Lê, Pop, Cohen and Zappa Nardelli, PPoPP 2013).
+	 *
+	 * The owner thread pushes and pops at the bottom (LIFO, cache warm), any other thread steals from the top (FIFO).
+	 * Grows when full, retired arrays are kept until destruction since a thief may still be reading one.
+	 */
+	template <typename Type>
+		requires std::is_pointer_v<Type>
+	class WorkStealingDeque
+	{
+	public:
+		explicit WorkStealingDeque(i64 const capacity = 1024) : m_array(new Array{capacity}) { m_arrays.emplace_back(m_array.load(std::memory_order_relaxed)); }
+
+		WorkStealingDeque(const WorkStealingDeque &)			 = delete;
+		WorkStealingDeque & operator=(const WorkStealingDeque &) = delete;
+
+		/**
+		 * @brief Pushes an item at the bottom, owner thread only.
+		 */
+		void push(Type const item)
+		{
+			auto const bottom = m_bottom.load(std::memory_order_relaxed);
+			auto const top	  = m_top.load(std::memory_order_acquire);
+			auto * array	  = m_array.load(std::memory_order_relaxed);
+			if (bottom - top > array->capacity - 1) { array = grow(array, top, bottom); }
+			array->put(bottom, item);
+			// publishes the item to the thieves' acquire load of m_bottom
+			m_bottom.store(bottom + 1, std::memory_order_release);
+		}
+
+		/**
+		 * @brief Pops the most recently pushed item, owner thread only.
+		 * @return The item, or nullptr if the deque is empty.
+		 */
+		Type pop()
+		{
+			auto const bottom  = m_bottom.load(std::memory_order_relaxed) - 1;
+			auto const * array = m_array.load(std::memory_order_relaxed);
+			m_bottom.store(bottom, std::memory_order_relaxed);
+			std::atomic_thread_fence(std::memory_order_seq_cst);
+			auto top = m_top.load(std::memory_order_relaxed);
+			if (top > bottom)
+			{
+				m_bottom.store(bottom + 1, std::memory_order_relaxed);
+				return nullptr;
+			}
+			auto ret = array->get(bottom);
+			if (top == bottom)
+			{
+				// last item, race the thieves for it
+				if (!m_top.compare_exchange_strong(top, top + 1, std::memory_order_seq_cst, std::memory_order_relaxed)) { ret = nullptr; }
+				m_bottom.store(bottom + 1, std::memory_order_relaxed);
+			}
+			return ret;
+		}
+
+		/**
+		 * @brief Steals the least recently pushed item, from any thread.
+		 * @return The item, or nullptr if the deque is empty or another thread won the race.
+		 */
+		Type steal()
+		{
+			auto top = m_top.load(std::memory_order_acquire);
+			std::atomic_thread_fence(std::memory_order_seq_cst);
+			auto const bottom = m_bottom.load(std::memory_order_acquire);
+			if (top >= bottom) { return nullptr; }
+			auto const ret = m_array.load(std::memory_order_acquire)->get(top);
+			if (!m_top.compare_exchange_strong(top, top + 1, std::memory_order_seq_cst, std::memory_order_relaxed)) { return nullptr; }
+			return ret;
+		}
+
+		/**
+		 * @brief Checks whether the deque looks empty, a hint only.
+		 */
+		GEN_NODISCARD bool isEmpty() const { return m_top.load(std::memory_order_relaxed) >= m_bottom.load(std::memory_order_relaxed); }
+
+	private:
+		struct Array
+		{
+			explicit Array(i64 const size) : capacity(size), items(std::make_unique<std::atomic<Type>[]>(static_cast<std::size_t>(size))) {}
+
+			Type get(i64 const index) const { return items[static_cast<std::size_t>(index & (capacity - 1))].load(std::memory_order_relaxed); }
+			void put(i64 const index, Type const item) { items[static_cast<std::size_t>(index & (capacity - 1))].store(item, std::memory_order_relaxed); }
+
+			i64 capacity;
+			std::unique_ptr<std::atomic<Type>[]> items;
+		};
+
+		Array * grow(Array const * array, i64 const top, i64 const bottom)
+		{
+			auto * ret = new Array{array->capacity * 2};
+			for (auto index = top; index < bottom; ++index) { ret->put(index, array->get(index)); }
+			m_arrays.emplace_back(ret);
+			m_array.store(ret, std::memory_order_release);
+			return ret;
+		}
+
+		// top and bottom on separate cache lines, thieves hammer the former and the owner the latter
+		alignas(64) std::atomic<i64> m_top{};
+		alignas(64) std::atomic<i64> m_bottom{};
+		std::atomic<Array *> m_array;
+		std::vector<std::unique_ptr<Array>> m_arrays; //!< Every array ever used, owner thread only.
+	};
+} // namespace gen::jobs
@@ -1,13 +1,26 @@
 // Copyright (c) 2023-present Genesis Engine contributors (see LICENSE.txt)
 
 #include "gen/logger/instance.hpp"
+#include <algorithm>
+#include <array>
+#include <atomic>
+#include <charconv>
 #include <condition_variable>
-#include <filesystem>
-#include <fstream>
+#include <ctime>
+#include <functional>
 #include <iostream>
+#include <limits>
+#include <memory>
 #include <mutex>
+#include <optional>
+#include <span>
 #include <thread>
+#include <unordered_map>
 #include <vector>
+#include "gen/logger/binary.hpp"
+#include "logFile.hpp"
+#include "rateLimiter.hpp"
+#include "ring.hpp"
 
 #if defined(_WIN32)
 	#include "gen/system/win32/windows.hpp"
@@ -17,220 +30,775 @@ namespace gen::logger
 {
 	namespace
 	{
-		namespace fs = std::filesystem;
-
-		void append_timestamp(std::string & out, Clock::time_point const & timestamp, Timestamp const mode)
+		// formatting "%F %T" is only needed once per second (per thread), so the result is cached.
+		// thread_local avoids any locking, and the reentrant localtime / gmtime variants avoid shared static state.
+		struct TimestampCache
 		{
-			static auto s_mutex{std::mutex{}};
 			static constexpr std::size_t buf_size_v{64};
-			auto buffer		= std::array<char, buf_size_v>{};
-			auto const time = Clock::to_time_t(timestamp);
-			// std::localtime / std::gmtime are not thread safe. cppref:
-			//  pointer to a static internal std::tm object on success, or null pointer otherwise.
-			// The structure may be shared between std::gmtime, std::localtime, and std::ctime,
-			// and may be overwritten on each invocation.
-			auto lock = std::unique_lock{s_mutex};
-			// NOLINTNEXTLINE
-			auto const tm_struct = mode == Timestamp::eUtc ? *std::gmtime(&time) : *std::localtime(&time);
-			lock.unlock();
-			std::strftime(buffer.data(), buffer.size(), "%F %T", &tm_struct);
-			out.append(buffer.data());
+
+			std::int64_t second{std::numeric_limits<std::int64_t>::min()};
+			Timestamp mode{};
+			std::array<char, buf_size_v> buffer{};
+			std::size_t size{};
+		};
+
+		void append_timestamp(std::string & out, Clock::time_point const & timestamp, Timestamp const mode, TimestampPrecision const precision)
+		{
+			thread_local auto t_cache = TimestampCache{};
+
+			auto const since_epoch = std::chrono::duration_cast<std::chrono::microseconds>(timestamp.time_since_epoch());
+			auto const seconds	   = std::chrono::floor<std::chrono::seconds>(since_epoch);
+			if (t_cache.second != seconds.count() || t_cache.mode != mode)
+			{
+				auto const time = static_cast<std::time_t>(seconds.count());
+				auto tm_struct	= std::tm{};
+#if defined(_WIN32)
+				if (mode == Timestamp::eUtc) { gmtime_s(&tm_struct, &time); }
+				else { localtime_s(&tm_struct, &time); }
+#else
+				if (mode == Timestamp::eUtc) { gmtime_r(&time, &tm_struct); }
+				else { localtime_r(&time, &tm_struct); }
+#endif
+				t_cache.second = seconds.count();
+				t_cache.mode   = mode;
+				t_cache.size   = std::strftime(t_cache.buffer.data(), t_cache.buffer.size(), "%F %T", &tm_struct);
+			}
+			out.append(t_cache.buffer.data(), t_cache.size);
+
+			if (precision == TimestampPrecision::eSeconds) { return; }
+			auto const micros = (since_epoch - seconds).count();
+			auto const value  = precision == TimestampPrecision::eMilliseconds ? micros / 1000 : micros;
+			auto const digits = precision == TimestampPrecision::eMilliseconds ? 3 : 6;
+			static constexpr std::size_t buf_size_v{8};
+			auto buffer		  = std::array<char, buf_size_v>{};
+			auto const result = std::to_chars(buffer.data(), buffer.data() + buffer.size(), value);
+			out += '.';
+			// zero pad
+			out.append(static_cast<std::size_t>(digits - (result.ptr - buffer.data())), '0');
+			out.append(buffer.data(), result.ptr);
 		}
 
-		struct Formatter
+		void append_int(std::string & out, int const value)
+		{
+			static constexpr std::size_t buf_size_v{16};
+			auto buffer		  = std::array<char, buf_size_v>{};
+			auto const result = std::to_chars(buffer.data(), buffer.data() + buffer.size(), value);
+			out.append(buffer.data(), result.ptr);
+		}
+
+		///
+		/// \brief Config::format compiled into a list of literal spans and keyword tokens.
+		///
+		/// Built once per Config (when it is set), each log line then just executes the tokens.
+		///
+		struct Pattern
 		{
 			static constexpr auto open_v{'{'};
 			static constexpr auto close_v{'}'};
 
-			// snapshot of formatting-related Config (at the time of Formatter construction).
-			// we make copies instead of referring to Config to avoid mutex locks,
-			// since users can change the active config at any time.
-			struct Data
+			enum class Op : std::uint8_t
 			{
-				// default format string size is 57, which will cause std::string to heap allocate.
-				// thus we use a fixed capacity stack string instead.
-				FixedString<Config::format_size_v> format{};
-				Timestamp timestamp{};
+				eLiteral,
+				eLevel,
+				eThread,
+				eCategory,
+				eMessage,
+				eTimestamp,
+				eFunc,
+				eFile,
+				eLine,
 			};
 
-			// NOLINTNEXTLINE
-			Data const & data;
-			// message and context don't need to be copied, they are unique per call stack.
-			std::string_view message;
-			// NOLINTNEXTLINE
-			Context const & context;
+			struct Token
+			{
+				Op op{};
+				// only used by Op::eLiteral, views into the compiled format string.
+				std::string_view literal{};
+			};
+
+			struct Keyword
+			{
+				std::string_view key{};
+				Op op{};
+			};
+
+			static constexpr auto keywords_v = std::array{
+				Keyword{"level", Op::eLevel},
+				Keyword{"thread", Op::eThread},
+				Keyword{"category", Op::eCategory},
+				Keyword{"message", Op::eMessage},
+				Keyword{"timestamp", Op::eTimestamp},
+				Keyword{"func", Op::eFunc},
+				Keyword{"file", Op::eFile},
+				Keyword{"line", Op::eLine},
+			};
+
+			std::vector<Token> tokens{};
+			std::size_t literalSize{};
+
+			///
+			/// \brief Compile format into tokens.
+			/// \param format Format specification, must outlive the Pattern.
+			///
+			static Pattern compile(std::string_view format)
+			{
+				auto ret		   = Pattern{};
+				auto literal_begin = format.data();
+				auto push_literal  = [&](char const * literal_end)
+				{
+					if (literal_end == literal_begin) { return; }
+					auto const literal = std::string_view{literal_begin, static_cast<std::size_t>(literal_end - literal_begin)};
+					ret.tokens.push_back(Token{.op = Op::eLiteral, .literal = literal});
+					ret.literalSize += literal.size();
+				};
 
-			// output string (formatted)
-			std::string out{};
-			// remaining input
-			std::string_view format{data.format};
-			// current character (preceding format)
-			char current{};
+				while (!format.empty())
+				{
+					// text not matching any format keys is passed through (including unmatched braces).
+					auto const open = format.find(open_v);
+					if (open == std::string_view::npos) { break; }
+					auto const close = format.find(close_v, open + 1);
+					if (close == std::string_view::npos) { break; }
+					auto const key	   = format.substr(open + 1, close - open - 1);
+					auto const keyword = std::ranges::find(keywords_v, key, &Keyword::key);
+					if (keyword == keywords_v.end())
+					{
+						// not a keyword: keep the brace as literal text and resume scanning after it
+						format = format.substr(open + 1);
+						continue;
+					}
+					push_literal(format.data() + open);
+					ret.tokens.push_back(Token{.op = keyword->op});
+					format		  = format.substr(close + 1);
+					literal_begin = format.data();
+				}
+				push_literal(format.data() + format.size());
+				return ret;
+			}
 
-			[[nodiscard]] bool at_end() const { return format.empty(); }
+			[[nodiscard]] std::string operator()(std::string_view const message, Context const & context, Config const & config) const
+			{
+				static constexpr std::size_t reserve_v{64};
+				auto out = std::string{};
+				out.reserve(literalSize + message.size() + context.category.size() + reserve_v);
+				for (auto const & token : tokens)
+				{
+					switch (token.op)
+					{
+					case Op::eLiteral: out.append(token.literal); break;
+					case Op::eLevel: out += levelChar(context.level); break;
+					case Op::eThread: append_int(out, static_cast<int>(context.thread)); break;
+					case Op::eCategory: out.append(context.category); break;
+					case Op::eMessage: out.append(message); break;
+					case Op::eTimestamp: append_timestamp(out, context.timestamp, config.timestamp, config.timestampPrecision); break;
+					case Op::eFunc:
+						if (context.func.has_value()) { out.append(*context.func); }
+						break;
+					case Op::eFile:
+						if (context.file.has_value()) { out.append(*context.file); }
+						break;
+					case Op::eLine:
+						if (context.line.has_value()) { append_int(out, *context.line); }
+						break;
+					}
+				}
+				out += '\n';
+				return out;
+			}
+		};
+	} // namespace
 
-			bool advance()
+	namespace
+	{
+		///
+		/// \brief Push value into ring, applying the Overflow policy when it is full.
+		/// \param wake Wakes the ring's consumer.
+		///
+		template <typename Type, typename Func>
+		void push_to(Ring<Type> & ring, Type & value, Overflow const overflow, std::atomic<std::uint64_t> & dropped, Func wake)
+		{
+			while (!ring.tryPush(value))
 			{
-				if (at_end())
+				switch (overflow)
+				{
+				case Overflow::eDropNewest: dropped.fetch_add(1, std::memory_order_relaxed); return;
+				case Overflow::eDropOldest:
 				{
-					// reset current
-					current = {};
-					return false;
+					// make room by discarding the oldest value ourselves
+					auto oldest = Type{};
+					if (ring.tryPop(oldest)) { dropped.fetch_add(1, std::memory_order_relaxed); }
+					break;
+				}
+				default:
+					// make sure the consumer is awake, then back off
+					wake();
+					std::this_thread::yield();
+					break;
 				}
-				current = format.front();
-				format	= format.substr(1);
-				return true;
 			}
+		}
+
+		struct ConsoleSink : Sink
+		{
+			static constexpr std::size_t capacity_v{1024};
 
-			bool try_keyword()
+			struct Line
 			{
-				assert(current == open_v);
-				auto const close = format.find_first_of(close_v);
-				if (close == std::string_view::npos) { return false; }
+				std::string text{};
+				bool error{};
+			};
+
+			Ring<Line> ring{capacity_v};
+			// lines discarded due to Overflow policy, reported by the writer thread
+			std::atomic<std::uint64_t> dropped{};
+			// bumped to wake the writer thread, which sleeps on this
+			std::atomic<std::uint32_t> pending{};
+			// set while the writer thread is (about to be) asleep
+			std::atomic<bool> sleeping{};
+			// cached from the active Config
+			std::atomic<Overflow> overflow{};
+			std::atomic<bool> syncErrors{};
+
+			// serializes writing to the streams: held by the writer thread and by synchronous errors
+			std::mutex mutex{};
+			// guarded by mutex
+			std::string chunk{};
 
-				auto const key = format.substr(0, close);
-				if (!keyword(key)) { return false; }
+			// thread must be destroyed first (so it can drain the ring)
+			std::jthread thread{};
+
+			ConsoleSink() : thread([this](std::stop_token const & stop) { run(stop); }) {}
 
-				// advance to beyond }
-				format = format.substr(close + 1);
-				return true;
+			void wake()
+			{
+				pending.fetch_add(1, std::memory_order_release);
+				pending.notify_one();
 			}
 
-			bool keyword(std::string_view key)
+			void run(std::stop_token const & stop)
 			{
-				if (key == "level")
+				auto const on_stop = std::stop_callback{stop, [this] { wake(); }};
+				while (true)
 				{
-					out += levelChar(context.level);
-					return true;
+					{
+						auto lock = std::unique_lock{mutex};
+						if (drain()) { continue; }
+					}
+					if (stop.stop_requested()) { break; }
+					// sleep until something is pushed, see FileSink::run
+					auto const seen = pending.load(std::memory_order_acquire);
+					sleeping.store(true, std::memory_order_relaxed);
+					std::atomic_thread_fence(std::memory_order_seq_cst);
+					if (ring.empty()) { pending.wait(seen, std::memory_order_acquire); }
+					sleeping.store(false, std::memory_order_relaxed);
 				}
+			}
+
+			// caller must hold mutex
+			void write(std::string_view const text, bool const error)
+			{
+				if (text.empty()) { return; }
+				// pick stdout / stderr based on level
+				auto & stream = error ? std::cerr : std::cout;
+				stream.write(text.data(), static_cast<std::streamsize>(text.size()));
+				stream.flush();
+#if defined(_WIN32)
+				OutputDebugStringA(std::string{text}.c_str());
+#endif
+			}
 
-				if (key == "thread")
+			// caller must hold mutex
+			// coalesces consecutive lines of the same stream into one write, keeping stdout / stderr interleaving intact
+			bool drain()
+			{
+				auto line	   = Line{};
+				auto error	   = false;
+				auto popped	   = false;
+				auto remaining = ring.capacity();
+				chunk.clear();
+				while (remaining-- > 0 && ring.tryPop(line))
+				{
+					popped = true;
+					if (line.error != error)
+					{
+						write(chunk, error);
+						chunk.clear();
+						error = line.error;
+					}
+					chunk.append(line.text);
+				}
+				write(chunk, error);
+				chunk.clear();
+				if (auto const count = dropped.exchange(0, std::memory_order_relaxed); count > 0)
 				{
-					std::format_to(std::back_inserter(out), "{}", static_cast<int>(context.thread));
-					return true;
+					write(std::format("[W] [logger] {} log record(s) dropped, console sink overflowed\n", count), false);
 				}
+				return popped;
+			}
 
-				if (key == "category")
+			void handle(std::string_view const formatted, Context const & context) final
+			{
+				auto const error = context.level == Level::eError;
+				if (error && syncErrors.load(std::memory_order_relaxed))
 				{
-					out += context.category;
-					return true;
+					// write everything queued before this error, then the error itself, before returning
+					auto lock = std::unique_lock{mutex};
+					drain();
+					write(formatted, true);
+					return;
 				}
+				auto line = Line{.text = std::string{formatted}, .error = error};
+				push_to(ring, line, overflow.load(std::memory_order_relaxed), dropped, [this] { wake(); });
+				// pairs with the fence in run(): either the writer sees the pushed line, or we see it sleeping
+				std::atomic_thread_fence(std::memory_order_seq_cst);
+				if (sleeping.load(std::memory_order_relaxed)) { wake(); }
+			}
+		};
+
+		///
+		/// \brief Record queued for the file sink's writer thread.
+		///
+		/// Either a formatted line, or a deferred log: format string plus encoded arguments.
+		///
+		struct Record
+		{
+			// formatted line, or category followed by encoded arguments for deferred records
+			std::string bytes{};
+			// deferred records only: format string (static storage duration)
+			std::string_view format{};
+			// only the timestamp is set for text records, deferred records have a full context (category is stored in bytes)
+			Context context{};
+			std::size_t categorySize{};
+			Target target{};
+
+			static Record text(std::string line, Context const & context)
+			{
+				return Record{.bytes = std::move(line), .context = Context{.timestamp = context.timestamp}};
+			}
+
+			[[nodiscard]] bool isDeferred() const { return format.data() != nullptr; }
+			[[nodiscard]] std::string_view category() const { return std::string_view{bytes}.substr(0, categorySize); }
+			[[nodiscard]] std::string_view args() const { return std::string_view{bytes}.substr(categorySize); }
+		};
+
+		///
+		/// \brief Serializes records for DeferredOutput::eBinary, see binary.hpp for the layout.
+		///
+		struct BinaryWriter
+		{
+			// format strings already defined in the current file
+			std::unordered_map<std::string_view, std::uint32_t> formats{};
+
+			static void header(std::string & out)
+			{
+				out.append(binary::magic_v);
+				binary::write(out, binary::version_v);
+				binary::write(out, binary::endian_v);
+			}
 
-				if (key == "message")
+			static void text(std::string & out, std::string_view const line)
+			{
+				binary::write(out, binary::RecordKind::eText);
+				binary::writeString(out, line);
+			}
+
+			void log(std::string & out, Record const & record)
+			{
+				auto const [itr, inserted] = formats.try_emplace(record.format, static_cast<std::uint32_t>(formats.size()));
+				if (inserted)
 				{
-					out.append(message);
-					return true;
+					binary::write(out, binary::RecordKind::eFormat);
+					binary::write(out, itr->second);
+					binary::writeString(out, record.format);
 				}
+				auto const & context = record.context;
+				auto const micros	 = std::chrono::duration_cast<std::chrono::microseconds>(context.timestamp.time_since_epoch()).count();
+				binary::write(out, binary::RecordKind::eLog);
+				binary::write(out, itr->second);
+				binary::write(out, static_cast<std::uint8_t>(context.level));
+				binary::write(out, static_cast<std::int32_t>(context.thread));
+				binary::write(out, static_cast<std::int64_t>(micros));
+				binary::writeString(out, record.category());
+				auto const has_location = context.func.has_value() && context.file.has_value() && context.line.has_value();
+				binary::write(out, static_cast<std::uint8_t>(has_location ? 1 : 0));
+				if (has_location)
+				{
+					binary::writeString(out, *context.func);
+					binary::writeString(out, *context.file);
+					binary::write(out, static_cast<std::int32_t>(*context.line));
+				}
+				binary::writeString(out, record.args());
+			}
+		};
+
+		struct FileSink : Sink
+		{
+			// shared ring, used by threads without a staging slot
+			static constexpr std::size_t capacity_v{4096};
+			// staging slots, indexed by Context::getThreadId()
+			static constexpr std::size_t staging_slots_v{64};
+			static constexpr std::size_t staging_capacity_v{1024};
+
+			///
+			/// \brief Formats a deferred record and dispatches it to the given non-file Targets, on the writer thread.
+			///
+			using Render = std::function<std::string(Record const &, Target)>;
+
+			///
+			/// \brief Called on the writer thread at least every tick_interval_v, for work no push wakes it up for.
+			///
+			using Tick = std::function<void()>;
+
+			static constexpr std::chrono::milliseconds tick_interval_v{500};
+
+			///
+			/// \brief Per thread ring: only its owning thread pushes, so producers never contend on a cache line.
+			///
+			struct Staging
+			{
+				// created on first use by the owning thread, read by the writer thread
+				std::atomic<Ring<Record> *> ring{};
+
+				Staging() = default;
+				~Staging() { auto const owned = std::unique_ptr<Ring<Record>>{ring.load(std::memory_order_acquire)}; }
+
+				Staging(Staging &&)				= delete;
+				Staging & operator=(Staging &&) = delete;
 
-				if (key == "timestamp")
+				Staging(Staging const &)			 = delete;
+				Staging & operator=(Staging const &) = delete;
+			};
+
+			std::string path{};
+			Rotation rotation{};
+			std::chrono::milliseconds syncInterval{};
+			DeferredOutput output{};
+			Render render{};
+			Tick tick{};
+			std::array<Staging, staging_slots_v> staging{};
+			Ring<Record> shared{capacity_v};
+			// records discarded due to Overflow policy, reported by the writer thread
+			std::atomic<std::uint64_t> dropped{};
+			// bumped to wake the writer thread, which sleeps on woken until this changes or its next tick
+			std::atomic<std::uint32_t> pending{};
+			std::mutex wakeMutex{};
+			std::condition_variable woken{};
+			// set while the writer thread is (about to be) asleep, producers only touch pending then
+			std::atomic<bool> sleeping{};
+
+			// thread must be destroyed first (so it can drain the rings)
+			std::jthread thread{};
+
+			FileSink(std::string file_path, Config const & config, Render render, Tick tick)
+				: path(std::move(file_path)), rotation(config.rotation), syncInterval(config.syncInterval), output(config.deferredOutput),
+				  render(std::move(render)), tick(std::move(tick)), thread([this](std::stop_token const & stop) { run(stop); })
+			{
+			}
+
+			void wake()
+			{
 				{
-					append_timestamp(out, context.timestamp, data.timestamp);
-					return true;
+					// bumped under the lock, or the writer could miss it between checking pending and waiting
+					auto lock = std::scoped_lock{wakeMutex};
+					pending.fetch_add(1, std::memory_order_release);
 				}
+				woken.notify_one();
+			}
+
+			// called by producers after pushing
+			void notify()
+			{
+				// pairs with the fence in run(): either the writer sees the pushed record, or we see it sleeping
+				std::atomic_thread_fence(std::memory_order_seq_cst);
+				if (sleeping.load(std::memory_order_relaxed)) { wake(); }
+			}
 
-				if (key == "func")
+			Ring<Record> & ring()
+			{
+				auto const index = static_cast<std::size_t>(Context::getThreadId());
+				if (index >= staging.size()) { return shared; }
+				auto & slot = staging[index].ring;
+				auto * ret	= slot.load(std::memory_order_relaxed);
+				if (ret == nullptr)
 				{
-					if (context.func.has_value()) { out += context.func.value(); }
-					return true;
+					// only this thread ever creates its slot
+					ret = std::make_unique<Ring<Record>>(staging_capacity_v).release();
+					slot.store(ret, std::memory_order_release);
 				}
+				return *ret;
+			}
 
-				if (key == "file")
+			template <typename Func>
+			void forEachRing(Func func)
+			{
+				for (auto & slot : staging)
 				{
-					if (context.file.has_value()) { out += context.file.value(); }
-					return true;
+					if (auto * ring = slot.ring.load(std::memory_order_acquire)) { func(*ring); }
 				}
+				func(shared);
+			}
 
-				if (key == "line")
+			bool empty()
+			{
+				auto ret = true;
+				forEachRing([&ret](Ring<Record> const & ring) { ret = ret && ring.empty(); });
+				return ret;
+			}
+
+			void run(std::stop_token const & stop)
+			{
+				// keep the file open for the lifetime of the sink (creating / truncating it)
+				auto file = LogFile{path, rotation, syncInterval};
+				if (output == DeferredOutput::eBinary)
 				{
-					if (context.line.has_value()) { std::format_to(std::back_inserter(out), "{}", context.line.value()); }
-					return true;
+					auto header = std::string{};
+					BinaryWriter::header(header);
+					file.write(std::span{&header, 1});
+				}
+				// wake up on stop request
+				auto const on_stop = std::stop_callback{stop, [this] { wake(); }};
+				// records are moved out of the rings into this batch while producers keep filling them
+				auto batch	= std::vector<Record>{};
+				auto record = Record{};
+				auto binary = BinaryWriter{};
+				batch.reserve(capacity_v);
+				auto nextTick = std::chrono::steady_clock::now() + tick_interval_v;
+				// loop until stopped
+				while (true)
+				{
+					if (auto const now = std::chrono::steady_clock::now(); now >= nextTick)
+					{
+						tick();
+						nextTick = now + tick_interval_v;
+					}
+					// drain rings, even if stop requested (at most one ring's worth each, so a busy thread can't starve the rest)
+					forEachRing(
+						[&](Ring<Record> & ring)
+						{
+							for (auto count = ring.capacity(); count > 0 && ring.tryPop(record); --count) { batch.push_back(std::move(record)); }
+						});
+					if (auto const count = dropped.exchange(0, std::memory_order_relaxed); count > 0)
+					{
+						auto message = std::format("[W] [logger] {} log record(s) dropped, file sink overflowed\n", count);
+						batch.push_back(Record{.bytes = std::move(message), .context = Context{.timestamp = Clock::now()}});
+					}
+					if (!batch.empty())
+					{
+						// each ring is already in order, merge them
+						std::stable_sort(batch.begin(), batch.end(), [](Record const & a, Record const & b) { return a.context.timestamp < b.context.timestamp; });
+						if (output == DeferredOutput::eBinary) { writeBinary(file, binary, batch); }
+						else { writeText(file, batch); }
+						file.sync();
+						batch.clear();
+						continue;
+					}
+					if (stop.stop_requested()) { break; }
+					// sleep until something is pushed, or the next tick is due
+					auto const seen = pending.load(std::memory_order_acquire);
+					sleeping.store(true, std::memory_order_relaxed);
+					std::atomic_thread_fence(std::memory_order_seq_cst);
+					if (empty())
+					{
+						auto lock = std::unique_lock{wakeMutex};
+						woken.wait_until(lock, nextTick, [&] { return pending.load(std::memory_order_acquire) != seen; });
+					}
+					sleeping.store(false, std::memory_order_relaxed);
 				}
+			}
 
-				return false;
+			void writeText(LogFile & file, std::vector<Record> & batch)
+			{
+				auto lines = std::vector<std::string>{};
+				lines.reserve(batch.size());
+				for (auto & record : batch)
+				{
+					if (!record.isDeferred())
+					{
+						lines.push_back(std::move(record.bytes));
+						continue;
+					}
+					auto line = render(record, Target{.value = record.target.value & ~file_v.value});
+					if ((record.target & file_v) == file_v) { lines.push_back(std::move(line)); }
+				}
+				file.write(lines);
 			}
 
-			std::string operator()()
+			void writeBinary(LogFile & file, BinaryWriter & writer, std::vector<Record> const & batch)
 			{
-				static constexpr std::size_t reserve_v{128};
-				out.reserve(message.size() + reserve_v);
-				while (advance())
+				auto chunk			 = std::string{};
+				auto scratch		 = std::string{};
+				auto const serialize = [&](Record const & record)
+				{
+					scratch.clear();
+					if (record.isDeferred()) { writer.log(scratch, record); }
+					else { BinaryWriter::text(scratch, record.bytes); }
+				};
+				for (auto const & record : batch)
 				{
-					if (current == open_v && try_keyword()) { continue; }
-					out += current;
+					if (record.isDeferred())
+					{
+						// other targets still get formatted text
+						if ((record.target & ~file_v.value) != 0) { render(record, Target{.value = record.target.value & ~file_v.value}); }
+						if ((record.target & file_v) != file_v) { continue; }
+					}
+					serialize(record);
+					if (file.wouldRotate(chunk.size(), scratch.size()))
+					{
+						// every file must be decodable on its own: restart with a header and redefine formats
+						file.write(std::span{&chunk, 1});
+						file.rotate();
+						chunk.clear();
+						writer.formats.clear();
+						BinaryWriter::header(chunk);
+						serialize(record);
+					}
+					chunk.append(scratch);
 				}
-				out.append("\n");
-				return std::move(out);
+				file.write(std::span{&chunk, 1});
 			}
-		};
-	} // namespace
 
-	namespace
-	{
-		struct ConsoleSink : Sink
-		{
-			void handle(std::string_view const formatted, Context const & context) final
+			void push(Record record, Overflow const overflow)
 			{
-				// pick stdout / stderr based on level
-				auto & stream = context.level == Level::eError ? std::cerr : std::cout;
-				// thread-safe: operator<< is atomic
-				stream << formatted;
-#if defined(_WIN32)
-				// assuming null terminated string (which it is)
-				OutputDebugStringA(formatted.data());
-#endif
+				push_to(ring(), record, overflow, dropped, [this] { wake(); });
+				notify();
 			}
+
+			void handle(std::string_view const formatted, Context const & context) final { push(Record::text(std::string{formatted}, context), Overflow::eBlock); }
 		};
 
-		struct FileSink : Sink
+		std::uint64_t mix(std::uint64_t value)
 		{
-			std::string path{};
+			// splitmix64 finalizer
+			value = (value ^ (value >> 30)) * 0xbf58476d1ce4e5b9;
+			value = (value ^ (value >> 27)) * 0x94d049bb133111eb;
+			return value ^ (value >> 31);
+		}
+
+		std::uint64_t address(std::string_view const text)
+		{
+			// NOLINTNEXTLINE
+			return static_cast<std::uint64_t>(reinterpret_cast<std::uintptr_t>(text.data()));
+		}
+
+		// file and line when known, else category and format string
+		std::uint64_t site_key(std::string_view const category, CallSite const & site)
+		{
+			auto const key = site.file.empty() ? mix(address(category) ^ mix(address(site.format))) : mix(address(site.file) ^ mix(static_cast<std::uint64_t>(site.line)));
+			return key == 0 ? 1 : key;
+		}
+
+		///
+		/// \brief Last log of a thread, for collapsing repeats.
+		///
+		/// Registered with the Impl, so its writer thread can report a count the thread stopped adding to.
+		///
+		struct Repeats
+		{
+			// taken by the owning thread for every log it collapses, and by the writer thread's tick
 			std::mutex mutex{};
-			std::string buffer{};
+			// the Impl this is registered with, cleared once it is destroyed
+			std::atomic<void const *> owner{};
+			std::uint64_t hash{};
+			std::uint64_t count{};
+			Clock::time_point since{};
+			// owned: the Logger may not outlive the report
+			std::string category{};
+			ThreadId thread{};
+			Level level{};
+			bool valid{};
+		};
 
-			// cv must outlive thread (so it receives the stop signal)
-			std::condition_variable_any cv{};
-			// thread must be destroyed before cv (so it can signal stop)
-			std::jthread thread{};
+		///
+		/// \brief A "last message repeated" log, taken out of Repeats to be dispatched without holding its mutex.
+		///
+		struct RepeatReport
+		{
+			std::uint64_t count{};
+			std::string category{};
+			ThreadId thread{};
+			Level level{};
+		};
 
-			FileSink(std::string file_path) : path(std::move(file_path)), thread([this](std::stop_token const & stop) { run(stop); }) {}
+		// caller must hold repeats.mutex
+		std::optional<RepeatReport> take_report(Repeats & repeats, Clock::time_point const now)
+		{
+			if (repeats.count == 0) { return {}; }
+			auto ret	  = RepeatReport{.count = repeats.count, .category = repeats.category, .thread = repeats.thread, .level = repeats.level};
+			repeats.count = 0;
+			repeats.since = now;
+			return ret;
+		}
+	} // namespace
 
-			void run(std::stop_token const & stop)
+	struct Instance::Impl
+	{
+		///
+		/// \brief Immutable, versioned view of the active Config.
+		///
+		/// Published through an atomic shared pointer: readers never lock,
+		/// setConfig swaps in a new Snapshot and the old one dies with its last reader.
+		///
+		struct Snapshot
+		{
+			Config config{};
+			std::uint64_t version{};
+			std::array<Target, static_cast<std::size_t>(Level::eCOUNT_)> targets{};
+			// views into config.format, hence snapshots are neither copied nor moved
+			Pattern pattern{};
+
+			Snapshot(Config in, std::uint64_t const version) : config(std::move(in)), version(version)
 			{
-				// remove existing log file
-				if (fs::exists(path)) { fs::remove(path); }
-				// loop until stopped
-				while (!stop.stop_requested())
+#ifdef GEN_VERBOSE_LOGGING
+				config.format = Config::verbose_format_v;
+#endif
+				pattern = Pattern::compile(config.format);
+				// flatten levelTargets into a table indexed by Level
+				for (auto & target : targets) { target = all_v; }
+				for (auto const & [level, target] : config.levelTargets)
 				{
-					auto lock = std::unique_lock{mutex};
-					// sleep until buffer is not empty
-					cv.wait(lock, stop, [this] { return !buffer.empty(); });
-					if (buffer.empty()) { continue; }
-					// drain buffer into file, even if stop requested
-					if (auto file = std::ofstream{path, std::ios::binary | std::ios::app})
-					{
-						file << buffer;
-						buffer.clear();
-					}
+					if (level < Level::eCOUNT_) { targets[static_cast<std::size_t>(level)] = target; }
 				}
 			}
 
-			void handle(std::string_view const formatted, [[maybe_unused]] Context const & context) final
+			// most verbose Level enabled by maxLevel or any category override
+			[[nodiscard]] Level threshold() const
 			{
-				auto lock = std::unique_lock{mutex};
-				// append to the existing buffer
-				buffer.append(formatted);
-				lock.unlock();
-				// notify writing thread
-				cv.notify_one();
+				auto ret = config.maxLevel;
+				for (auto const & [category, level] : config.categoryMaxLevels) { ret = std::max(ret, level); }
+				return ret;
+			}
+
+			[[nodiscard]] bool isEnabled(Level const level, std::string_view const category) const
+			{
+				if (auto const itr = config.categoryMaxLevels.find(category); itr != config.categoryMaxLevels.end()) { return level <= itr->second; }
+				return level <= config.maxLevel;
 			}
+
+			[[nodiscard]] Target target(Level const level) const { return targets[static_cast<std::size_t>(level)]; }
+
+			Snapshot(Snapshot &&)			  = delete;
+			Snapshot & operator=(Snapshot &&) = delete;
+
+			Snapshot(Snapshot const &)			   = delete;
+			Snapshot & operator=(Snapshot const &) = delete;
 		};
-	} // namespace
 
-	struct Instance::Impl
-	{
-		std::vector<std::unique_ptr<Sink>> sinks{};
-		Config config{};
+		std::atomic<std::shared_ptr<Snapshot const>> snapshot{};
+		// cached Snapshot::threshold, rejects most filtered out logs without touching the snapshot
+		std::atomic<Level> threshold{};
+
+		// guards sinks and serializes setConfig
 		std::mutex mutex{};
+		std::vector<std::unique_ptr<Sink>> sinks{};
+		std::atomic<bool> hasSinks{};
+
+		RateLimiter limiter{};
+		// cached Snapshot::config.rateLimit.burst > 0
+		std::atomic<bool> limiting{};
+
+		// guards threadRepeats, the registry of every thread's Repeats
+		std::mutex repeatsMutex{};
+		std::vector<std::shared_ptr<Repeats>> threadRepeats{};
 
 		ConsoleSink console{};
 		FileSink file;
@@ -241,49 +809,213 @@ namespace gen::logger
 			return input;
 		}
 
-		Impl(char const * filePath) : file(nonEmptyFilePath(filePath)) {}
+		Impl(char const * filePath, Config const & config)
+			: file(
+				  nonEmptyFilePath(filePath), config, [this](Record const & record, Target const outputs) { return renderDeferred(record, outputs); },
+				  [this] { reportRepeats(false); })
+		{
+		}
 
-		void print(std::string_view const message, Context const & context)
+		// caller must hold mutex
+		void publish(Config config)
 		{
-			// config is shared state, must synchronize access
-			auto lock = std::unique_lock{mutex};
-			if (auto const itr = config.categoryMaxLevels.find(context.category); itr != config.categoryMaxLevels.end())
+			auto const previous = snapshot.load(std::memory_order_relaxed);
+			auto next			= std::make_shared<Snapshot const>(std::move(config), previous ? previous->version + 1 : 0);
+			threshold.store(next->threshold(), std::memory_order_relaxed);
+			limiting.store(next->config.rateLimit.burst > 0, std::memory_order_relaxed);
+			console.overflow.store(next->config.overflow, std::memory_order_relaxed);
+			console.syncErrors.store(next->config.syncErrors, std::memory_order_relaxed);
+			snapshot.store(std::move(next), std::memory_order_release);
+		}
+
+		bool isEnabled(Level const level, std::string_view const category) const
+		{
+			// cheap early out, no refcounting involved
+			if (level > threshold.load(std::memory_order_relaxed)) { return false; }
+			auto const config = snapshot.load(std::memory_order_acquire);
+			return config && config->isEnabled(level, category);
+		}
+
+		bool admit(Level const level, std::string_view const category, CallSite const & site)
+		{
+			// cheap early out, no refcounting involved
+			if (!limiting.load(std::memory_order_relaxed)) { return true; }
+			auto const config = snapshot.load(std::memory_order_acquire);
+			if (!config || config->config.rateLimit.burst == 0) { return true; }
+
+			auto const result = limiter.admit(site_key(category, site), config->config.rateLimit, RateLimiter::Clock::now());
+			if (result.suppressed > 0)
 			{
-				if (context.level > itr->second) { return; }
+				dispatch(std::format("{} similar log(s) suppressed by rate limit", result.suppressed), Context::make(category, level), *config);
 			}
-			else if (context.level > config.maxLevel) { return; }
-			auto const target = [&]
-			{
-				if (auto const itr = config.levelTargets.find(context.level); itr != config.levelTargets.end()) { return itr->second; }
-				return all_v;
-			}();
+			return result.admitted;
+		}
 
-#ifdef GEN_VERBOSE_LOGGING
-			config.format = Config::verbose_format_v;
-#endif
+		void print(std::string_view const message, Context const & context)
+		{
+			// cheap early out, no refcounting involved
+			if (context.level > threshold.load(std::memory_order_relaxed)) { return; }
 
-			auto const data = Formatter::Data{.format = config.format, .timestamp = config.timestamp};
-			// cache this for later use
-			auto const sinks_empty = sinks.empty();
-			// config access complete, release lock
-			lock.unlock();
+			// the snapshot is immutable and kept alive by this reference, no locks required
+			auto const config = snapshot.load(std::memory_order_acquire);
+			if (!config || !config->isEnabled(context.level, context.category)) { return; }
+			if (config->config.collapseRepeats && collapse(mix(std::hash<std::string_view>{}(message)), context, *config)) { return; }
 
-			auto const formatted = Formatter{.data = data, .message = message, .context = context}();
+			dispatch(message, context, *config);
+		}
 
-			// console has no state, no sync required
+		void dispatch(std::string_view const message, Context const & context, Snapshot const & config)
+		{
+			dispatch(message, context, config, config.config.overflow);
+		}
+
+		void dispatch(std::string_view const message, Context const & context, Snapshot const & config, Overflow const overflow)
+		{
+			auto const target = config.target(context.level);
+
+			auto formatted = config.pattern(message, context, config.config);
+
+			// console is lock-free (unless errors are written synchronously)
 			if ((target & console_v) == console_v) { console.handle(formatted, context); }
-			// file maintains its own sync
-			if ((target & file_v) == file_v) { file.handle(formatted, context); }
 
-			if ((target & sinks_v) == sinks_v && !sinks_empty)
+			if ((target & sinks_v) == sinks_v && hasSinks.load(std::memory_order_acquire))
 			{
-				// sinks are also shared state, obtain lock again
-				// TOCTOU slip throughs are possible due to sinks_empty being stale by this point,
-				// but we get to avoid the redundant lock entirely when there are no sinks.
-				lock.lock();
+				// sinks are shared state, obtain lock
+				// checking hasSinks first lets us avoid the lock entirely when there are no sinks.
+				auto lock = std::unique_lock{mutex};
 				// the game is expected to have zero or one sinks (for Dear ImGui), so we just invoke sink->handle under the lock.
 				for (auto const & sink : sinks) { sink->handle(formatted, context); }
 			}
+
+			// file is lock-free, hand it the formatted string last to avoid a copy
+			if ((target & file_v) == file_v) { file.push(Record::text(std::move(formatted), context), overflow); }
+		}
+
+		///
+		/// \brief Count a log that repeats the calling thread's previous one instead of printing it.
+		/// \param hash Hash of the message.
+		/// \returns true if the log was collapsed.
+		///
+		bool collapse(std::uint64_t hash, Context const & context, Snapshot const & config)
+		{
+			auto & repeats = repeatsOfThread();
+			hash		   = mix(hash ^ mix(address(context.category)) ^ static_cast<std::uint64_t>(context.level));
+
+			auto report	   = std::optional<RepeatReport>{};
+			auto collapsed = false;
+			{
+				auto lock = std::scoped_lock{repeats.mutex};
+				if (repeats.valid && repeats.hash == hash)
+				{
+					++repeats.count;
+					collapsed = true;
+					// a message repeating forever still reports periodically
+					if (context.timestamp - repeats.since >= config.config.reportInterval) { report = take_report(repeats, context.timestamp); }
+				}
+				else
+				{
+					report			 = take_report(repeats, context.timestamp);
+					repeats.hash	 = hash;
+					repeats.since	 = context.timestamp;
+					repeats.category = context.category;
+					repeats.thread	 = context.thread;
+					repeats.level	 = context.level;
+					repeats.valid	 = true;
+				}
+			}
+			// dispatched unlocked: it may wait on the writer thread, whose tick takes the mutex
+			if (report) { dispatchReport(*report, context.timestamp, config, config.config.overflow); }
+			return collapsed;
+		}
+
+		///
+		/// \brief Obtain the calling thread's Repeats, registering it on first use.
+		///
+		Repeats & repeatsOfThread()
+		{
+			thread_local auto t_repeats = std::shared_ptr<Repeats>{};
+			if (!t_repeats || t_repeats->owner.load(std::memory_order_relaxed) != this)
+			{
+				// never registered, or with a previous Instance
+				t_repeats = std::make_shared<Repeats>();
+				t_repeats->owner.store(this, std::memory_order_relaxed);
+				auto lock = std::scoped_lock{repeatsMutex};
+				threadRepeats.push_back(t_repeats);
+			}
+			return *t_repeats;
+		}
+
+		///
+		/// \brief Report the counts threads have held back, which they would only report when logging again.
+		/// \param all Report every count rather than those held back for reportInterval, and wait for room in the rings.
+		///
+		void reportRepeats(bool const all)
+		{
+			auto const config = snapshot.load(std::memory_order_acquire);
+			if (!config) { return; }
+			auto const now	   = Clock::now();
+			auto const heldFor = all ? Clock::duration::zero() : std::chrono::duration_cast<Clock::duration>(config->config.reportInterval);
+
+			auto reports = std::vector<RepeatReport>{};
+			{
+				auto lock = std::scoped_lock{repeatsMutex};
+				std::erase_if(threadRepeats,
+							  [&](std::shared_ptr<Repeats> const & repeats)
+							  {
+								  auto repeatsLock = std::scoped_lock{repeats->mutex};
+								  if (now - repeats->since >= heldFor)
+								  {
+									  if (auto report = take_report(*repeats, now)) { reports.push_back(std::move(*report)); }
+								  }
+								  // a thread that exited leaves only the registry's reference, dropped once nothing is held back
+								  return repeats.use_count() == 1 && repeats->count == 0;
+							  });
+			}
+			// the writer thread ticks, it must not wait for room in its own rings
+			auto const overflow = all ? config->config.overflow : Overflow::eDropNewest;
+			for (auto const & report : reports) { dispatchReport(report, now, *config, overflow); }
+		}
+
+		void dispatchReport(RepeatReport const & report, Clock::time_point const timestamp, Snapshot const & config, Overflow const overflow)
+		{
+			auto const message = std::format("last message repeated {} time(s)", report.count);
+			dispatch(message, Context{.category = report.category, .timestamp = timestamp, .thread = report.thread, .level = report.level}, config, overflow);
+		}
+
+		void printDeferred(std::string_view const format, std::string_view const args, Context const & context)
+		{
+			if (context.level > threshold.load(std::memory_order_relaxed)) { return; }
+			auto const config = snapshot.load(std::memory_order_acquire);
+			if (!config || !config->isEnabled(context.level, context.category)) { return; }
+			if (config->config.collapseRepeats)
+			{
+				// format strings have static storage, so the address identifies the format
+				if (collapse(mix(address(format)) ^ std::hash<std::string_view>{}(args), context, *config)) { return; }
+			}
+
+			// no formatting here: the writer thread formats (or serializes) the record for every target.
+			auto record = Record{.format = format, .context = context, .categorySize = context.category.size(), .target = config->target(context.level)};
+			record.bytes.reserve(context.category.size() + args.size());
+			record.bytes.append(context.category).append(args);
+			record.context.category = {};
+			file.push(std::move(record), config->config.overflow);
+		}
+
+		// called on the file sink's writer thread
+		std::string renderDeferred(Record const & record, Target const outputs)
+		{
+			auto const config = snapshot.load(std::memory_order_acquire);
+			auto context	  = record.context;
+			context.category  = record.category();
+			auto const line	  = config->pattern(binary::render(record.format, record.args()), context, config->config);
+
+			if ((outputs & console_v) == console_v) { console.handle(line, context); }
+			if ((outputs & sinks_v) == sinks_v && hasSinks.load(std::memory_order_acquire))
+			{
+				auto lock = std::unique_lock{mutex};
+				for (auto const & sink : sinks) { sink->handle(line, context); }
+			}
+			return line;
 		}
 	};
 
@@ -293,34 +1025,45 @@ namespace gen::logger
 		delete ptr;
 	}
 
-	Instance::Instance(char const * filePath, Config config) : m_impl(new Impl{filePath})
+	Instance::Instance(char const * filePath, Config config) : m_impl(new Impl{filePath, config})
 	{
 		if (s_instance != nullptr) { throw DuplicateError{"Duplicate logger Instance"}; }
 		s_instance = m_impl.get();
 
-		m_impl->config = std::move(config);
+		m_impl->publish(std::move(config));
 
 		m_impl->print(std::format("logging to file: {}", filePath), Context::make("logger", Level::eInfo));
 	}
 
 	Instance::~Instance()
 	{
+		// the writer thread only reports repeats held back for reportInterval, the rest would be lost
+		m_impl->reportRepeats(true);
+		{
+			// threads still holding their Repeats register again with the next Instance
+			auto lock = std::scoped_lock{m_impl->repeatsMutex};
+			for (auto const & repeats : m_impl->threadRepeats) { repeats->owner.store(nullptr, std::memory_order_relaxed); }
+		}
+		// suppressed logs are otherwise reported when their call site logs again
+		if (auto const suppressed = m_impl->limiter.takeUnreported(); suppressed > 0)
+		{
+			m_impl->print(std::format("{} log(s) suppressed by rate limit", suppressed), Context::make("logger", Level::eWarn));
+		}
 		s_instance = {};
 	}
 
 	Config Instance::getConfig() const
 	{
 		assert(m_impl);
-		auto lock = std::scoped_lock{m_impl->mutex};
-		// make the copy under mutex lock
-		return m_impl->config;
+		// snapshots are immutable, copying one requires no lock
+		return m_impl->snapshot.load(std::memory_order_acquire)->config;
 	}
 
 	void Instance::setConfig(Config config)
 	{
 		assert(m_impl);
-		auto lock	   = std::scoped_lock{m_impl->mutex};
-		m_impl->config = std::move(config);
+		auto lock = std::scoped_lock{m_impl->mutex};
+		m_impl->publish(std::move(config));
 	}
 
 	void Instance::addSink(std::unique_ptr<Sink> sink)
@@ -329,6 +1072,19 @@ namespace gen::logger
 		assert(m_impl != nullptr);
 		auto lock = std::scoped_lock{m_impl->mutex};
 		m_impl->sinks.push_back(std::move(sink));
+		m_impl->hasSinks.store(true, std::memory_order_release);
+	}
+
+	bool Instance::isEnabled(Level const level, std::string_view const category)
+	{
+		if (s_instance == nullptr) { return false; }
+		return s_instance->isEnabled(level, category);
+	}
+
+	bool Instance::admit(Level const level, std::string_view const category, CallSite const & site)
+	{
+		if (s_instance == nullptr) { return true; }
+		return s_instance->admit(level, category, site);
 	}
 
 	void Instance::print(std::string_view const message, Context const & context)
@@ -336,6 +1092,12 @@ namespace gen::logger
 		if (s_instance == nullptr) { return; }
 		s_instance->print(message, context);
 	}
+
+	void Instance::printDeferred(std::string_view const format, std::string_view const args, Context const & context)
+	{
+		if (s_instance == nullptr) { return; }
+		s_instance->printDeferred(format, args, context);
+	}
 } // namespace gen::logger
 
 // namespace gen::logger
@@ -5,6 +5,16 @@
 
 namespace gen
 {
+	bool logger::isEnabled(logger::Level level, std::string_view category)
+	{
+		return Instance::isEnabled(level, category);
+	}
+
+	bool logger::admit(logger::Level level, std::string_view category, CallSite const & site)
+	{
+		return Instance::admit(level, category, site);
+	}
+
 	void logger::print(logger::Level level, std::string_view category, std::string_view message)
 	{
 		Instance::print(message, Context::make(category, level));
@@ -16,6 +26,26 @@ namespace gen
 		Instance::print(message, Context::make(category, level, function, filePath, curLine));
 	}
 
+	std::string & logger::deferredBuffer()
+	{
+		// reused per thread, so encoding arguments does not allocate once warmed up
+		thread_local auto t_buffer = std::string{};
+		t_buffer.clear();
+		return t_buffer;
+	}
+
+	void logger::printDeferred(logger::Level level, std::string_view category, std::string_view format, std::string_view args)
+	{
+		Instance::printDeferred(format, args, Context::make(category, level));
+	}
+
+	void logger::printDeferred(
+		logger::Level level, std::string_view category, std::string_view function, std::string_view filePath, int curLine, std::string_view format,
+		std::string_view args)
+	{
+		Instance::printDeferred(format, args, Context::make(category, level, function, filePath, curLine));
+	}
+
 	Logger::Logger(std::string_view const category) : m_category(category.empty() ? "unknown" : category)
 	{
 	}
@@ -0,0 +1,192 @@
+// Copyright (c) 2023-present Genesis Engine contributors (see LICENSE.txt)
+
+#include "logFile.hpp"
+#include <algorithm>
+#include <array>
+#include <filesystem>
+#include <format>
+
+#if defined(_WIN32)
+	#include <io.h>
+#else
+	#include <cerrno>
+	#include <fcntl.h>
+	#include <sys/uio.h>
+	#include <unistd.h>
+#endif
+
+namespace gen::logger
+{
+	namespace
+	{
+		namespace fs = std::filesystem;
+
+		std::string rotated_path(std::string_view const path, std::uint32_t const index)
+		{
+			return std::format("{}.{}", path, index);
+		}
+	} // namespace
+
+	LogFile::LogFile(std::string path, Rotation const rotation, std::chrono::milliseconds const syncInterval)
+		: m_path(std::move(path)), m_rotation(rotation), m_syncInterval(syncInterval), m_lastSync(Clock::now())
+	{
+		open();
+	}
+
+	LogFile::~LogFile()
+	{
+		sync(true);
+		close();
+	}
+
+	void LogFile::write(std::span<std::string const> const records)
+	{
+		if (!isOpen()) { return; }
+
+		// split the batch wherever the current file would exceed its max size
+		auto first = std::size_t{};
+		auto size  = m_size;
+		for (std::size_t index = 0; index < records.size(); ++index)
+		{
+			auto const bytes = records[index].size();
+			if (wouldRotate(size - m_size, bytes))
+			{
+				flush(records.subspan(first, index - first));
+				rotate();
+				if (!isOpen()) { return; }
+				first = index;
+				size  = 0;
+			}
+			size += bytes;
+		}
+		flush(records.subspan(first));
+	}
+
+	void LogFile::sync(bool const force)
+	{
+		if (!isOpen() || !m_dirty || m_syncInterval.count() <= 0) { return; }
+		auto const now = Clock::now();
+		if (!force && now - m_lastSync < m_syncInterval) { return; }
+#if defined(_WIN32)
+		std::fflush(m_file);
+		_commit(_fileno(m_file));
+#elif defined(__APPLE__)
+		::fsync(m_fd);
+#else
+		::fdatasync(m_fd);
+#endif
+		m_lastSync = now;
+		m_dirty	   = false;
+	}
+
+	bool LogFile::wouldRotate(std::uint64_t const pending, std::uint64_t const bytes) const
+	{
+		auto const size = m_size + pending;
+		return m_rotation.maxSize > 0 && size > 0 && size + bytes > m_rotation.maxSize;
+	}
+
+	bool LogFile::isOpen() const
+	{
+#if defined(_WIN32)
+		return m_file != nullptr;
+#else
+		return m_fd >= 0;
+#endif
+	}
+
+	void LogFile::open()
+	{
+#if defined(_WIN32)
+		m_file = std::fopen(m_path.c_str(), "wb");
+#else
+		// NOLINTNEXTLINE
+		m_fd = ::open(m_path.c_str(), O_WRONLY | O_CREAT | O_TRUNC | O_APPEND | O_CLOEXEC, 0644);
+#endif
+		m_size = 0;
+	}
+
+	void LogFile::close()
+	{
+		if (!isOpen()) { return; }
+#if defined(_WIN32)
+		std::fclose(m_file);
+		m_file = nullptr;
+#else
+		::close(m_fd);
+		m_fd = -1;
+#endif
+	}
+
+	void LogFile::rotate()
+	{
+		sync(true);
+		close();
+		auto error = std::error_code{};
+		if (m_rotation.maxFiles > 0)
+		{
+			// shift "<path>.N-1" -> "<path>.N", ..., "<path>" -> "<path>.1"
+			fs::remove(rotated_path(m_path, m_rotation.maxFiles), error);
+			for (auto index = m_rotation.maxFiles - 1; index > 0; --index)
+			{
+				auto const from = rotated_path(m_path, index);
+				if (fs::exists(from, error)) { fs::rename(from, rotated_path(m_path, index + 1), error); }
+			}
+			fs::rename(m_path, rotated_path(m_path, 1), error);
+		}
+		// reopening truncates, which also covers maxFiles == 0
+		open();
+	}
+
+	void LogFile::flush(std::span<std::string const> records)
+	{
+		if (records.empty()) { return; }
+		m_dirty = true;
+#if defined(_WIN32)
+		// stdio buffers the records, so this is still a handful of WriteFile calls per batch
+		for (auto const & record : records)
+		{
+			m_size += std::fwrite(record.data(), 1, record.size(), m_file);
+		}
+		std::fflush(m_file);
+#else
+		static constexpr std::size_t max_iov_v{256};
+		auto iov = std::array<iovec, max_iov_v>{};
+		while (!records.empty())
+		{
+			auto remaining = std::min(records.size(), iov.size());
+			for (std::size_t index = 0; index < remaining; ++index)
+			{
+				// NOLINTNEXTLINE
+				iov[index] = iovec{.iov_base = const_cast<char *>(records[index].data()), .iov_len = records[index].size()};
+			}
+			records = records.subspan(remaining);
+
+			// one writev per chunk, retrying partial writes
+			auto * current = iov.data();
+			while (remaining > 0)
+			{
+				auto const written = ::writev(m_fd, current, static_cast<int>(remaining));
+				if (written < 0)
+				{
+					if (errno == EINTR) { continue; }
+					// nowhere to report a failing log file, drop the batch
+					return;
+				}
+				m_size += static_cast<std::uint64_t>(written);
+				auto left = static_cast<std::size_t>(written);
+				while (remaining > 0 && left >= current->iov_len)
+				{
+					left -= current->iov_len;
+					++current;
+					--remaining;
+				}
+				if (remaining > 0)
+				{
+					current->iov_base = static_cast<char *>(current->iov_base) + left;
+					current->iov_len -= left;
+				}
+			}
+		}
+#endif
+	}
+} // namespace gen::logger
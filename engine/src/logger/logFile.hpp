@@ -0,0 +1,75 @@
+// Copyright (c) 2023-present Genesis Engine contributors (see LICENSE.txt)
+
+#pragma once
+#include <chrono>
+#include <cstdio>
+#include <span>
+#include <string>
+#include "gen/logger/config.hpp"
+
+namespace gen::logger
+{
+	///
+	/// \brief Persistently open, append only log file.
+	///
+	/// Owned and used exclusively by the file sink's writer thread.
+	///
+	class LogFile
+	{
+	public:
+		///
+		/// \brief Create (or truncate) the log file at path.
+		///
+		LogFile(std::string path, Rotation rotation, std::chrono::milliseconds syncInterval);
+		~LogFile();
+
+		LogFile(LogFile &&)				  = delete;
+		LogFile & operator=(LogFile &&) = delete;
+
+		LogFile(LogFile const &)			 = delete;
+		LogFile & operator=(LogFile const &) = delete;
+
+		///
+		/// \brief Append a batch of records, using as few syscalls as possible.
+		///
+		void write(std::span<std::string const> records);
+
+		///
+		/// \brief Flush file contents to disk if the sync interval has elapsed.
+		/// \param force Sync regardless of the interval.
+		///
+		void sync(bool force = false);
+
+		///
+		/// \brief Check whether writing bytes after pending (not yet written) bytes would exceed the rotation max size.
+		///
+		[[nodiscard]] bool wouldRotate(std::uint64_t pending, std::uint64_t bytes) const;
+
+		///
+		/// \brief Rotate the log file now, regardless of its size.
+		///
+		void rotate();
+
+		[[nodiscard]] bool isOpen() const;
+
+	private:
+		using Clock = std::chrono::steady_clock;
+
+		void open();
+		void close();
+		void flush(std::span<std::string const> records);
+
+		std::string m_path{};
+		Rotation m_rotation{};
+		std::chrono::milliseconds m_syncInterval{};
+		Clock::time_point m_lastSync{};
+		std::uint64_t m_size{};
+		bool m_dirty{};
+
+#if defined(_WIN32)
+		std::FILE * m_file{};
+#else
+		int m_fd{-1};
+#endif
+	};
+} // namespace gen::logger
@@ -0,0 +1,108 @@
+// Copyright (c) 2023-present Genesis Engine contributors (see LICENSE.txt)
+
+#pragma once
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+#include <memory>
+#include "gen/logger/config.hpp"
+
+namespace gen::logger
+{
+	///
+	/// \brief Lock-free per call site rate limiter.
+	///
+	/// Call site keys hash into a fixed table of slots, probing probes_v neighbouring slots for their own or a free one.
+	/// When all of them belong to other call sites the first is taken over, bucket included: colliding call sites then share
+	/// a limit rather than resetting each other's.
+	/// Each slot is a token bucket implemented as GCRA: a single "theoretical arrival time" stands in for the token count,
+	/// so admitting a log is one compare-exchange.
+	///
+	class RateLimiter
+	{
+	public:
+		using Clock = std::chrono::steady_clock;
+
+		static constexpr std::size_t slots_v{1024};
+		static constexpr std::size_t probes_v{4};
+
+		///
+		/// \brief Result of admit().
+		///
+		struct Result
+		{
+			bool admitted{};
+			// logs suppressed at this call site since it was last admitted (only set when admitted)
+			std::uint64_t suppressed{};
+		};
+
+		RateLimiter() : m_slots(std::make_unique<Slot[]>(slots_v)) {}
+
+		///
+		/// \brief Spend a token from the call site's bucket.
+		/// \param key Call site key, must be non-zero.
+		///
+		Result admit(std::uint64_t const key, RateLimit const & limit, Clock::time_point const now)
+		{
+			auto const period	 = std::max(std::chrono::duration_cast<std::chrono::nanoseconds>(limit.interval).count(), std::int64_t{1});
+			auto const tolerance = period * static_cast<std::int64_t>(limit.burst - 1);
+			auto const time		 = std::chrono::duration_cast<std::chrono::nanoseconds>(now.time_since_epoch()).count();
+
+			Slot * found = nullptr;
+			for (std::size_t probe = 0; probe < probes_v && found == nullptr; ++probe)
+			{
+				auto & slot = m_slots[(key + probe) & (slots_v - 1)];
+				auto owner	= slot.key.load(std::memory_order_relaxed);
+				if (owner == 0 && slot.key.compare_exchange_strong(owner, key, std::memory_order_relaxed))
+				{
+					// new call site: start with a full bucket
+					slot.arrival.store(time + period, std::memory_order_relaxed);
+					return Result{.admitted = true};
+				}
+				if (owner == key) { found = &slot; }
+			}
+			if (found == nullptr)
+			{
+				// the bucket is kept, the suppressed count of the previous owner stays unreported
+				found = &m_slots[key & (slots_v - 1)];
+				found->key.store(key, std::memory_order_relaxed);
+				found->suppressed.store(0, std::memory_order_relaxed);
+			}
+			auto & slot = *found;
+
+			auto arrival = slot.arrival.load(std::memory_order_relaxed);
+			while (true)
+			{
+				auto const start = std::max(arrival, time);
+				if (start - time > tolerance)
+				{
+					slot.suppressed.fetch_add(1, std::memory_order_relaxed);
+					m_unreported.fetch_add(1, std::memory_order_relaxed);
+					return {};
+				}
+				if (slot.arrival.compare_exchange_weak(arrival, start + period, std::memory_order_relaxed)) { break; }
+			}
+
+			auto const suppressed = slot.suppressed.exchange(0, std::memory_order_relaxed);
+			if (suppressed > 0) { m_unreported.fetch_sub(suppressed, std::memory_order_relaxed); }
+			return Result{.admitted = true, .suppressed = suppressed};
+		}
+
+		///
+		/// \brief Obtain and reset the number of suppressed logs not reported through admit().
+		///
+		std::uint64_t takeUnreported() { return m_unreported.exchange(0, std::memory_order_relaxed); }
+
+	private:
+		struct alignas(64) Slot
+		{
+			std::atomic<std::uint64_t> key{};
+			std::atomic<std::int64_t> arrival{};
+			std::atomic<std::uint64_t> suppressed{};
+		};
+
+		std::unique_ptr<Slot[]> m_slots{};
+		std::atomic<std::uint64_t> m_unreported{};
+	};
+} // namespace gen::logger
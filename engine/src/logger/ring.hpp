@@ -0,0 +1,114 @@
+// Copyright (c) 2023-present Genesis Engine contributors (see LICENSE.txt)
+
+#pragma once
+#include <algorithm>
+#include <atomic>
+#include <bit>
+#include <cstddef>
+#include <memory>
+#include <utility>
+
+namespace gen::logger
+{
+	///
+	/// \brief Bounded lock-free ring of records.
+	///
+	/// Multiple producers (or a single owning thread) push, a single writer thread pops.
+	/// Producers are also allowed to pop (to discard the oldest record when the ring is full),
+	/// every cell carries a sequence number so any number of threads can safely race on both ends.
+	///
+	template <typename Type>
+	class Ring
+	{
+	public:
+		static constexpr std::size_t cache_line_v{64};
+
+		///
+		/// \brief Create a Ring.
+		/// \param capacity Number of cells, rounded up to the next power of two.
+		///
+		explicit Ring(std::size_t const capacity) : m_mask(std::bit_ceil(std::max(capacity, std::size_t{2})) - 1)
+		{
+			m_cells = std::make_unique<Cell[]>(m_mask + 1);
+			for (std::size_t index = 0; index <= m_mask; ++index) { m_cells[index].sequence.store(index, std::memory_order_relaxed); }
+		}
+
+		///
+		/// \brief Attempt to push a record.
+		/// \param value Record to move into the ring, left untouched on failure.
+		/// \returns false if the ring is full.
+		///
+		bool tryPush(Type & value)
+		{
+			auto pos = m_head.load(std::memory_order_relaxed);
+			while (true)
+			{
+				auto & cell		= m_cells[pos & m_mask];
+				auto const seq	= cell.sequence.load(std::memory_order_acquire);
+				auto const diff = static_cast<std::ptrdiff_t>(seq) - static_cast<std::ptrdiff_t>(pos);
+				if (diff == 0)
+				{
+					// cell is free: claim it, or reload pos if another producer beat us to it
+					if (m_head.compare_exchange_weak(pos, pos + 1, std::memory_order_relaxed))
+					{
+						cell.value = std::move(value);
+						cell.sequence.store(pos + 1, std::memory_order_release);
+						return true;
+					}
+				}
+				else if (diff < 0) { return false; }
+				else { pos = m_head.load(std::memory_order_relaxed); }
+			}
+		}
+
+		///
+		/// \brief Attempt to pop the oldest record.
+		/// \param out Record to move the popped value into.
+		/// \returns false if the ring is empty.
+		///
+		bool tryPop(Type & out)
+		{
+			auto pos = m_tail.load(std::memory_order_relaxed);
+			while (true)
+			{
+				auto & cell		= m_cells[pos & m_mask];
+				auto const seq	= cell.sequence.load(std::memory_order_acquire);
+				auto const diff = static_cast<std::ptrdiff_t>(seq) - static_cast<std::ptrdiff_t>(pos + 1);
+				if (diff == 0)
+				{
+					if (m_tail.compare_exchange_weak(pos, pos + 1, std::memory_order_relaxed))
+					{
+						out = std::move(cell.value);
+						cell.sequence.store(pos + m_mask + 1, std::memory_order_release);
+						return true;
+					}
+				}
+				else if (diff < 0) { return false; }
+				else { pos = m_tail.load(std::memory_order_relaxed); }
+			}
+		}
+
+		///
+		/// \brief Check whether no record has been claimed since the last pop.
+		///
+		/// A claimed record may not be published yet, so tryPop() can still fail when this returns false.
+		///
+		[[nodiscard]] bool empty() const { return m_head.load(std::memory_order_relaxed) == m_tail.load(std::memory_order_relaxed); }
+
+		[[nodiscard]] std::size_t capacity() const { return m_mask + 1; }
+
+	private:
+		struct alignas(cache_line_v) Cell
+		{
+			std::atomic<std::size_t> sequence{};
+			Type value{};
+		};
+
+		std::size_t m_mask{};
+		std::unique_ptr<Cell[]> m_cells{};
+
+		// producers and consumer each get their own cache line
+		alignas(cache_line_v) std::atomic<std::size_t> m_head{};
+		alignas(cache_line_v) std::atomic<std::size_t> m_tail{};
+	};
+} // namespace gen::logger
@@ -10,7 +10,7 @@ namespace gen
 		{
 			Clock::time_point g_start{Clock::now()};
 			float g_deltaTime;
-			float g_timeScale;
+			float g_timeScale{1.0f};
 		} // namespace
 
 		void UpdateDeltaTime()
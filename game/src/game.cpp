@@ -6,6 +6,8 @@ namespace gen
 {
 	Game::Game(const char * appName, const u32 appVersion, const mim::vec2i & initialSize) : Application(appName, appVersion, initialSize)
 	{
+		// Register parallel stages here, they run every frame in the order their reads and writes require, eg
+		// m_frameGraph.add("physics", [this] { stepPhysics(Time::GetDeltaTime()); }, {.reads = {"input"}, .writes = {"transforms"}});
 	}
 
 	void Game::draw()
@@ -0,0 +1,89 @@
+// Copyright (c) 2023-present Genesis Engine contributors (see LICENSE.txt)
+
+#include "gen/core/frameArena.hpp"
+
+#include <gtest/gtest.h>
+
+#include <atomic>
+#include <cstdint>
+#include <string>
+#include <thread>
+#include <vector>
+
+using namespace gen;
+
+namespace
+{
+	struct Point
+	{
+		float x{};
+		float y{};
+		float z{};
+	};
+} // namespace
+
+TEST(FrameArena, AlignsAllocations)
+{
+	auto arena	   = FrameArena{1024, 3};
+	auto * const a = arena.allocate(3, 1);
+	auto * const b = arena.allocate(8, 64);
+	EXPECT_NE(a, b);
+	EXPECT_EQ(reinterpret_cast<std::uintptr_t>(b) % 64, 0u);
+
+	auto const points = arena.allocate<Point>(10);
+	EXPECT_EQ(reinterpret_cast<std::uintptr_t>(points.data()) % alignof(Point), 0u);
+	EXPECT_EQ(arena.create<Point>(Point{4, 5, 6})->z, 6.0f);
+}
+
+TEST(FrameArena, OverflowRegrowsAtReset)
+{
+	auto arena = FrameArena{1024, 3};
+	{
+		auto strings = std::pmr::vector<std::pmr::string>{&arena.getResource()};
+		for (int i = 0; i < 200; ++i) { strings.emplace_back("a string too long for the small string buffer " + std::to_string(i)); }
+		EXPECT_EQ(strings.back(), "a string too long for the small string buffer 199");
+	}
+	auto const peak = arena.getUsed();
+	EXPECT_GT(peak, 1024u);
+	EXPECT_EQ(arena.getCapacity(), 1024u);
+
+	// back on the same buffer: regrown to hold the peak, and empty
+	for (u32 frame = 0; frame < arena.getBufferCount(); ++frame) { arena.nextFrame(); }
+	EXPECT_GE(arena.getCapacity(), peak);
+	EXPECT_EQ(arena.getUsed(), 0u);
+
+	// the same frame again fits without touching the heap
+	for (int i = 0; i < 10; ++i) { [[maybe_unused]] auto * const bytes = arena.allocate(peak / 20, 1); }
+	EXPECT_LE(arena.getUsed(), arena.getCapacity());
+}
+
+TEST(FrameArena, AllocatesFromJobsDuringNextFrame)
+{
+	auto arena = FrameArena{4096, 3};
+	auto stop  = std::atomic<bool>{};
+	auto total = std::atomic<u64>{};
+
+	auto threads = std::vector<std::jthread>{};
+	for (int thread = 0; thread < 3; ++thread)
+	{
+		threads.emplace_back(
+			[&]
+			{
+				while (!stop.load(std::memory_order_relaxed))
+				{
+					auto * const value = static_cast<u32 *>(arena.allocate(sizeof(u32), alignof(u32)));
+					EXPECT_EQ(reinterpret_cast<std::uintptr_t>(value) % alignof(u32), 0u);
+					total.fetch_add(1, std::memory_order_relaxed);
+					std::this_thread::sleep_for(std::chrono::microseconds{10});
+				}
+			});
+	}
+	for (int frame = 0; frame < 300; ++frame)
+	{
+		arena.nextFrame();
+		std::this_thread::sleep_for(std::chrono::microseconds{200});
+	}
+	stop.store(true, std::memory_order_relaxed);
+	threads.clear();
+	EXPECT_GT(total.load(), 0u);
+}
@@ -0,0 +1,163 @@
+// Copyright (c) 2023-present Genesis Engine contributors (see LICENSE.txt)
+
+#include "gen/io/derivedDataCache.hpp"
+
+#include <gtest/gtest.h>
+
+#include <cstring>
+#include <format>
+#include <random>
+#include <string>
+#include <vector>
+
+using namespace gen;
+
+namespace
+{
+	using Key = DerivedDataCache::Key;
+
+	Key makeKey(std::string_view const name)
+	{
+		return DerivedDataCache::KeyBuilder{}.add(name).finish();
+	}
+
+	std::vector<std::byte> makeData(std::size_t const size, u8 const value)
+	{
+		return std::vector<std::byte>(size, std::byte{value});
+	}
+
+	class DerivedDataCacheTest : public ::testing::Test
+	{
+	protected:
+		void SetUp() override { m_root = fs::temp_directory_path() / std::format("gen-ddc-test-{}", std::random_device{}()); }
+
+		void TearDown() override
+		{
+			auto error = std::error_code{};
+			fs::remove_all(m_root, error);
+		}
+
+		fs::path m_root;
+	};
+} // namespace
+
+TEST(KeyBuilderTest, SplitsDoNotChangeTheKey)
+{
+	auto text = std::string{};
+	for (int index = 0; index < 100; ++index) { text += static_cast<char>('a' + index % 26); }
+	auto const expected = DerivedDataCache::KeyBuilder{}.add(text).finish();
+
+	// the same stream of bytes (length prefix, then the text), fed a byte at a time so every block goes through the tail
+	auto bytes = DerivedDataCache::KeyBuilder{};
+	bytes.add(u64{text.size()});
+	for (auto const c : text) { bytes.add(c); }
+	EXPECT_EQ(bytes.finish(), expected);
+
+	// and in pieces straddling the 16 byte blocks
+	auto pieces = DerivedDataCache::KeyBuilder{};
+	pieces.add(u64{text.size()});
+	for (std::size_t offset = 0; offset < text.size(); offset += 4)
+	{
+		auto value = u32{};
+		std::memcpy(&value, text.data() + offset, sizeof(value));
+		pieces.add(value);
+	}
+	EXPECT_EQ(pieces.finish(), expected);
+}
+
+TEST(KeyBuilderTest, AddsAreLengthPrefixed)
+{
+	auto const abc	 = DerivedDataCache::KeyBuilder{}.add(std::string_view{"ab"}).add(std::string_view{"c"}).finish();
+	auto const a_bc	 = DerivedDataCache::KeyBuilder{}.add(std::string_view{"a"}).add(std::string_view{"bc"}).finish();
+	auto const whole = DerivedDataCache::KeyBuilder{}.add(std::string_view{"abc"}).finish();
+	EXPECT_NE(abc, a_bc);
+	EXPECT_NE(abc, whole);
+	EXPECT_NE(a_bc, whole);
+	EXPECT_EQ(abc, DerivedDataCache::KeyBuilder{}.add(std::string_view{"ab"}).add(std::string_view{"c"}).finish());
+}
+
+TEST(KeyBuilderTest, KeysRoundTripThroughStrings)
+{
+	auto const key = makeKey("shader");
+	EXPECT_EQ(key.toString().size(), 32);
+	EXPECT_EQ(Key::fromString(key.toString()), key);
+	EXPECT_FALSE(Key::fromString("not a key").has_value());
+	EXPECT_FALSE(Key::fromString(std::string(32, 'g')).has_value());
+}
+
+TEST_F(DerivedDataCacheTest, StoresArtifacts)
+{
+	auto cache = DerivedDataCache{};
+	EXPECT_FALSE(cache.put(makeKey("a"), makeData(10, 1)));
+	ASSERT_TRUE(cache.open(m_root));
+	EXPECT_FALSE(cache.get(makeKey("a")).has_value());
+
+	EXPECT_TRUE(cache.put(makeKey("a"), makeData(10, 1)));
+	EXPECT_EQ(cache.get(makeKey("a")), makeData(10, 1));
+	// replaced in place
+	EXPECT_TRUE(cache.put(makeKey("a"), makeData(4, 2)));
+	EXPECT_EQ(cache.get(makeKey("a")), makeData(4, 2));
+	EXPECT_EQ(cache.getSize(), 4);
+
+	cache.remove(makeKey("a"));
+	EXPECT_FALSE(cache.get(makeKey("a")).has_value());
+	EXPECT_EQ(cache.getSize(), 0);
+}
+
+TEST_F(DerivedDataCacheTest, EvictsTheLeastRecentlyUsed)
+{
+	auto cache = DerivedDataCache{};
+	ASSERT_TRUE(cache.open(m_root, 30));
+	EXPECT_FALSE(cache.put(makeKey("huge"), makeData(31, 0)));
+	EXPECT_TRUE(cache.put(makeKey("a"), makeData(10, 1)));
+	EXPECT_TRUE(cache.put(makeKey("b"), makeData(10, 2)));
+	EXPECT_TRUE(cache.put(makeKey("c"), makeData(10, 3)));
+	EXPECT_EQ(cache.getSize(), 30);
+
+	// a is the oldest, reading it leaves b the least recently used
+	EXPECT_TRUE(cache.get(makeKey("a")).has_value());
+	EXPECT_TRUE(cache.put(makeKey("d"), makeData(10, 4)));
+	EXPECT_EQ(cache.getSize(), 30);
+	EXPECT_FALSE(cache.get(makeKey("b")).has_value());
+	EXPECT_EQ(cache.get(makeKey("a")), makeData(10, 1));
+	EXPECT_EQ(cache.get(makeKey("c")), makeData(10, 3));
+	EXPECT_EQ(cache.get(makeKey("d")), makeData(10, 4));
+}
+
+TEST_F(DerivedDataCacheTest, OpenRebuildsTheIndex)
+{
+	{
+		auto cache = DerivedDataCache{};
+		ASSERT_TRUE(cache.open(m_root));
+		EXPECT_TRUE(cache.put(makeKey("a"), makeData(10, 1)));
+		EXPECT_TRUE(cache.put(makeKey("b"), makeData(10, 2)));
+		// refreshes the modification time, so a is the most recently used after a restart too
+		EXPECT_TRUE(cache.get(makeKey("a")).has_value());
+	}
+
+	auto cache = DerivedDataCache{};
+	ASSERT_TRUE(cache.open(m_root, 20));
+	EXPECT_EQ(cache.getSize(), 20);
+	EXPECT_TRUE(cache.put(makeKey("c"), makeData(10, 3)));
+	EXPECT_EQ(cache.getSize(), 20);
+	EXPECT_FALSE(cache.get(makeKey("b")).has_value());
+	EXPECT_EQ(cache.get(makeKey("a")), makeData(10, 1));
+	EXPECT_EQ(cache.get(makeKey("c")), makeData(10, 3));
+}
+
+TEST_F(DerivedDataCacheTest, OpenEvictsDownToTheCapacity)
+{
+	{
+		auto cache = DerivedDataCache{};
+		ASSERT_TRUE(cache.open(m_root));
+		EXPECT_TRUE(cache.put(makeKey("a"), makeData(10, 1)));
+		EXPECT_TRUE(cache.put(makeKey("b"), makeData(10, 2)));
+		EXPECT_TRUE(cache.get(makeKey("b")).has_value());
+	}
+
+	auto cache = DerivedDataCache{};
+	ASSERT_TRUE(cache.open(m_root, 15));
+	EXPECT_EQ(cache.getSize(), 10);
+	EXPECT_FALSE(cache.get(makeKey("a")).has_value());
+	EXPECT_EQ(cache.get(makeKey("b")), makeData(10, 2));
+}
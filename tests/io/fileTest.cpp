@@ -0,0 +1,136 @@
+// Copyright (c) 2023-present Genesis Engine contributors (see LICENSE.txt)
+
+#include "gen/io/file.hpp"
+
+#include <gtest/gtest.h>
+
+#include <array>
+#include <format>
+#include <fstream>
+#include <random>
+#include <span>
+#include <string>
+#include <string_view>
+
+using namespace gen;
+
+namespace
+{
+	class FileTest : public ::testing::Test
+	{
+	protected:
+		void SetUp() override
+		{
+			m_root = fs::temp_directory_path() / std::format("gen-file-test-{}", std::random_device{}());
+			fs::create_directories(m_root);
+		}
+
+		void TearDown() override
+		{
+			auto error = std::error_code{};
+			fs::remove_all(m_root, error);
+		}
+
+		GEN_NODISCARD fs::path path() const { return m_root / "file.txt"; }
+
+		void create(std::string_view const contents) const
+		{
+			auto out = std::ofstream{path(), std::ios::binary};
+			out.write(contents.data(), static_cast<std::streamsize>(contents.size()));
+		}
+
+		GEN_NODISCARD std::string contents() const
+		{
+			auto in = std::ifstream{path(), std::ios::binary};
+			return {std::istreambuf_iterator<char>{in}, std::istreambuf_iterator<char>{}};
+		}
+
+		static std::span<std::byte const> bytes(std::string_view const text) { return std::as_bytes(std::span{text}); }
+
+		fs::path m_root;
+	};
+} // namespace
+
+TEST_F(FileTest, ReadWriteKeepsContents)
+{
+	create("hello world");
+	auto file = File{};
+	ASSERT_TRUE(file.open(path(), File::in | File::out | File::binary));
+	EXPECT_EQ(file.getFileSize(), 11);
+	EXPECT_EQ(file.tell(), 0);
+	EXPECT_TRUE(file.write("J", 1, 0));
+	file.close();
+	EXPECT_EQ(contents(), "Jello world");
+}
+
+TEST_F(FileTest, WriteOnlyKeepsContents)
+{
+	create("hello world");
+	auto file = File{};
+	ASSERT_TRUE(file.open(path(), File::out | File::binary));
+	EXPECT_EQ(file.getFileSize(), 11);
+	file.close();
+	EXPECT_EQ(contents(), "hello world");
+}
+
+TEST_F(FileTest, WriteCreatesMissingFiles)
+{
+	auto file = File{};
+	EXPECT_FALSE(file.open(path(), File::in | File::binary));
+	ASSERT_TRUE(file.open(path(), File::out | File::binary));
+	EXPECT_TRUE(fs::exists(path()));
+	EXPECT_EQ(file.getFileSize(), 0);
+}
+
+TEST_F(FileTest, TruncEmptiesTheFile)
+{
+	create("hello world");
+	auto file = File{};
+	ASSERT_TRUE(file.open(path(), File::out | File::trunc | File::binary));
+	EXPECT_EQ(file.getFileSize(), 0);
+	file.close();
+	EXPECT_EQ(contents(), "");
+}
+
+TEST_F(FileTest, AppendOnlyWritesAtTheEnd)
+{
+	create("hello");
+	auto file = File{};
+	ASSERT_TRUE(file.open(path(), File::out | File::app | File::binary));
+	EXPECT_TRUE(file.write(" world", 6));
+	EXPECT_TRUE(file.write("!", 1, -1, std::ios::out));
+
+	// an explicit offset would skip finding the end under the mutex
+	EXPECT_FALSE(file.write("X", 1, 0));
+	EXPECT_EQ(file.writeAt(0, bytes("X")), -1);
+	file.close();
+	EXPECT_EQ(contents(), "hello world!");
+}
+
+TEST_F(FileTest, AteStartsAtTheEnd)
+{
+	create("hello");
+	auto file = File{};
+	ASSERT_TRUE(file.open(path(), File::in | File::out | File::ate | File::binary));
+	EXPECT_EQ(file.tell(), 5);
+	EXPECT_TRUE(file.write(" world", 6, -1, std::ios::out));
+	EXPECT_EQ(file.tell(), 11);
+	file.close();
+	EXPECT_EQ(contents(), "hello world");
+}
+
+TEST_F(FileTest, TemporaryLeavesNoFile)
+{
+	auto file = File{};
+	if (!file.open(m_root, File::temporary | File::in | File::out | File::binary)) { GTEST_SKIP() << "the file system does not support unnamed temporary files"; }
+	EXPECT_EQ(file.writeAt(0, bytes("scratch")), 7);
+	auto buffer = std::array<std::byte, 7>{};
+	EXPECT_EQ(file.readAt(0, buffer), 7);
+	EXPECT_EQ(std::string_view(reinterpret_cast<char const *>(buffer.data()), buffer.size()), "scratch");
+
+	// no path to stat, and nothing in the directory
+	EXPECT_EQ(file.getFileTimeStamp(), -1);
+	EXPECT_TRUE(fs::is_empty(m_root));
+	file.close();
+	EXPECT_TRUE(fs::is_empty(m_root));
+}
@@ -0,0 +1,78 @@
+// Copyright (c) 2023-present Genesis Engine contributors (see LICENSE.txt)
+
+#include "gen/io/lz4.hpp"
+
+#include <gtest/gtest.h>
+
+#include <cstddef>
+#include <random>
+#include <string_view>
+#include <vector>
+
+namespace
+{
+	std::vector<std::byte> roundTrip(std::vector<std::byte> const & data)
+	{
+		auto compressed = std::vector<std::byte>(gen::lz4::compressBound(data.size()));
+		compressed.resize(gen::lz4::compress(data, compressed));
+		EXPECT_TRUE(data.empty() || !compressed.empty());
+
+		auto ret = std::vector<std::byte>(data.size());
+		EXPECT_TRUE(gen::lz4::decompress(compressed, ret));
+		return ret;
+	}
+
+	std::vector<std::byte> randomBytes(std::size_t const size, int const distinct)
+	{
+		auto engine = std::mt19937{42};
+		auto dist	= std::uniform_int_distribution<int>{0, distinct - 1};
+		auto ret	= std::vector<std::byte>(size);
+		for (auto & byte : ret) { byte = static_cast<std::byte>(dist(engine)); }
+		return ret;
+	}
+} // namespace
+
+TEST(Lz4, RoundTripsEdgeSizes)
+{
+	for (std::size_t const size : {0, 1, 4, 12, 13, 64, 65535, 65536, 65537})
+	{
+		auto const data = randomBytes(size, 4);
+		EXPECT_EQ(roundTrip(data), data) << "size " << size;
+	}
+}
+
+TEST(Lz4, RoundTripsIncompressibleData)
+{
+	auto const data = randomBytes(1 << 20, 256);
+	EXPECT_EQ(roundTrip(data), data);
+}
+
+TEST(Lz4, CompressesRepetitiveData)
+{
+	constexpr auto text = std::string_view{"the quick brown fox jumps over the lazy dog "};
+	auto data			= std::vector<std::byte>{};
+	while (data.size() < (1 << 20))
+	{
+		for (char const c : text) { data.push_back(static_cast<std::byte>(c)); }
+	}
+	auto compressed = std::vector<std::byte>(gen::lz4::compressBound(data.size()));
+	compressed.resize(gen::lz4::compress(data, compressed));
+	EXPECT_LT(compressed.size(), data.size() / 50);
+	EXPECT_EQ(roundTrip(data), data);
+}
+
+TEST(Lz4, RejectsCorruptBlocks)
+{
+	auto const data = randomBytes(4096, 8);
+	auto compressed = std::vector<std::byte>(gen::lz4::compressBound(data.size()));
+	compressed.resize(gen::lz4::compress(data, compressed));
+	auto out = std::vector<std::byte>(data.size());
+
+	// truncated, and decompressing to the wrong size
+	EXPECT_FALSE(gen::lz4::decompress(std::span{compressed}.first(compressed.size() / 2), out));
+	auto shorter = std::vector<std::byte>(data.size() - 1);
+	EXPECT_FALSE(gen::lz4::decompress(compressed, shorter));
+	// fits, but nothing runs past the end of dst
+	auto smaller = std::vector<std::byte>(16);
+	EXPECT_FALSE(gen::lz4::decompress(compressed, smaller));
+}
@@ -0,0 +1,108 @@
+// Copyright (c) 2023-present Genesis Engine contributors (see LICENSE.txt)
+
+#include "gen/io/pakFile.hpp"
+
+#include <gtest/gtest.h>
+
+#include <cstdlib>
+#include <format>
+#include <fstream>
+#include <map>
+#include <random>
+#include <string>
+#include <vector>
+
+using namespace gen;
+
+namespace
+{
+	// packs a generated directory with tools/pak-builder, then reads every file back through PakFile
+	class PakFileTest : public ::testing::TestWithParam<std::string>
+	{
+	protected:
+		void SetUp() override
+		{
+#if !defined(GEN_PAK_BUILDER)
+			GTEST_SKIP() << "pak-builder is not built (GENESIS_BUILD_TOOLS)";
+#else
+			m_root = fs::temp_directory_path() / std::format("gen-pak-test-{}", std::random_device{}());
+			fs::create_directories(m_root / "input" / "nested");
+
+			auto engine = std::mt19937{7};
+			auto text	= std::string{};
+			while (text.size() < (1 << 20)) { text += std::format("line {} of a very repetitive file\n", text.size() % 97); }
+			auto noise = std::string(300000, '\0');
+			for (auto & c : noise) { c = static_cast<char>(engine()); }
+			m_files = {
+				{"empty.bin", {}},
+				{"small.txt", "hello pak"},
+				// several blocks at the default block size
+				{"nested/large.txt", text},
+				{"nested/noise.bin", noise},
+			};
+			for (auto const & [name, contents] : m_files)
+			{
+				auto out = std::ofstream{m_root / "input" / name, std::ios::binary};
+				out.write(contents.data(), static_cast<std::streamsize>(contents.size()));
+			}
+
+			auto const command = std::format("\"{}\" -q {} \"{}\" \"{}\"", GEN_PAK_BUILDER, GetParam(), (m_root / "input").string(), path().string());
+			ASSERT_EQ(std::system(command.c_str()), 0) << command;
+#endif
+		}
+
+		void TearDown() override
+		{
+			auto error = std::error_code{};
+			if (!m_root.empty()) { fs::remove_all(m_root, error); }
+		}
+
+		GEN_NODISCARD fs::path path() const { return m_root / "test.gpak"; }
+
+		static std::string toString(std::vector<std::byte> const & bytes) { return {reinterpret_cast<char const *>(bytes.data()), bytes.size()}; }
+
+		fs::path m_root;
+		std::map<std::string, std::string> m_files;
+	};
+} // namespace
+
+TEST_P(PakFileTest, ReadsEveryEntryBack)
+{
+	auto pak = PakFile{};
+	ASSERT_TRUE(pak.open(path()));
+	EXPECT_EQ(pak.getEntryCount(), m_files.size());
+	for (auto const & [name, contents] : m_files)
+	{
+		auto const entry = pak.find(name);
+		ASSERT_TRUE(entry.has_value()) << name;
+		EXPECT_EQ(entry->size, contents.size());
+		EXPECT_EQ(toString(pak.read(*entry)), contents) << name;
+	}
+	EXPECT_FALSE(pak.find("missing.txt").has_value());
+}
+
+TEST_P(PakFileTest, ReadsEveryEntryAsync)
+{
+	auto pak = PakFile{};
+	ASSERT_TRUE(pak.open(path()));
+	auto buffers = std::map<std::string, std::vector<std::byte>>{};
+	auto results = std::map<std::string, FileAsync::Result>{};
+	for (auto const & [name, contents] : m_files)
+	{
+		auto const entry = pak.find(name);
+		ASSERT_TRUE(entry.has_value()) << name;
+		auto & buffer = buffers[name];
+		buffer.resize(entry->size);
+		// callbacks run on the I/O threads, each writes its own result
+		pak.readAsync(*entry, buffer, [&result = results[name]](FileAsync::Result const & in) { result = in; });
+	}
+	pak.wait();
+	for (auto const & [name, contents] : m_files)
+	{
+		EXPECT_TRUE(results[name]) << name << ": " << results[name].error;
+		EXPECT_EQ(toString(buffers[name]), contents) << name;
+	}
+}
+
+// stored as is, compressed in blocks, and compressed as a whole
+INSTANTIATE_TEST_SUITE_P(Compression, PakFileTest, ::testing::Values("--compression=none", "--compression=lz4", "--compression=lz4 --block-size=0"));
@@ -0,0 +1,131 @@
+// Copyright (c) 2023-present Genesis Engine contributors (see LICENSE.txt)
+
+#include "gen/jobs/executor.hpp"
+
+#include <gtest/gtest.h>
+
+#include <stdexcept>
+#include <string>
+#include <thread>
+
+using namespace gen;
+
+namespace
+{
+	Task<int> square(int const value)
+	{
+		co_return value * value;
+	}
+
+	Task<std::string> squareOnWorker(int const value)
+	{
+		co_await resumeOnWorker();
+		auto const worker = JobSystem::getThreadIndex() != JobSystem::invalid_thread_v;
+		auto const result = co_await square(value);
+		co_await resumeOnMainThread();
+		co_return worker ? std::to_string(result) : std::string{"not on a worker"};
+	}
+
+	Task<> throwNextFrame()
+	{
+		co_await nextFrame();
+		throw std::runtime_error("thrown");
+	}
+
+	// runs frames until every spawned task returned, the job system working between them
+	int runFrames(Executor & executor, int const maxFrames)
+	{
+		auto frame = 0;
+		for (; frame < maxFrames && executor.getTaskCount() > 0; ++frame)
+		{
+			executor.update(0.1f);
+			auto counter = JobSystem::Counter{};
+			JobSystem::getInstance().run([] {}, &counter);
+			JobSystem::getInstance().wait(counter);
+			std::this_thread::sleep_for(std::chrono::milliseconds{1});
+		}
+		return frame;
+	}
+} // namespace
+
+TEST(Executor, PropagatesValuesAcrossThreads)
+{
+	auto jobs	  = JobSystem{4};
+	auto executor = Executor{};
+	auto result	  = std::string{};
+	auto onMain	  = false;
+	executor.spawn(
+		[](std::string & out, bool & main) -> Task<>
+		{
+			out	 = co_await squareOnWorker(7);
+			main = Executor::getInstance().isMainThread();
+		}(result, onMain));
+
+	runFrames(executor, 100);
+	EXPECT_EQ(executor.getTaskCount(), 0u);
+	EXPECT_EQ(result, "49");
+	EXPECT_TRUE(onMain);
+}
+
+TEST(Executor, PropagatesExceptionsToTheAwaiter)
+{
+	auto jobs	  = JobSystem{2};
+	auto executor = Executor{};
+	auto caught	  = std::string{};
+	executor.spawn(
+		[](std::string & out) -> Task<>
+		{
+			try
+			{
+				co_await throwNextFrame();
+			}
+			catch (std::runtime_error const & error)
+			{
+				out = error.what();
+			}
+		}(caught));
+
+	runFrames(executor, 10);
+	EXPECT_EQ(caught, "thrown");
+}
+
+TEST(Executor, ResumesAfterDelayAndFrames)
+{
+	auto jobs	  = JobSystem{2};
+	auto executor = Executor{};
+	auto resumed  = 0;
+	executor.spawn(
+		[](int & out) -> Task<>
+		{
+			co_await delay(0.25f);
+			out = 1;
+			for (int frame = 0; frame < 3; ++frame) { co_await nextFrame(); }
+			out = 2;
+		}(resumed));
+
+	// 0.1 s frames: the delay is over on the third update
+	executor.update(0.1f);
+	executor.update(0.1f);
+	EXPECT_EQ(resumed, 0);
+	executor.update(0.1f);
+	EXPECT_EQ(resumed, 1);
+	EXPECT_EQ(runFrames(executor, 10), 3);
+	EXPECT_EQ(resumed, 2);
+}
+
+TEST(Executor, DestroysUnfinishedTasks)
+{
+	auto jobs = JobSystem{2};
+	{
+		auto executor = Executor{};
+		executor.spawn(
+			[]() -> Task<>
+			{
+				while (true) { co_await nextFrame(); }
+			}());
+		runFrames(executor, 3);
+		EXPECT_EQ(executor.getTaskCount(), 1u);
+	}
+	// never awaited, so never started
+	[[maybe_unused]] auto const unstarted = square(3);
+}
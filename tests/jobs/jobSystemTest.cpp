@@ -0,0 +1,112 @@
+// Copyright (c) 2023-present Genesis Engine contributors (see LICENSE.txt)
+
+#include "gen/jobs/jobSystem.hpp"
+#include "jobs/workStealingDeque.hpp"
+
+#include <gtest/gtest.h>
+
+#include <atomic>
+#include <thread>
+#include <utility>
+#include <vector>
+
+using namespace gen;
+
+namespace
+{
+	// forks one half as a job and computes the other, nesting waits the way recursive work does
+	u64 fib(u32 const n)
+	{
+		if (n < 12)
+		{
+			auto a = u64{};
+			auto b = u64{1};
+			for (u32 i = 0; i < n; ++i) { a = std::exchange(b, a + b); }
+			return a;
+		}
+		auto x		 = u64{};
+		auto counter = JobSystem::Counter{};
+		JobSystem::getInstance().run([&x, n] { x = fib(n - 1); }, &counter);
+		auto const y = fib(n - 2);
+		JobSystem::getInstance().wait(counter);
+		return x + y;
+	}
+} // namespace
+
+TEST(WorkStealingDeque, EveryItemTakenOnce)
+{
+	constexpr int count = 100000;
+	auto items			= std::vector<int>(count);
+	auto taken			= std::vector<std::atomic<int>>(count);
+	// small, so it grows while thieves read the old arrays
+	auto deque = jobs::WorkStealingDeque<int *>{16};
+	auto done  = std::atomic<bool>{};
+
+	auto thieves = std::vector<std::jthread>{};
+	for (int thief = 0; thief < 3; ++thief)
+	{
+		thieves.emplace_back(
+			[&]
+			{
+				while (!done.load(std::memory_order_acquire))
+				{
+					if (auto * item = deque.steal()) { taken[static_cast<std::size_t>(item - items.data())].fetch_add(1); }
+				}
+			});
+	}
+	for (int index = 0; index < count; ++index)
+	{
+		deque.push(&items[static_cast<std::size_t>(index)]);
+		if (index % 3 == 0)
+		{
+			if (auto * item = deque.pop()) { taken[static_cast<std::size_t>(item - items.data())].fetch_add(1); }
+		}
+	}
+	while (auto * item = deque.pop()) { taken[static_cast<std::size_t>(item - items.data())].fetch_add(1); }
+	done.store(true, std::memory_order_release);
+	thieves.clear();
+
+	for (auto const & times : taken) { EXPECT_EQ(times.load(), 1); }
+}
+
+TEST(JobSystem, ForkJoin)
+{
+	auto jobs = JobSystem{4};
+	EXPECT_EQ(fib(25), 75025u);
+}
+
+TEST(JobSystem, WaitsForEveryJob)
+{
+	auto jobs	 = JobSystem{4};
+	auto sum	 = std::atomic<u32>{};
+	auto counter = JobSystem::Counter{};
+	for (int i = 0; i < 10000; ++i) { jobs.run([&sum] { sum.fetch_add(1, std::memory_order_relaxed); }, &counter); }
+	jobs.wait(counter);
+	EXPECT_TRUE(counter.isDone());
+	EXPECT_EQ(sum.load(), 10000u);
+}
+
+TEST(JobSystem, ForeignThreadRunsAndWaits)
+{
+	auto jobs = JobSystem{4};
+	auto sum  = std::atomic<u32>{};
+	std::jthread{[&]
+				 {
+					 EXPECT_EQ(JobSystem::getThreadIndex(), JobSystem::invalid_thread_v);
+					 auto counter = JobSystem::Counter{};
+					 for (int i = 0; i < 1000; ++i) { jobs.run([&sum] { sum.fetch_add(1, std::memory_order_relaxed); }, &counter); }
+					 jobs.wait(counter);
+				 }}
+		.join();
+	EXPECT_EQ(sum.load(), 1000u);
+}
+
+TEST(JobSystem, ShutdownRunsQueuedJobs)
+{
+	auto sum = std::atomic<u32>{};
+	{
+		auto jobs = JobSystem{4};
+		for (int i = 0; i < 1000; ++i) { jobs.run([&sum] { sum.fetch_add(1, std::memory_order_relaxed); }); }
+	}
+	EXPECT_EQ(sum.load(), 1000u);
+}
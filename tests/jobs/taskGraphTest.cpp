@@ -0,0 +1,91 @@
+// Copyright (c) 2023-present Genesis Engine contributors (see LICENSE.txt)
+
+#include "gen/jobs/parallelFor.hpp"
+#include "gen/jobs/taskGraph.hpp"
+
+#include <gtest/gtest.h>
+
+#include <atomic>
+#include <map>
+#include <numeric>
+#include <ranges>
+#include <string>
+#include <vector>
+
+using namespace gen;
+
+TEST(ParallelFor, VisitsEveryElementOnce)
+{
+	auto values = std::vector<int>(100000);
+	// runs inline without a job system
+	parallel_for(values, 1000, [](int & value) { value = 1; });
+	{
+		auto jobs = JobSystem{4};
+		parallel_for(values, 1000, [](int & value) { value += 1; });
+
+		auto sum = std::atomic<u64>{};
+		parallel_for(std::views::iota(0u, 1000000u), 4096, [&sum](u32 const index) { sum.fetch_add(index, std::memory_order_relaxed); });
+		EXPECT_EQ(sum.load(), u64{999999} * 1000000 / 2);
+	}
+	EXPECT_EQ(std::accumulate(values.begin(), values.end(), 0), 200000);
+}
+
+TEST(TaskGraph, OrdersConflictingStages)
+{
+	auto jobs  = JobSystem{4};
+	auto clock = std::atomic<int>{};
+	// start and end tick of every stage
+	auto ticks = std::map<std::string, std::pair<int, int>>{};
+	auto graph = TaskGraph{};
+	auto const add = [&](std::string const & name, TaskGraph::Access access)
+	{
+		ticks[name];
+		graph.add(
+			name,
+			[&clock, &span = ticks[name]]
+			{
+				span.first	= clock.fetch_add(1);
+				span.second = clock.fetch_add(1);
+			},
+			std::move(access));
+	};
+	add("input", {.reads = {}, .writes = {"input"}});
+	add("anim", {.reads = {"input"}, .writes = {"pose"}});
+	add("physics", {.reads = {"input"}, .writes = {"transforms"}});
+	add("ai", {.reads = {"transforms"}, .writes = {"ai"}});
+	add("audio", {.reads = {"transforms"}, .writes = {}});
+	add("cull", {.reads = {"transforms", "pose"}, .writes = {"visible"}});
+	add("constraints", {.reads = {"transforms"}, .writes = {"transforms"}});
+
+	auto const before = [&](std::string const & first, std::string const & second) { return ticks[first].second < ticks[second].first; };
+	for (int frame = 0; frame < 20; ++frame)
+	{
+		graph.execute();
+		// a reader after the earlier writer
+		EXPECT_TRUE(before("input", "anim"));
+		EXPECT_TRUE(before("input", "physics"));
+		EXPECT_TRUE(before("physics", "ai"));
+		EXPECT_TRUE(before("physics", "audio"));
+		EXPECT_TRUE(before("anim", "cull"));
+		// a writer after the earlier readers
+		EXPECT_TRUE(before("ai", "constraints"));
+		EXPECT_TRUE(before("audio", "constraints"));
+		EXPECT_TRUE(before("cull", "constraints"));
+	}
+}
+
+TEST(TaskGraph, StagesMayRunParallelFor)
+{
+	auto jobs	= JobSystem{4};
+	auto count	= std::atomic<u32>{};
+	auto seen	= std::vector<u32>{};
+	auto graph	= TaskGraph{};
+	for (int stage = 0; stage < 8; ++stage)
+	{
+		graph.add("count", [&count] { parallel_for(std::views::iota(0, 10000), 100, [&count](int) { count.fetch_add(1, std::memory_order_relaxed); }); }, {.reads = {"count"}, .writes = {}});
+	}
+	graph.add("total", [&] { seen.push_back(count.exchange(0)); }, {.reads = {}, .writes = {"count"}});
+
+	for (int frame = 0; frame < 50; ++frame) { graph.execute(); }
+	EXPECT_EQ(seen, std::vector<u32>(50, 80000));
+}
@@ -0,0 +1,132 @@
+// Copyright (c) 2023-present Genesis Engine contributors (see LICENSE.txt)
+
+#include "gen/logger/instance.hpp"
+#include "gen/logger/log.hpp"
+
+#include <gtest/gtest.h>
+
+#include <algorithm>
+#include <filesystem>
+#include <format>
+#include <memory>
+#include <mutex>
+#include <random>
+#include <string>
+#include <vector>
+
+using namespace gen;
+
+namespace
+{
+	// sinks may be called from the writer thread
+	struct Messages
+	{
+		std::mutex mutex{};
+		std::vector<std::string> lines{};
+
+		std::size_t count(std::string_view const line)
+		{
+			auto lock = std::scoped_lock{mutex};
+			return static_cast<std::size_t>(std::ranges::count(lines, line));
+		}
+	};
+
+	struct CollectingSink : logger::Sink
+	{
+		explicit CollectingSink(Messages & messages) : messages(messages) {}
+
+		void handle(std::string_view formatted, logger::Context const & /*context*/) final
+		{
+			// lines come with their newline
+			if (formatted.ends_with('\n')) { formatted.remove_suffix(1); }
+			auto lock = std::scoped_lock{messages.mutex};
+			messages.lines.emplace_back(formatted);
+		}
+
+		Messages & messages;
+	};
+
+	class InstanceTest : public ::testing::Test
+	{
+	protected:
+		void SetUp() override
+		{
+			m_logPath = std::filesystem::temp_directory_path() / std::format("gen-instance-test-{}.log", std::random_device{}());
+			m_config.format = std::string_view{"{message}"};
+			for (auto const level : {logger::Level::eError, logger::Level::eWarn, logger::Level::eInfo, logger::Level::eDebug})
+			{
+				m_config.levelTargets[level] = logger::sinks_v;
+			}
+		}
+
+		void TearDown() override
+		{
+			auto error = std::error_code{};
+			std::filesystem::remove(m_logPath, error);
+		}
+
+		// logs through an Instance, which is destroyed (reporting what it held back) before returning
+		template <typename F>
+		void run(F && func)
+		{
+			auto instance = logger::Instance{m_logPath.string().c_str(), m_config};
+			instance.addSink(std::make_unique<CollectingSink>(m_messages));
+			func();
+		}
+
+		std::filesystem::path m_logPath;
+		logger::Config m_config{};
+		Messages m_messages{};
+	};
+} // namespace
+
+TEST_F(InstanceTest, CollapsesRepeats)
+{
+	m_config.collapseRepeats = true;
+	run(
+		[]
+		{
+			auto const log = Logger{"test"};
+			for (int index = 0; index < 4; ++index) { log.info("same"); }
+			log.info("other");
+			log.info("other");
+		});
+
+	EXPECT_EQ(m_messages.count("same"), 1);
+	EXPECT_EQ(m_messages.count("last message repeated 3 time(s)"), 1);
+	EXPECT_EQ(m_messages.count("other"), 1);
+	// held back until the Instance is destroyed
+	EXPECT_EQ(m_messages.count("last message repeated 1 time(s)"), 1);
+}
+
+TEST_F(InstanceTest, KeepsRepeatsWhenNotCollapsing)
+{
+	run(
+		[]
+		{
+			auto const log = Logger{"test"};
+			for (int index = 0; index < 4; ++index) { log.info("same"); }
+		});
+
+	EXPECT_EQ(m_messages.count("same"), 4);
+	EXPECT_EQ(m_messages.count("last message repeated 3 time(s)"), 0);
+}
+
+TEST_F(InstanceTest, RateLimitsCallSites)
+{
+	m_config.rateLimit = {.burst = 2, .interval = std::chrono::hours{1}};
+	run(
+		[]
+		{
+			auto const log = Logger{"test"};
+			for (int index = 0; index < 5; ++index) { log.info("limited {}", index); }
+			log.info("another call site");
+		});
+
+	EXPECT_EQ(m_messages.count("limited 0"), 1);
+	EXPECT_EQ(m_messages.count("limited 1"), 1);
+	EXPECT_EQ(m_messages.count("limited 2"), 0);
+	EXPECT_EQ(m_messages.count("another call site"), 1);
+	// never admitted again, so reported when the Instance is destroyed
+	EXPECT_EQ(m_messages.count("3 log(s) suppressed by rate limit"), 1);
+}
@@ -0,0 +1,87 @@
+// Copyright (c) 2023-present Genesis Engine contributors (see LICENSE.txt)
+
+#include "logger/rateLimiter.hpp"
+
+#include <gtest/gtest.h>
+
+using namespace gen;
+
+namespace
+{
+	using logger::RateLimiter;
+	using namespace std::chrono_literals;
+
+	// time is passed in, so every admit() happens exactly when the test says
+	constexpr auto start_v = RateLimiter::Clock::time_point{} + 1h;
+
+	constexpr auto limit_v = logger::RateLimit{.burst = 3, .interval = 100ms};
+
+	// keys probing the same slots: all of them start at slot 1
+	constexpr std::uint64_t colliding(std::uint64_t const index)
+	{
+		return 1 + index * RateLimiter::slots_v;
+	}
+} // namespace
+
+TEST(RateLimiterTest, AdmitsABurstThenSuppresses)
+{
+	auto limiter = RateLimiter{};
+	for (int index = 0; index < 3; ++index) { EXPECT_TRUE(limiter.admit(1, limit_v, start_v).admitted) << index; }
+	EXPECT_FALSE(limiter.admit(1, limit_v, start_v).admitted);
+	EXPECT_FALSE(limiter.admit(1, limit_v, start_v + 99ms).admitted);
+
+	// call sites have their own bucket
+	EXPECT_TRUE(limiter.admit(2, limit_v, start_v).admitted);
+}
+
+TEST(RateLimiterTest, RegainsOneLogPerInterval)
+{
+	auto limiter = RateLimiter{};
+	for (int index = 0; index < 3; ++index) { EXPECT_TRUE(limiter.admit(1, limit_v, start_v).admitted); }
+
+	for (auto time = start_v + 100ms; time < start_v + 1s; time += 100ms)
+	{
+		EXPECT_TRUE(limiter.admit(1, limit_v, time).admitted);
+		EXPECT_FALSE(limiter.admit(1, limit_v, time).admitted);
+	}
+
+	// idle long enough to refill the bucket, but no more than the burst
+	auto const later = start_v + 10s;
+	for (int index = 0; index < 3; ++index) { EXPECT_TRUE(limiter.admit(1, limit_v, later).admitted) << index; }
+	EXPECT_FALSE(limiter.admit(1, limit_v, later).admitted);
+}
+
+TEST(RateLimiterTest, ReportsSuppressedOnTheNextAdmit)
+{
+	auto limiter = RateLimiter{};
+	for (int index = 0; index < 3; ++index) { EXPECT_EQ(limiter.admit(1, limit_v, start_v).suppressed, 0); }
+	for (int index = 0; index < 2; ++index) { EXPECT_EQ(limiter.admit(1, limit_v, start_v).suppressed, 0); }
+
+	auto const result = limiter.admit(1, limit_v, start_v + 100ms);
+	EXPECT_TRUE(result.admitted);
+	EXPECT_EQ(result.suppressed, 2);
+	EXPECT_EQ(limiter.admit(1, limit_v, start_v + 200ms).suppressed, 0);
+	// reported through admit(), nothing is left over
+	EXPECT_EQ(limiter.takeUnreported(), 0);
+}
+
+TEST(RateLimiterTest, CountsSuppressedOfTakenOverSlots)
+{
+	auto const limit = logger::RateLimit{.burst = 1, .interval = 100ms};
+	auto limiter	 = RateLimiter{};
+	EXPECT_TRUE(limiter.admit(colliding(0), limit, start_v).admitted);
+	EXPECT_FALSE(limiter.admit(colliding(0), limit, start_v).admitted);
+	EXPECT_FALSE(limiter.admit(colliding(0), limit, start_v).admitted);
+	for (std::uint64_t index = 1; index < RateLimiter::probes_v; ++index) { EXPECT_TRUE(limiter.admit(colliding(index), limit, start_v).admitted) << index; }
+
+	// every probed slot is owned, the first is taken over along with its (empty) bucket
+	auto const intruder = colliding(RateLimiter::probes_v);
+	EXPECT_FALSE(limiter.admit(intruder, limit, start_v).admitted);
+	auto const result = limiter.admit(intruder, limit, start_v + 100ms);
+	EXPECT_TRUE(result.admitted);
+	EXPECT_EQ(result.suppressed, 1);
+
+	// the two logs suppressed before the takeover can no longer be reported through admit()
+	EXPECT_EQ(limiter.takeUnreported(), 2);
+	EXPECT_EQ(limiter.takeUnreported(), 0);
+}
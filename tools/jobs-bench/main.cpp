@@ -0,0 +1,231 @@
+#include <gen/jobs/jobSystem.hpp>
+#include <gen/jobs/parallelFor.hpp>
+#include <gen/jobs/taskGraph.hpp>
+#include <algorithm>
+#include <cassert>
+#include <charconv>
+#include <chrono>
+#include <cmath>
+#include <cstdint>
+#include <filesystem>
+#include <format>
+#include <functional>
+#include <iostream>
+#include <ranges>
+#include <span>
+#include <string>
+#include <thread>
+#include <vector>
+
+namespace fs = std::filesystem;
+
+namespace {
+using Clock = std::chrono::steady_clock;
+
+struct Options {
+	struct ParseError : std::runtime_error {
+		using std::runtime_error::runtime_error;
+	};
+	struct Usage {};
+
+	std::uint32_t frames{100};
+	std::uint32_t maxThreads{std::max(std::thread::hardware_concurrency(), 1u)};
+	std::vector<std::string_view> benches{};
+
+	static ParseError unrecognized_opt(std::string_view const opt) { return ParseError{std::format("unrecognized option: '{}'", opt)}; }
+
+	static std::string buildUsage(std::string_view const appName) {
+		return std::format("usage: {} [--frames=<count>] [--threads=<max threads>] [parallel-for|task-graph]...", appName);
+	}
+
+	void parse(std::span<char const* const> args) {
+		for (std::string_view const arg : args) {
+			if (arg.starts_with("--")) {
+				option(arg.substr(2));
+			} else if (arg.starts_with('-')) {
+				throw unrecognized_opt(arg.substr(1));
+			} else {
+				benches.push_back(arg);
+			}
+		}
+	}
+
+	static std::uint32_t parse_count(std::string_view const arg, std::string_view const what) {
+		auto const value = arg.substr(arg.find('=') + 1);
+		auto ret = std::uint32_t{};
+		auto const [end, error] = std::from_chars(value.data(), value.data() + value.size(), ret);
+		if (error != std::errc{} || end != value.data() + value.size() || ret == 0) { throw ParseError{std::format("{} must be a positive number: '{}'", what, value)}; }
+		return ret;
+	}
+
+	void option(std::string_view const arg) {
+		if (arg.starts_with("frames=")) {
+			frames = parse_count(arg, "frame count");
+			return;
+		}
+
+		if (arg.starts_with("threads=")) {
+			maxThreads = parse_count(arg, "thread count");
+			return;
+		}
+
+		if (arg == "usage" || arg == "help") { throw Usage{}; }
+
+		throw unrecognized_opt(arg);
+	}
+};
+
+struct Body {
+	float x{};
+	float y{};
+	float z{};
+	float vx{};
+	float vy{};
+	float vz{};
+};
+
+// a few dozen flops, a chunk of 1024 bodies is around a hundred microseconds
+void integrate(Body& body, float const dt) {
+	for (int step = 0; step < 8; ++step) {
+		body.vx -= body.x * dt;
+		body.vy -= body.y * dt + 9.81f * dt * dt;
+		body.vz -= std::sin(body.z) * dt;
+		body.x += body.vx * dt;
+		body.y += body.vy * dt;
+		body.z += body.vz * dt;
+	}
+}
+
+std::vector<Body> make_bodies(std::size_t const count) {
+	auto ret = std::vector<Body>(count);
+	for (std::size_t index = 0; index < count; ++index) {
+		auto const f = static_cast<float>(index % 1024) / 1024.0f;
+		ret[index] = {.x = f, .y = 1.0f - f, .z = f * 3.0f, .vx = 0.1f, .vy = 0.0f, .vz = -0.1f};
+	}
+	return ret;
+}
+
+// a frame of systems the way a game registers them: some split work with parallel_for, some are serial
+struct World {
+	static constexpr std::size_t grain_v{1024};
+
+	std::vector<Body> bodies{make_bodies(1 << 19)};
+	std::vector<Body> bones{make_bodies(1 << 18)};
+	std::vector<Body> agents{make_bodies(1 << 14)};
+	std::vector<std::uint8_t> visible = std::vector<std::uint8_t>(bodies.size());
+	std::uint64_t frame{};
+	std::uint64_t drawn{};
+	float loudness{};
+
+	void build(gen::TaskGraph& graph) {
+		graph.add("input", [this] { ++frame; }, {.reads = {}, .writes = {"input"}});
+		graph.add("physics", [this] { gen::parallel_for(bodies, grain_v, [](Body& body) { integrate(body, 0.016f); }); }, {.reads = {"input"}, .writes = {"transforms"}});
+		graph.add("animation", [this] { gen::parallel_for(bones, grain_v, [](Body& bone) { integrate(bone, 0.016f); }); }, {.reads = {"input"}, .writes = {"pose"}});
+		graph.add(
+			"ai",
+			[this] {
+				for (auto& agent : agents) { integrate(agent, 0.016f); }
+			},
+			{.reads = {"transforms"}, .writes = {"agents"}});
+		graph.add(
+			"audio",
+			[this] {
+				auto sum = 0.0f;
+				for (std::size_t index = 0; index < bodies.size(); index += 64) { sum += std::abs(bodies[index].vy); }
+				loudness = sum;
+			},
+			{.reads = {"transforms"}, .writes = {"audio"}});
+		graph.add(
+			"culling",
+			[this] {
+				gen::parallel_for(std::views::iota(std::size_t{0}, bodies.size()), grain_v * 4, [this](std::size_t const index) {
+					auto const& body = bodies[index];
+					visible[index] = body.x * body.x + body.z * body.z < 4.0f && std::abs(bones[index % bones.size()].y) < 100.0f ? 1 : 0;
+				});
+			},
+			{.reads = {"transforms", "pose"}, .writes = {"visible"}});
+		graph.add(
+			"render",
+			[this] {
+				for (auto const flag : visible) { drawn += flag; }
+			},
+			{.reads = {"visible", "agents"}, .writes = {"commands"}});
+	}
+};
+
+struct App {
+	static constexpr std::string_view benches_v[] = {"parallel-for", "task-graph"};
+
+	Options const& options;
+
+	bool selected(std::string_view const name) const { return options.benches.empty() || std::ranges::find(options.benches, name) != options.benches.end(); }
+
+	bool run() const {
+		for (auto const name : options.benches) {
+			if (std::ranges::find(benches_v, name) == std::end(benches_v)) {
+				std::cerr << std::format("unknown bench: '{}'\n", name);
+				return false;
+			}
+		}
+
+		if (selected("parallel-for")) {
+			auto bodies = make_bodies(1 << 20);
+			sweep("parallel_for", [&] { gen::parallel_for(bodies, World::grain_v, [](Body& body) { integrate(body, 0.016f); }); });
+		}
+		if (selected("task-graph")) {
+			auto world = World{};
+			auto graph = gen::TaskGraph{};
+			world.build(graph);
+			sweep("TaskGraph", [&] { graph.execute(); });
+		}
+		return true;
+	}
+
+	// median frame time for every thread count, each with its own JobSystem
+	void sweep(std::string_view const name, std::function<void()> const& frame) const {
+		std::cout << std::format("{}, median of {} frames\n", name, options.frames);
+		std::cout << std::format("{:>7} {:>10} {:>8} {:>10}\n", "threads", "frame ms", "speedup", "efficiency");
+		auto baseline = 0.0;
+		for (std::uint32_t threads = 1; threads <= options.maxThreads; ++threads) {
+			auto jobs = gen::JobSystem{threads};
+			// warm up the workers and caches
+			for (int warmup = 0; warmup < 5; ++warmup) { frame(); }
+
+			auto times = std::vector<double>{};
+			times.reserve(options.frames);
+			for (std::uint32_t index = 0; index < options.frames; ++index) {
+				auto const begin = Clock::now();
+				frame();
+				times.push_back(std::chrono::duration<double, std::milli>(Clock::now() - begin).count());
+			}
+			auto const median = times.begin() + static_cast<std::ptrdiff_t>(times.size() / 2);
+			std::nth_element(times.begin(), median, times.end());
+			if (threads == 1) { baseline = *median; }
+			auto const speedup = baseline / *median;
+			std::cout << std::format("{:>7} {:>10.3f} {:>8.2f} {:>9.0f}%\n", threads, *median, speedup, 100.0 * speedup / threads);
+		}
+	}
+};
+} // namespace
+
+int main(int argc, char** argv) {
+	assert(argc > 0);
+	auto const usage = Options::buildUsage(fs::path{*argv}.filename().string());
+	auto const args = std::span{argv, static_cast<std::size_t>(argc)}.subspan(1);
+	auto options = Options{};
+	try {
+		options.parse(args);
+
+		return App{options}.run() ? EXIT_SUCCESS : EXIT_FAILURE;
+
+	} catch (Options::ParseError const& error) {
+		std::cerr << std::format("{}\n{}\n", error.what(), usage);
+		return EXIT_FAILURE;
+	} catch (Options::Usage) {
+		std::cout << std::format("{}\n", usage);
+		return EXIT_SUCCESS;
+	} catch (std::exception const& e) {
+		std::cerr << std::format("fatal error: {}\n", e.what());
+		return EXIT_FAILURE;
+	}
+}
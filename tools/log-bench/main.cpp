@@ -0,0 +1,257 @@
+#include <gen/logger/instance.hpp>
+#include <gen/logger/log.hpp>
+#include <algorithm>
+#include <cassert>
+#include <charconv>
+#include <chrono>
+#include <filesystem>
+#include <format>
+#include <iostream>
+#include <memory>
+#include <latch>
+#include <span>
+#include <string>
+#include <thread>
+#include <vector>
+
+namespace fs = std::filesystem;
+namespace logger = gen::logger;
+
+namespace {
+using Clock = std::chrono::steady_clock;
+
+struct Options {
+	struct ParseError : std::runtime_error {
+		using std::runtime_error::runtime_error;
+	};
+	struct Usage {};
+
+	std::uint32_t lines{100000};
+	fs::path logPath{};
+	std::vector<std::string_view> benches{};
+
+	static ParseError unrecognized_opt(std::string_view const opt) { return ParseError{std::format("unrecognized option: '{}'", opt)}; }
+
+	static std::string buildUsage(std::string_view const appName) {
+		return std::format("usage: {} [--lines=<count per thread>] [--log=<log file>] [latency|disabled|format]...", appName);
+	}
+
+	void parse(std::span<char const* const> args) {
+		for (std::string_view const arg : args) {
+			if (arg.starts_with("--")) {
+				option(arg.substr(2));
+			} else if (arg.starts_with('-')) {
+				throw unrecognized_opt(arg.substr(1));
+			} else {
+				benches.push_back(arg);
+			}
+		}
+	}
+
+	void option(std::string_view const arg) {
+		if (arg.starts_with("lines=")) {
+			auto const value = arg.substr(arg.find('=') + 1);
+			auto const [end, error] = std::from_chars(value.data(), value.data() + value.size(), lines);
+			if (error != std::errc{} || end != value.data() + value.size() || lines == 0) {
+				throw ParseError{std::format("line count must be a positive number: '{}'", value)};
+			}
+			return;
+		}
+
+		if (arg.starts_with("log=")) {
+			logPath = arg.substr(arg.find('=') + 1);
+			return;
+		}
+
+		if (arg == "usage" || arg == "help") { throw Usage{}; }
+
+		throw unrecognized_opt(arg);
+	}
+};
+
+// every level goes to the log file only, the console would measure the terminal
+logger::Config file_only_config() {
+	auto ret = logger::Config{};
+	for (auto const level : {logger::Level::eError, logger::Level::eWarn, logger::Level::eInfo, logger::Level::eDebug}) { ret.levelTargets[level] = logger::file_v; }
+	return ret;
+}
+
+std::uint64_t to_ns(Clock::duration const duration) { return static_cast<std::uint64_t>(std::chrono::duration_cast<std::chrono::nanoseconds>(duration).count()); }
+
+// counts what it is handed, so the format bench measures the Pattern rather than an output
+struct NullSink : logger::Sink {
+	std::size_t bytes{};
+
+	void handle(std::string_view const formatted, logger::Context const& /*context*/) final { bytes += formatted.size(); }
+};
+
+// samples are reordered
+Clock::duration percentile(std::vector<Clock::duration>& samples, double const fraction) {
+	assert(!samples.empty());
+	auto const index = std::min(static_cast<std::size_t>(static_cast<double>(samples.size()) * fraction), samples.size() - 1);
+	auto const nth = samples.begin() + static_cast<std::ptrdiff_t>(index);
+	std::nth_element(samples.begin(), nth, samples.end());
+	return *nth;
+}
+
+// average time of one call to func(index) over count calls
+template <typename F>
+double ns_per_call(std::uint32_t const count, F&& func) {
+	auto const begin = Clock::now();
+	for (std::uint32_t index = 0; index < count; ++index) { func(index); }
+	return std::chrono::duration<double, std::nano>(Clock::now() - begin).count() / count;
+}
+
+struct App {
+	Options const& options;
+
+	struct Bench {
+		std::string_view name{};
+		void (App::*run)(logger::Instance& instance) const {};
+	};
+
+	bool run() const {
+		static constexpr Bench benches_v[] = {
+			{"latency", &App::latency},
+			{"disabled", &App::disabled},
+			{"format", &App::format},
+		};
+
+		for (auto const name : options.benches) {
+			if (std::ranges::none_of(benches_v, [name](Bench const& bench) { return bench.name == name; })) {
+				std::cerr << std::format("unknown bench: '{}'\n", name);
+				return false;
+			}
+		}
+
+		auto const logPath = options.logPath.empty() ? fs::temp_directory_path() / "log-bench.log" : options.logPath;
+		{
+			auto instance = logger::Instance{logPath.string().c_str(), file_only_config()};
+			for (auto const& bench : benches_v) {
+				if (options.benches.empty() || std::ranges::find(options.benches, bench.name) != options.benches.end()) { (this->*bench.run)(instance); }
+			}
+		}
+		if (options.logPath.empty()) { fs::remove(logPath); }
+		return true;
+	}
+
+	// time of each Logger::info call (format and hand off to the file sink's ring) while producers log concurrently
+	void latency(logger::Instance& instance) const {
+		auto const log = gen::Logger{"bench"};
+		instance.setConfig(file_only_config());
+
+		std::cout << std::format("Logger::info latency, {} lines per producer (ns)\n", options.lines);
+		std::cout << std::format("{:>9} {:>9} {:>9} {:>9} {:>14}\n", "producers", "p50", "p99", "max", "lines/s");
+		for (std::uint32_t const producers : {1, 4, 16}) {
+			auto samples = std::vector<std::vector<Clock::duration>>(producers);
+			auto start = std::latch{static_cast<std::ptrdiff_t>(producers) + 1};
+			auto const begin = [&] {
+				auto threads = std::vector<std::jthread>{};
+				for (std::uint32_t producer = 0; producer < producers; ++producer) {
+					threads.emplace_back([&, producer] {
+						auto& out = samples[producer];
+						out.reserve(options.lines);
+						start.arrive_and_wait();
+						for (std::uint32_t line = 0; line < options.lines; ++line) {
+							auto const before = Clock::now();
+							log.info("producer {} logged line {} of {}", producer, line, options.lines);
+							out.push_back(Clock::now() - before);
+						}
+					});
+				}
+				start.arrive_and_wait();
+				return Clock::now();
+			}();
+			auto const elapsed = Clock::now() - begin;
+
+			auto all = std::vector<Clock::duration>{};
+			for (auto const& producer : samples) { all.insert(all.end(), producer.begin(), producer.end()); }
+			auto const linesPerSecond = static_cast<double>(all.size()) / std::chrono::duration<double>(elapsed).count();
+			auto const p50 = to_ns(percentile(all, 0.5));
+			auto const p99 = to_ns(percentile(all, 0.99));
+			auto const max = to_ns(*std::ranges::max_element(all));
+			std::cout << std::format("{:>9} {:>9} {:>9} {:>9} {:>14.0f}\n", producers, p50, p99, max, linesPerSecond);
+
+			// let the writer drain the ring so the next row starts from an empty one
+			std::this_thread::sleep_for(std::chrono::milliseconds{200});
+		}
+	}
+
+	// cost of a debug log the Config filters out: formatting before the level check (as Logger used to) against checking first
+	void disabled(logger::Instance& instance) const {
+		auto const log = gen::Logger{"bench"};
+		auto config = file_only_config();
+		config.maxLevel = logger::Level::eInfo;
+		instance.setConfig(std::move(config));
+
+		auto const name = std::string{"a disabled log argument"};
+		auto const count = options.lines * 10;
+		auto const formatFirst = ns_per_call(count, [&](std::uint32_t const index) {
+			logger::print(logger::Level::eDebug, "bench", std::format("disabled line {} with '{}' and {:.3f}", index, name, 0.5 * index));
+		});
+		auto const checkFirst = ns_per_call(count, [&](std::uint32_t const index) { log.debug("disabled line {} with '{}' and {:.3f}", index, name, 0.5 * index); });
+		auto const macro = ns_per_call(count, [&](std::uint32_t const index) { GEN_LOG_DEBUG(log, "disabled line {} with '{}' and {:.3f}", index, name, 0.5 * index); });
+
+		std::cout << std::format("disabled Logger::debug cost, {} calls (ns per call)\n", count);
+		std::cout << std::format("{:>28} {:>9.1f}\n", "std::format, then filter", formatFirst);
+		std::cout << std::format("{:>28} {:>9.1f}\n", "Logger::debug", checkFirst);
+		std::cout << std::format("{:>28} {:>9.1f}{}\n", "GEN_LOG_DEBUG", macro, logger::isCompiledIn(logger::Level::eDebug) ? "" : " (compiled out)");
+	}
+
+	// the Config::format Pattern applied to every line, with a sink that does nothing as the only target
+	void format(logger::Instance& instance) const {
+		auto const log = gen::Logger{"bench"};
+		auto sink = std::make_unique<NullSink>();
+		auto const& null = *sink;
+		instance.addSink(std::move(sink));
+
+		auto const configure = [&](std::string_view const format) {
+			auto config = logger::Config{};
+			config.format = format;
+			for (auto const level : {logger::Level::eError, logger::Level::eWarn, logger::Level::eInfo, logger::Level::eDebug}) {
+				config.levelTargets[level] = logger::sinks_v;
+			}
+			instance.setConfig(std::move(config));
+		};
+
+		auto const name = std::string{"a formatted argument"};
+		auto const count = options.lines * 10;
+		// the message alone, which both patterns pay for as well
+		auto messageBytes = std::size_t{};
+		auto const message = ns_per_call(count, [&](std::uint32_t const index) { messageBytes += std::format("line {} with '{}' and {:.3f}", index, name, 0.5 * index).size(); });
+		configure(logger::Config::default_format_v);
+		auto const basic = ns_per_call(count, [&](std::uint32_t const index) { log.info("line {} with '{}' and {:.3f}", index, name, 0.5 * index); });
+		configure(logger::Config::verbose_format_v);
+		auto const verbose = ns_per_call(count, [&](std::uint32_t const index) {
+			log.verbose_info(__func__, __FILE__, __LINE__, "line {} with '{}' and {:.3f}", index, name, 0.5 * index);
+		});
+
+		std::cout << std::format("log line formatting, {} lines (ns per line, {} message and {} line bytes)\n", count, messageBytes, null.bytes);
+		std::cout << std::format("{:>28} {:>9.1f}\n", "message only", message);
+		std::cout << std::format("{:>28} {:>9.1f}\n", "default_format_v", basic);
+		std::cout << std::format("{:>28} {:>9.1f}\n", "verbose_format_v", verbose);
+	}
+};
+} // namespace
+
+int main(int argc, char** argv) {
+	assert(argc > 0);
+	auto const usage = Options::buildUsage(fs::path{*argv}.filename().string());
+	auto const args = std::span{argv, static_cast<std::size_t>(argc)}.subspan(1);
+	auto options = Options{};
+	try {
+		options.parse(args);
+
+		return App{options}.run() ? EXIT_SUCCESS : EXIT_FAILURE;
+
+	} catch (Options::ParseError const& error) {
+		std::cerr << std::format("{}\n{}\n", error.what(), usage);
+		return EXIT_FAILURE;
+	} catch (Options::Usage) {
+		std::cout << std::format("{}\n", usage);
+		return EXIT_SUCCESS;
+	} catch (std::exception const& e) {
+		std::cerr << std::format("fatal error: {}\n", e.what());
+		return EXIT_FAILURE;
+	}
+}
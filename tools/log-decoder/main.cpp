@@ -0,0 +1,206 @@
+#include <gen/logger/binary.hpp>
+#include <gen/logger/level.hpp>
+#include <array>
+#include <cassert>
+#include <chrono>
+#include <ctime>
+#include <filesystem>
+#include <format>
+#include <fstream>
+#include <iostream>
+#include <span>
+#include <unordered_map>
+#include <vector>
+
+namespace fs = std::filesystem;
+namespace binary = gen::logger::binary;
+
+namespace {
+struct Options {
+	struct ParseError : std::runtime_error {
+		using std::runtime_error::runtime_error;
+	};
+	struct Usage {};
+
+	bool utc{};
+	bool verbose{};
+	std::vector<std::string_view> paths{};
+
+	static ParseError unrecognized_opt(std::string_view const opt) { return ParseError{std::format("unrecognized option: '{}'", opt)}; }
+
+	static std::string buildUsage(std::string_view const appName) { return std::format("usage: {} [-u|--utc] [-v|--verbose] <log file>...", appName); }
+
+	void parse(std::span<char const* const> args) {
+		for (std::string_view const arg : args) {
+			if (arg.starts_with("--")) {
+				option(arg.substr(2));
+			} else if (arg.starts_with('-')) {
+				options(arg.substr(1));
+			} else {
+				paths.push_back(arg);
+			}
+		}
+
+		if (paths.empty()) { throw ParseError{"no log files specified"}; }
+	}
+
+	void option(std::string_view const arg) {
+		if (arg == "utc") {
+			utc = true;
+			return;
+		}
+
+		if (arg == "verbose") {
+			verbose = true;
+			return;
+		}
+
+		if (arg == "usage" || arg == "help") { throw Usage{}; }
+
+		throw unrecognized_opt(arg);
+	}
+
+	void options(std::span<char const> opts) {
+		for (char const opt : opts) {
+			switch (opt) {
+			case 'u': utc = true; break;
+			case 'v': verbose = true; break;
+			default: throw unrecognized_opt({&opt, 1});
+			}
+		}
+	}
+};
+
+struct Decoder {
+	Options const& options;
+	std::ostream& out;
+
+	// format strings defined so far in the current file
+	std::unordered_map<std::uint32_t, std::string_view> formats{};
+
+	std::string timestamp(std::int64_t const micros) const {
+		auto const seconds = static_cast<std::time_t>(micros / 1'000'000);
+		auto tm_struct = std::tm{};
+#if defined(_WIN32)
+		if (options.utc) {
+			gmtime_s(&tm_struct, &seconds);
+		} else {
+			localtime_s(&tm_struct, &seconds);
+		}
+#else
+		if (options.utc) {
+			gmtime_r(&seconds, &tm_struct);
+		} else {
+			localtime_r(&seconds, &tm_struct);
+		}
+#endif
+		auto buffer = std::array<char, 64>{};
+		auto const size = std::strftime(buffer.data(), buffer.size(), "%F %T", &tm_struct);
+		return std::format("{}.{:06}", std::string_view{buffer.data(), size}, micros % 1'000'000);
+	}
+
+	void log(binary::Reader& reader) {
+		auto const id = reader.read<std::uint32_t>();
+		auto const level = static_cast<gen::logger::Level>(reader.read<std::uint8_t>());
+		auto const thread = reader.read<std::int32_t>();
+		auto const micros = reader.read<std::int64_t>();
+		auto const category = reader.readString();
+		auto func = std::string_view{};
+		auto file = std::string_view{};
+		auto line = std::int32_t{};
+		auto const has_location = reader.read<std::uint8_t>() != 0;
+		if (has_location) {
+			func = reader.readString();
+			file = reader.readString();
+			line = reader.read<std::int32_t>();
+		}
+		auto const args = reader.readString();
+		if (!reader.ok) { return; }
+
+		auto const format = formats.find(id);
+		auto const message = format == formats.end() ? std::format("<unknown format {}>", id) : binary::render(format->second, args);
+		out << std::format("[{}][T{}] [{}] {} [{}]", gen::logger::levelChar(level), thread, category, message, timestamp(micros));
+		if (options.verbose && has_location) { out << std::format(" [F:{}] [{}:{}]", func, file, line); }
+		out << '\n';
+	}
+
+	bool decode(std::string_view const path, std::string_view const bytes) {
+		auto reader = binary::Reader{bytes};
+		auto const magic = std::string_view{bytes.data(), std::min(bytes.size(), binary::magic_v.size())};
+		reader.bytes.remove_prefix(magic.size());
+		auto const version = reader.read<std::uint16_t>();
+		auto const endian = reader.read<std::uint16_t>();
+		if (magic != binary::magic_v || !reader.ok) {
+			std::cerr << std::format("'{}' is not a binary log file\n", path);
+			return false;
+		}
+		if (endian != binary::endian_v) {
+			std::cerr << std::format("'{}' was written on a machine with different endianness\n", path);
+			return false;
+		}
+		if (version != binary::version_v) {
+			std::cerr << std::format("'{}' has unsupported version {} (expected {})\n", path, version, binary::version_v);
+			return false;
+		}
+
+		formats.clear();
+		while (reader.ok && !reader.atEnd()) {
+			switch (reader.read<binary::RecordKind>()) {
+			case binary::RecordKind::eFormat: {
+				auto const id = reader.read<std::uint32_t>();
+				formats.insert_or_assign(id, reader.readString());
+				break;
+			}
+			case binary::RecordKind::eText: out << reader.readString(); break;
+			case binary::RecordKind::eLog: log(reader); break;
+			default: reader.ok = false; break;
+			}
+		}
+
+		// the tail of a file may be cut off if the process was killed mid write
+		if (!reader.ok) { std::cerr << std::format("'{}' is truncated or corrupt, stopped decoding\n", path); }
+		return reader.ok;
+	}
+};
+
+struct App {
+	Options const& options;
+
+	bool run() {
+		auto ret = true;
+		for (auto const path : options.paths) {
+			auto file = std::ifstream{fs::path{path}, std::ios::binary};
+			if (!file) {
+				std::cerr << std::format("failed to open '{}'\n", path);
+				ret = false;
+				continue;
+			}
+			auto const bytes = std::string{std::istreambuf_iterator<char>{file}, std::istreambuf_iterator<char>{}};
+			if (!Decoder{options, std::cout}.decode(path, bytes)) { ret = false; }
+		}
+		return ret;
+	}
+};
+} // namespace
+
+int main(int argc, char** argv) {
+	assert(argc > 0);
+	auto const usage = Options::buildUsage(fs::path{*argv}.filename().string());
+	auto const args = std::span{argv, static_cast<std::size_t>(argc)}.subspan(1);
+	auto options = Options{};
+	try {
+		options.parse(args);
+
+		return App{options}.run() ? EXIT_SUCCESS : EXIT_FAILURE;
+
+	} catch (Options::ParseError const& error) {
+		std::cerr << std::format("{}\n{}\n", error.what(), usage);
+		return EXIT_FAILURE;
+	} catch (Options::Usage) {
+		std::cout << std::format("{}\n", usage);
+		return EXIT_SUCCESS;
+	} catch (std::exception const& e) {
+		std::cerr << std::format("fatal error: {}\n", e.what());
+		return EXIT_FAILURE;
+	}
+}
@@ -0,0 +1,335 @@
+#include <gen/io/lz4.hpp>
+#include <gen/io/pakFormat.hpp>
+#include <algorithm>
+#include <array>
+#include <cassert>
+#include <charconv>
+#include <cstring>
+#include <filesystem>
+#include <format>
+#include <fstream>
+#include <iostream>
+#include <span>
+#include <string>
+#include <vector>
+
+#if GEN_HAS_ZSTD
+#include <zstd.h>
+#endif
+
+namespace fs = std::filesystem;
+namespace pak = gen::pak;
+
+namespace {
+struct Options {
+	struct ParseError : std::runtime_error {
+		using std::runtime_error::runtime_error;
+	};
+	struct Usage {};
+
+	bool quiet{};
+	pak::Compression compression{pak::Compression::eLz4};
+	std::uint32_t alignment{pak::default_data_alignment_v};
+	std::uint32_t blockSize{pak::default_block_size_v};
+	std::vector<std::string_view> paths{};
+
+	static ParseError unrecognized_opt(std::string_view const opt) { return ParseError{std::format("unrecognized option: '{}'", opt)}; }
+
+	static std::string buildUsage(std::string_view const appName) {
+		return std::format("usage: {} [-q|--quiet] [--compression=none|lz4|zstd] [--align=<bytes>] [--block-size=<bytes>] <input directory> <output file>", appName);
+	}
+
+	void parse(std::span<char const* const> args) {
+		for (std::string_view const arg : args) {
+			if (arg.starts_with("--")) {
+				option(arg.substr(2));
+			} else if (arg.starts_with('-')) {
+				options(arg.substr(1));
+			} else {
+				paths.push_back(arg);
+			}
+		}
+
+		if (paths.size() != 2) { throw ParseError{"expected an input directory and an output file"}; }
+	}
+
+	void option(std::string_view const arg) {
+		if (arg == "quiet") {
+			quiet = true;
+			return;
+		}
+
+		if (arg.starts_with("compression=")) {
+			auto const value = arg.substr(arg.find('=') + 1);
+			if (value == "none") {
+				compression = pak::Compression::eNone;
+			} else if (value == "lz4") {
+				compression = pak::Compression::eLz4;
+			} else if (value == "zstd") {
+#if GEN_HAS_ZSTD
+				compression = pak::Compression::eZstd;
+#else
+				throw ParseError{"zstd support was not built (zstd not found at configure time)"};
+#endif
+			} else {
+				throw ParseError{std::format("unknown compression: '{}'", value)};
+			}
+			return;
+		}
+
+		if (arg.starts_with("align=")) {
+			auto const value = arg.substr(arg.find('=') + 1);
+			auto const [end, error] = std::from_chars(value.data(), value.data() + value.size(), alignment);
+			if (error != std::errc{} || end != value.data() + value.size() || alignment == 0 || (alignment & (alignment - 1)) != 0) {
+				throw ParseError{std::format("alignment must be a power of two: '{}'", value)};
+			}
+			return;
+		}
+
+		if (arg.starts_with("block-size=")) {
+			auto const value = arg.substr(arg.find('=') + 1);
+			auto const [end, error] = std::from_chars(value.data(), value.data() + value.size(), blockSize);
+			if (error != std::errc{} || end != value.data() + value.size() || blockSize > pak::max_block_size_v) {
+				throw ParseError{std::format("block size must be at most {} (0 compresses entries as a whole): '{}'", pak::max_block_size_v, value)};
+			}
+			return;
+		}
+
+		if (arg == "usage" || arg == "help") { throw Usage{}; }
+
+		throw unrecognized_opt(arg);
+	}
+
+	void options(std::span<char const> opts) {
+		for (char const opt : opts) {
+			switch (opt) {
+			case 'q': quiet = true; break;
+			default: throw unrecognized_opt({&opt, 1});
+			}
+		}
+	}
+};
+
+struct Input {
+	fs::path path{};
+	pak::Entry entry{};
+};
+
+std::string_view compression_name(pak::Compression const compression) {
+	switch (compression) {
+	case pak::Compression::eLz4: return "lz4";
+	case pak::Compression::eZstd: return "zstd";
+	default: return "none";
+	}
+}
+
+// only keep compressed data when it saves at least 1/16th, otherwise it can be read in place
+std::vector<std::byte> compress_block(pak::Compression const compression, std::span<std::byte const> const data) {
+	auto ret = std::vector<std::byte>{};
+	switch (compression) {
+	case pak::Compression::eLz4:
+		ret.resize(gen::lz4::compressBound(data.size()));
+		ret.resize(gen::lz4::compress(data, ret));
+		break;
+#if GEN_HAS_ZSTD
+	case pak::Compression::eZstd: {
+		ret.resize(ZSTD_compressBound(data.size()));
+		auto const size = ZSTD_compress(ret.data(), ret.size(), data.data(), data.size(), 19);
+		ret.resize(ZSTD_isError(size) ? 0 : size);
+		break;
+	}
+#endif
+	default: break;
+	}
+
+	if (ret.size() + ret.size() / 16 >= data.size()) { ret.clear(); }
+	return ret;
+}
+
+// stores data into entry, compressed as a whole, in blocks (when larger than blockSize) or as is
+std::vector<std::byte> compress(Options const& options, std::vector<std::byte> data, pak::Entry& entry) {
+	entry.compression = pak::Compression::eNone;
+	entry.blockSize = 0;
+	if (options.compression == pak::Compression::eNone) { return data; }
+
+	if (options.blockSize == 0 || data.size() <= options.blockSize) {
+		auto ret = compress_block(options.compression, data);
+		if (ret.empty()) { return data; }
+		entry.compression = options.compression;
+		return ret;
+	}
+
+	// block table, then the blocks
+	auto const count = (data.size() + options.blockSize - 1) / options.blockSize;
+	auto ret = std::vector<std::byte>(count * sizeof(std::uint32_t));
+	auto compressed = false;
+	for (std::size_t index = 0; index < count; ++index) {
+		auto const block = std::span{data}.subspan(index * options.blockSize, std::min<std::size_t>(options.blockSize, data.size() - index * options.blockSize));
+		auto stored = compress_block(options.compression, block);
+		auto size = static_cast<std::uint32_t>(stored.size());
+		if (stored.empty()) {
+			size = static_cast<std::uint32_t>(block.size()) | pak::raw_block_bit_v;
+			ret.insert(ret.end(), block.begin(), block.end());
+		} else {
+			compressed = true;
+			ret.insert(ret.end(), stored.begin(), stored.end());
+		}
+		std::memcpy(ret.data() + index * sizeof(size), &size, sizeof(size));
+	}
+
+	if (!compressed) { return data; }
+	entry.compression = options.compression;
+	entry.blockSize = options.blockSize;
+	return ret;
+}
+
+struct App {
+	Options const& options;
+
+	std::vector<Input> collect(fs::path const& root) const {
+		auto ret = std::vector<Input>{};
+		for (auto const& it : fs::recursive_directory_iterator{root}) {
+			if (!it.is_regular_file()) { continue; }
+			auto const name = fs::relative(it.path(), root).generic_string();
+			ret.push_back(Input{.path = it.path(), .entry = {.hash = pak::hashName(name)}});
+		}
+		// sorted by hash (then path, so the output is reproducible)
+		std::sort(ret.begin(), ret.end(), [](Input const& a, Input const& b) {
+			return a.entry.hash != b.entry.hash ? a.entry.hash < b.entry.hash : a.path < b.path;
+		});
+		return ret;
+	}
+
+	static void pad(std::ofstream& out, std::uint64_t const offset) {
+		static constexpr auto zeros = std::array<char, 4096>{};
+		auto position = static_cast<std::uint64_t>(out.tellp());
+		while (position < offset) {
+			auto const size = std::min<std::uint64_t>(offset - position, zeros.size());
+			out.write(zeros.data(), static_cast<std::streamsize>(size));
+			position += size;
+		}
+	}
+
+	template <typename Type>
+	static void write(std::ofstream& out, std::span<Type> const values) {
+		out.write(reinterpret_cast<char const*>(values.data()), static_cast<std::streamsize>(values.size_bytes()));
+	}
+
+	bool run() {
+		auto const root = fs::path{options.paths[0]};
+		auto const output = fs::path{options.paths[1]};
+		if (!fs::is_directory(root)) {
+			std::cerr << std::format("'{}' is not a directory\n", root.string());
+			return false;
+		}
+
+		auto inputs = collect(root);
+		if (inputs.size() > UINT32_MAX) {
+			std::cerr << "too many files\n";
+			return false;
+		}
+
+		auto header = pak::Header{};
+		header.entryCount = static_cast<std::uint32_t>(inputs.size());
+		header.bucketBits = pak::bucketBitsFor(header.entryCount);
+		header.dataAlignment = options.alignment;
+
+		auto names = std::string{};
+		for (auto& input : inputs) {
+			auto const name = fs::relative(input.path, root).generic_string();
+			input.entry.nameOffset = static_cast<std::uint32_t>(names.size());
+			input.entry.nameSize = static_cast<std::uint32_t>(name.size());
+			names += name;
+		}
+
+		// buckets[b] is the first entry whose hash falls in bucket b or later
+		auto buckets = std::vector<std::uint32_t>((std::size_t{1} << header.bucketBits) + 1, header.entryCount);
+		for (auto index = inputs.size(); index > 0; --index) {
+			buckets[pak::bucketOf(inputs[index - 1].entry.hash, header.bucketBits)] = static_cast<std::uint32_t>(index - 1);
+		}
+		for (auto index = buckets.size() - 1; index > 0; --index) { buckets[index - 1] = std::min(buckets[index - 1], buckets[index]); }
+
+		header.entriesOffset = pak::alignUp(sizeof(pak::Header), pak::toc_alignment_v);
+		header.bucketsOffset = pak::alignUp(header.entriesOffset + inputs.size() * sizeof(pak::Entry), pak::toc_alignment_v);
+		header.namesOffset = pak::alignUp(header.bucketsOffset + buckets.size() * sizeof(std::uint32_t), pak::toc_alignment_v);
+		header.namesSize = names.size();
+		header.dataOffset = pak::alignUp(header.namesOffset + names.size(), header.dataAlignment);
+
+		auto out = std::ofstream{output, std::ios::binary | std::ios::trunc};
+		if (!out) {
+			std::cerr << std::format("failed to open '{}'\n", output.string());
+			return false;
+		}
+
+		// data first, one file in memory at a time, the table of contents is written once every entry is known
+		auto offset = header.dataOffset;
+		auto total = std::uint64_t{};
+		for (auto& input : inputs) {
+			auto file = std::ifstream{input.path, std::ios::binary};
+			auto data = std::vector<std::byte>(static_cast<std::size_t>(fs::file_size(input.path)));
+			if (!file || !file.read(reinterpret_cast<char*>(data.data()), static_cast<std::streamsize>(data.size()))) {
+				std::cerr << std::format("failed to read '{}'\n", input.path.string());
+				return false;
+			}
+			input.entry.size = data.size();
+			auto const stored = compress(options, std::move(data), input.entry);
+			input.entry.offset = offset;
+			input.entry.storedSize = stored.size();
+			pad(out, offset);
+			write(out, std::span{stored});
+			offset = pak::alignUp(offset + stored.size(), header.dataAlignment);
+			total += input.entry.size;
+
+			if (!options.quiet) {
+				std::cout << std::format("{}: {} -> {} ({})\n", names.substr(input.entry.nameOffset, input.entry.nameSize), input.entry.size,
+										 input.entry.storedSize, compression_name(input.entry.compression));
+			}
+		}
+
+		auto entries = std::vector<pak::Entry>{};
+		entries.reserve(inputs.size());
+		for (auto const& input : inputs) { entries.push_back(input.entry); }
+
+		out.seekp(0);
+		write(out, std::span{&header, 1});
+		pad(out, header.entriesOffset);
+		write(out, std::span{entries});
+		pad(out, header.bucketsOffset);
+		write(out, std::span{buckets});
+		pad(out, header.namesOffset);
+		write(out, std::span{names});
+		out.close();
+		if (!out) {
+			std::cerr << std::format("failed to write '{}'\n", output.string());
+			return false;
+		}
+
+		if (!options.quiet) {
+			std::cout << std::format("{} entries, {} bytes -> {} bytes\n", entries.size(), total, fs::file_size(output));
+		}
+		return true;
+	}
+};
+} // namespace
+
+int main(int argc, char** argv) {
+	assert(argc > 0);
+	auto const usage = Options::buildUsage(fs::path{*argv}.filename().string());
+	auto const args = std::span{argv, static_cast<std::size_t>(argc)}.subspan(1);
+	auto options = Options{};
+	try {
+		options.parse(args);
+
+		return App{options}.run() ? EXIT_SUCCESS : EXIT_FAILURE;
+
+	} catch (Options::ParseError const& error) {
+		std::cerr << std::format("{}\n{}\n", error.what(), usage);
+		return EXIT_FAILURE;
+	} catch (Options::Usage) {
+		std::cout << std::format("{}\n", usage);
+		return EXIT_SUCCESS;
+	} catch (std::exception const& e) {
+		std::cerr << std::format("fatal error: {}\n", e.what());
+		return EXIT_FAILURE;
+	}
+}
@@ -0,0 +1,275 @@
+#include <gen/io/blockStream.hpp>
+#include <gen/io/lz4.hpp>
+#include <gen/io/pakFile.hpp>
+#include <gen/io/pakFormat.hpp>
+#include <algorithm>
+#include <array>
+#include <cassert>
+#include <charconv>
+#include <chrono>
+#include <cstring>
+#include <filesystem>
+#include <format>
+#include <fstream>
+#include <iostream>
+#include <span>
+#include <string>
+#include <vector>
+
+#if GEN_HAS_ZSTD
+#include <zstd.h>
+#endif
+
+namespace fs = std::filesystem;
+namespace pak = gen::pak;
+
+namespace {
+using Clock = std::chrono::steady_clock;
+
+struct Options {
+	struct ParseError : std::runtime_error {
+		using std::runtime_error::runtime_error;
+	};
+	struct Usage {};
+
+	std::uint32_t sizeMiB{4096};
+	std::uint32_t blockSize{pak::default_block_size_v};
+	std::uint32_t inFlight{gen::BlockStream::default_in_flight_v};
+	fs::path directory{};
+	std::vector<std::string_view> codecs{};
+
+	static ParseError unrecognized_opt(std::string_view const opt) { return ParseError{std::format("unrecognized option: '{}'", opt)}; }
+
+	static std::string buildUsage(std::string_view const appName) {
+		return std::format("usage: {} [--size=<MiB>] [--block-size=<bytes>] [--in-flight=<blocks>] [--dir=<directory>] [raw|lz4|zstd]...", appName);
+	}
+
+	void parse(std::span<char const* const> args) {
+		for (std::string_view const arg : args) {
+			if (arg.starts_with("--")) {
+				option(arg.substr(2));
+			} else if (arg.starts_with('-')) {
+				throw unrecognized_opt(arg.substr(1));
+			} else {
+				codecs.push_back(arg);
+			}
+		}
+	}
+
+	static std::uint32_t parse_count(std::string_view const arg, std::string_view const what, std::uint32_t const max) {
+		auto const value = arg.substr(arg.find('=') + 1);
+		auto ret = std::uint32_t{};
+		auto const [end, error] = std::from_chars(value.data(), value.data() + value.size(), ret);
+		if (error != std::errc{} || end != value.data() + value.size() || ret == 0 || ret > max) {
+			throw ParseError{std::format("{} must be between 1 and {}: '{}'", what, max, value)};
+		}
+		return ret;
+	}
+
+	void option(std::string_view const arg) {
+		if (arg.starts_with("size=")) {
+			sizeMiB = parse_count(arg, "size", 1 << 20);
+			return;
+		}
+
+		if (arg.starts_with("block-size=")) {
+			blockSize = parse_count(arg, "block size", pak::max_block_size_v);
+			return;
+		}
+
+		if (arg.starts_with("in-flight=")) {
+			inFlight = parse_count(arg, "blocks in flight", 1024);
+			return;
+		}
+
+		if (arg.starts_with("dir=")) {
+			directory = arg.substr(arg.find('=') + 1);
+			return;
+		}
+
+		if (arg == "usage" || arg == "help") { throw Usage{}; }
+
+		throw unrecognized_opt(arg);
+	}
+};
+
+struct Codec {
+	std::string_view name{};
+	pak::Compression compression{};
+};
+
+constexpr auto codecs_v = std::array{
+	Codec{"raw", pak::Compression::eNone},
+	Codec{"lz4", pak::Compression::eLz4},
+	Codec{"zstd", pak::Compression::eZstd},
+};
+
+// deterministic and roughly as compressible as text assets: words from a small vocabulary, with random bytes mixed in
+struct Generator {
+	std::uint64_t state{0x9e3779b97f4a7c15};
+
+	std::uint64_t next() {
+		state ^= state << 13;
+		state ^= state >> 7;
+		state ^= state << 17;
+		return state;
+	}
+
+	void fill(std::span<std::byte> out) {
+		static constexpr std::string_view words_v[] = {
+			"vertex ", "normal ", "tangent ", "texcoord ", "material ", "mesh ", "bone ", "weight ", "0.25 ", "1.0 ", "-3.75 ", "index ", "\n",
+		};
+		for (std::size_t pos = 0; pos < out.size();) {
+			auto const random = next();
+			auto const word = (random & 7) == 0 ? std::string_view{reinterpret_cast<char const*>(&state), sizeof(state)} : words_v[(random >> 8) % std::size(words_v)];
+			auto const size = std::min(word.size(), out.size() - pos);
+			std::memcpy(out.data() + pos, word.data(), size);
+			pos += size;
+		}
+	}
+};
+
+// samples a byte per page, computed as data is written and again as it is streamed back
+std::byte checksum(std::span<std::byte const> const data) {
+	auto ret = std::byte{};
+	for (std::size_t index = 0; index < data.size(); index += 4096) { ret ^= data[index]; }
+	return ret;
+}
+
+// stores data as is when the codec does not shrink it, as pak-builder does
+pak::Compression compress(pak::Compression const compression, std::span<std::byte const> const data, std::vector<std::byte>& out) {
+	out.clear();
+	switch (compression) {
+	case pak::Compression::eLz4:
+		out.resize(gen::lz4::compressBound(data.size()));
+		out.resize(gen::lz4::compress(data, out));
+		break;
+#if GEN_HAS_ZSTD
+	case pak::Compression::eZstd: {
+		out.resize(ZSTD_compressBound(data.size()));
+		auto const size = ZSTD_compress(out.data(), out.size(), data.data(), data.size(), ZSTD_CLEVEL_DEFAULT);
+		out.resize(ZSTD_isError(size) ? 0 : size);
+		break;
+	}
+#endif
+	default: break;
+	}
+	if (out.empty() || out.size() >= data.size()) {
+		out.assign(data.begin(), data.end());
+		return pak::Compression::eNone;
+	}
+	return compression;
+}
+
+struct App {
+	Options const& options;
+
+	bool run() const {
+		for (auto const name : options.codecs) {
+			if (std::ranges::none_of(codecs_v, [name](Codec const& codec) { return codec.name == name; })) {
+				std::cerr << std::format("unknown codec: '{}'\n", name);
+				return false;
+			}
+		}
+
+		auto const directory = options.directory.empty() ? fs::temp_directory_path() : options.directory;
+		std::cout << std::format("BlockStream, {} MiB in {} byte blocks, {} in flight (MB/s of decompressed data)\n", options.sizeMiB, options.blockSize, options.inFlight);
+		std::cout << std::format("{:>6} {:>12} {:>8} {:>10} {:>10}\n", "codec", "stored MiB", "ratio", "pack MB/s", "read MB/s");
+		auto ret = true;
+		for (auto const& codec : codecs_v) {
+			if (!options.codecs.empty() && std::ranges::find(options.codecs, codec.name) == options.codecs.end()) { continue; }
+			if (!gen::PakFile::supports(codec.compression)) {
+				std::cout << std::format("{:>6} skipped, the engine was built without it\n", codec.name);
+				continue;
+			}
+#if !GEN_HAS_ZSTD
+			if (codec.compression == pak::Compression::eZstd) {
+				std::cout << std::format("{:>6} skipped, stream-bench was built without it\n", codec.name);
+				continue;
+			}
+#endif
+			auto const path = directory / std::format("stream-bench-{}.bin", codec.name);
+			if (!bench(codec, path)) { ret = false; }
+			auto error = std::error_code{};
+			fs::remove(path, error);
+		}
+		return ret;
+	}
+
+	// generates, compresses and writes the file ("pack"), then streams it back: the file was just written, so unless it outgrew the page cache reads hit memory
+	bool bench(Codec const& codec, fs::path const& path) const {
+		auto blocks = std::vector<gen::BlockStream::Block>{};
+		auto const total = std::uint64_t{options.sizeMiB} << 20;
+		auto expected = std::byte{};
+		auto const writeBegin = Clock::now();
+		{
+			auto file = std::ofstream{path, std::ios::binary | std::ios::trunc};
+			auto generator = Generator{};
+			auto data = std::vector<std::byte>{};
+			auto stored = std::vector<std::byte>{};
+			for (std::uint64_t offset = 0, storedOffset = 0; file && offset < total; offset += data.size()) {
+				data.resize(static_cast<std::size_t>(std::min<std::uint64_t>(options.blockSize, total - offset)));
+				generator.fill(data);
+				expected ^= checksum(data);
+				auto const compression = compress(codec.compression, data, stored);
+				file.write(reinterpret_cast<char const*>(stored.data()), static_cast<std::streamsize>(stored.size()));
+				blocks.push_back({.offset = storedOffset, .storedSize = stored.size(), .size = data.size(), .compression = compression});
+				storedOffset += stored.size();
+			}
+			if (!file.flush()) {
+				std::cerr << std::format("failed to write '{}'\n", path.string());
+				return false;
+			}
+		}
+		auto const writeElapsed = Clock::now() - writeBegin;
+
+		auto stream = gen::BlockStream{};
+		if (!stream.open(path, blocks, options.inFlight)) {
+			std::cerr << std::format("failed to open '{}'\n", path.string());
+			return false;
+		}
+		auto const readBegin = Clock::now();
+		auto bytes = std::uint64_t{};
+		// touches every page, as a consumer copying the data out would
+		auto streamed = std::byte{};
+		while (auto const block = stream.next()) {
+			bytes += block->size();
+			streamed ^= checksum(*block);
+		}
+		auto const readElapsed = Clock::now() - readBegin;
+		if (stream.hasFailed() || bytes != total || streamed != expected) {
+			std::cerr << std::format("{}: streamed {} of {} bytes, {}\n", codec.name, bytes, total, streamed == expected ? "intact" : "corrupt");
+			return false;
+		}
+
+		auto storedSize = std::uint64_t{};
+		for (auto const& block : blocks) { storedSize += block.storedSize; }
+		auto const mbPerSecond = [total](Clock::duration const elapsed) { return static_cast<double>(total) / 1e6 / std::chrono::duration<double>(elapsed).count(); };
+		std::cout << std::format("{:>6} {:>12} {:>8.2f} {:>10.0f} {:>10.0f}\n", codec.name, storedSize >> 20, static_cast<double>(total) / static_cast<double>(storedSize),
+			mbPerSecond(writeElapsed), mbPerSecond(readElapsed));
+		return true;
+	}
+};
+} // namespace
+
+int main(int argc, char** argv) {
+	assert(argc > 0);
+	auto const usage = Options::buildUsage(fs::path{*argv}.filename().string());
+	auto const args = std::span{argv, static_cast<std::size_t>(argc)}.subspan(1);
+	auto options = Options{};
+	try {
+		options.parse(args);
+
+		return App{options}.run() ? EXIT_SUCCESS : EXIT_FAILURE;
+
+	} catch (Options::ParseError const& error) {
+		std::cerr << std::format("{}\n{}\n", error.what(), usage);
+		return EXIT_FAILURE;
+	} catch (Options::Usage) {
+		std::cout << std::format("{}\n", usage);
+		return EXIT_SUCCESS;
+	} catch (std::exception const& e) {
+		std::cerr << std::format("fatal error: {}\n", e.what());
+		return EXIT_FAILURE;
+	}
+}